@@ -0,0 +1,82 @@
+#pragma once
+#include "config.h"
+
+/// @brief Counts the calls of operator new per thread and attributes them to the phases of a hand
+/// @note Only counts if the program is compiled with POKER_ALLOC_AUDIT (CMake option), which replaces the global operator new and delete
+/// @note An allocation is counted for every phase that is open in the thread (the counts are inclusive), so the "hand" phase counts every allocation of the per-hand loop
+/// @note The counts of a thread are added to the totals when the thread is finished
+/// @see AllocPhase
+class AllocAudit {
+   public:
+    /// @brief Checks if the allocations are counted
+    /// @return True if the program is compiled with POKER_ALLOC_AUDIT
+    /// @exception Guarantee No-throw
+    static constexpr bool isEnabled() noexcept {
+#ifdef POKER_ALLOC_AUDIT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// @brief Gets the number of allocations of the calling thread and the finished threads
+    /// @return The number of operator new calls
+    /// @exception Guarantee No-throw
+    static u_int64_t getAllocations() noexcept;
+
+    /// @brief Gets the number of allocations inside a phase of the calling thread and the finished threads
+    /// @param phase The name of the phase
+    /// @return The number of operator new calls while the phase was open
+    /// @exception Guarantee No-throw
+    static u_int64_t getAllocations(const char* phase) noexcept;
+
+    /// @brief Removes the counts of the calling thread and the finished threads
+    /// @exception Guarantee No-throw
+    static void reset() noexcept;
+
+    /// @brief Logs the allocations per phase
+    /// @exception Guarantee No-throw
+    static void logReport() noexcept;
+
+    /// @brief Counts an allocation of the calling thread, called by operator new
+    /// @exception Guarantee No-throw
+    static void countAllocation() noexcept;
+
+   private:
+    friend class AllocPhase;
+
+    /// @brief Opens a phase of the calling thread
+    /// @param phase The name of the phase (a string literal)
+    /// @exception Guarantee No-throw
+    static void pushPhase(const char* phase) noexcept;
+
+    /// @brief Closes the innermost phase of the calling thread
+    /// @exception Guarantee No-throw
+    static void popPhase() noexcept;
+};
+
+/// @brief Attributes the allocations of the rest of the enclosing scope to a phase
+/// @note Use POKER_ALLOC_PHASE or POKER_TRACE_SCOPE, so the phase is not compiled without POKER_ALLOC_AUDIT
+class AllocPhase {
+   public:
+    /// @brief Opens the phase
+    /// @param phase The name of the phase (a string literal)
+    /// @exception Guarantee No-throw
+    explicit AllocPhase(const char* phase) noexcept { AllocAudit::pushPhase(phase); }
+
+    AllocPhase(const AllocPhase&) = delete;
+    AllocPhase& operator=(const AllocPhase&) = delete;
+
+    /// @brief Closes the phase
+    /// @exception Guarantee No-throw
+    ~AllocPhase() { AllocAudit::popPhase(); }
+};
+
+#define POKER_ALLOC_CONCAT_(a, b) a##b
+#define POKER_ALLOC_CONCAT(a, b) POKER_ALLOC_CONCAT_(a, b)
+#ifdef POKER_ALLOC_AUDIT
+/// @brief Attributes the allocations of the rest of the enclosing scope to the phase with the given name
+#define POKER_ALLOC_PHASE(name) const AllocPhase POKER_ALLOC_CONCAT(allocPhase, __LINE__)(name)
+#else
+#define POKER_ALLOC_PHASE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,142 @@
+#pragma once
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "config.h"
+
+/// @brief A plog appender that moves the formatting and writing of the log records to a background thread
+/// @note The simulation threads only copy the message of a record into a slot of a lock-free multi-producer ring of ASYNC_LOG_CAPACITY records
+/// @note The background thread formats the records like plog::TxtFormatter and writes them in batches to the console (colored like plog::ColorConsoleAppender) and a rolling file
+/// @note The LogOverflow policy decides what a simulation thread does if the ring is full
+class AsyncLogAppender : public plog::IAppender {
+   public:
+    /// @brief Opens the log file and starts the background thread
+    /// @param overflow The policy if the ring is full
+    /// @param filePath The path of the log file or an empty string for no file
+    /// @param maxFileSize The size in bytes after which the log file is rolled
+    /// @param maxFiles The number of log files that are kept (the current file and maxFiles - 1 rolled files)
+    /// @param console Whether the records are written to the console as well
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the log file could not be opened
+    AsyncLogAppender(const LogOverflow overflow, const std::string& filePath, const u_int64_t maxFileSize, const u_int8_t maxFiles, const bool console);
+
+    AsyncLogAppender(const AsyncLogAppender&) = delete;
+    AsyncLogAppender& operator=(const AsyncLogAppender&) = delete;
+
+    /// @brief Writes the remaining records and stops the background thread
+    /// @exception Guarantee No-throw
+    ~AsyncLogAppender() override { this->close(); }
+
+    /// @brief Adds a record to the ring, called by plog on the logging thread
+    /// @param record The record
+    /// @exception Guarantee No-throw
+    /// @note Can be called by any number of threads at the same time, the slots keep their memory, so it only allocates until the message lengths are known
+    void write(const plog::Record& record) noexcept override;
+
+    /// @brief Waits until the records that were added before are written
+    /// @exception Guarantee No-throw
+    void flush() noexcept;
+
+    /// @brief Writes the remaining records, stops the background thread and closes the file
+    /// @exception Guarantee No-throw
+    /// @note Records that are added afterwards are dropped, calling it again has no effect
+    void close() noexcept;
+
+    /// @brief Gets the number of records that were dropped by the overflow policy
+    /// @return The number of dropped records
+    /// @exception Guarantee No-throw
+    u_int64_t getDropped() const noexcept { return this->dropped.load(std::memory_order_relaxed); }
+
+    /// @brief Gets the number of records that were written
+    /// @return The number of written records
+    /// @exception Guarantee No-throw
+    u_int64_t getWritten() const noexcept { return this->written.load(std::memory_order_acquire); }
+
+   private:
+    /// @brief A slot of the ring with a captured record
+    struct Slot {
+        /// @brief The position of the record in the ring: position if the slot is free, position + 1 if the record is ready
+        std::atomic<u_int64_t> sequence;
+        /// @brief The time of the record
+        plog::util::Time time;
+        /// @brief The severity of the record
+        plog::Severity severity;
+        /// @brief The id of the thread that logged the record
+        unsigned int tid;
+        /// @brief The function that logged the record
+        const char* func;
+        /// @brief The line that logged the record
+        size_t line;
+        /// @brief The message of the record (keeps its memory for the next records)
+        std::string message;
+    };
+
+    /// @brief Adds a record to the ring with the overflow policy
+    /// @param record The record
+    /// @return True if the record was added, false if it is dropped
+    /// @exception Guarantee No-throw
+    bool enqueue(const plog::Record& record) noexcept;
+
+    /// @brief Adds a record to the ring if there is a free slot
+    /// @param record The record
+    /// @return True if the record was added, false if the ring is full
+    /// @exception Guarantee No-throw
+    bool tryPush(const plog::Record& record) noexcept;
+
+    /// @brief The loop of the background thread, writes the records until the appender is closed
+    /// @exception Guarantee No-throw
+    void writeRecords() noexcept;
+
+    /// @brief Formats a record like plog::TxtFormatter
+    /// @param slot The slot of the record
+    /// @param out The string that the line is appended to
+    /// @exception Guarantee No-throw
+    static void format(const Slot& slot, std::string& out) noexcept;
+
+    /// @brief Writes a batch of lines to the file and rolls the file if it is too large
+    /// @param lines The formatted lines
+    /// @exception Guarantee No-throw
+    void writeFile(const std::string& lines) noexcept;
+
+    /// @brief Renames the log file to the first rolled file and opens a new file
+    /// @exception Guarantee No-throw
+    void rollFile() noexcept;
+
+    /// @brief The policy if the ring is full
+    const LogOverflow overflow;
+    /// @brief The path of the log file
+    const std::string filePath;
+    /// @brief The size in bytes after which the log file is rolled
+    const u_int64_t maxFileSize;
+    /// @brief The number of kept log files
+    const u_int8_t maxFiles;
+    /// @brief Whether the records are written to the console
+    const bool console;
+    /// @brief Whether the console supports colors
+    const bool consoleColors;
+    /// @brief The slots of the ring
+    std::unique_ptr<Slot[]> slots;
+    /// @brief The position of the next record that a producer adds
+    alignas(64) std::atomic<u_int64_t> enqueuePos{0};
+    /// @brief The position of the next record that the background thread writes
+    alignas(64) std::atomic<u_int64_t> dequeuePos{0};
+    /// @brief The number of records that were written
+    std::atomic<u_int64_t> written{0};
+    /// @brief The number of dropped records
+    std::atomic<u_int64_t> dropped{0};
+    /// @brief Counts the records while the ring is more than half full, one of ASYNC_LOG_SAMPLE_RATE is kept with the SAMPLE policy
+    std::atomic<u_int64_t> sampleCounter{0};
+    /// @brief Set by close(), the background thread stops after the last record
+    std::atomic<bool> closing{false};
+    /// @brief The number of producers in write(), the background thread only stops if none is left
+    std::atomic<u_int32_t> producers{0};
+    /// @brief The log file (only used by the background thread)
+    std::ofstream file;
+    /// @brief The size of the current log file in bytes
+    u_int64_t fileSize = 0;
+    /// @brief The background thread
+    std::thread writer;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cmath>
+
+#include "config.h"
+
+/// @brief Collects the results of the hands of a single player in cash games
+/// @note A sample is the net result of one hand (chips after the hand minus the topped up stack before it)
+/// @note The mean and the variance are updated with Welford's algorithm
+class CashStats {
+   public:
+    /// @brief Default constructor
+    /// @exception Guarantee No-throw
+    constexpr CashStats() noexcept { this->reset(); };
+
+    /// @brief Reset method allows reuse of the stats object by being performant
+    /// @exception Guarantee No-throw
+    /// @note Resets all values to their defaults
+    constexpr void reset() noexcept {
+        this->hands = 0;
+        this->mean = 0;
+        this->m2 = 0;
+        this->rebuys = 0;
+        this->rebuyChips = 0;
+    };
+
+    /// @brief Adds the net result of one hand
+    /// @param chips The chips won (positive) or lost (negative) in the hand
+    /// @exception Guarantee No-throw
+    constexpr void addHand(const double chips) noexcept {
+        this->hands++;
+        const double delta = chips - this->mean;
+        this->mean += delta / this->hands;
+        this->m2 += delta * (chips - this->mean);
+    };
+
+    /// @brief Counts a rebuy
+    /// @param chips The chips that were added to the stack
+    /// @exception Guarantee No-throw
+    constexpr void addRebuy(const u_int64_t chips) noexcept {
+        this->rebuys++;
+        this->rebuyChips += chips;
+    };
+
+    /// @brief Gets the number of hands
+    /// @return The number of hands
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getHands() const noexcept { return this->hands; };
+
+    /// @brief Gets the mean result of a hand
+    /// @return The mean amount of chips won per hand
+    /// @exception Guarantee No-throw
+    constexpr double getMean() const noexcept { return this->mean; };
+
+    /// @brief Gets the win rate in big blinds per 100 hands
+    /// @param bigBlind The big blind
+    /// @return The win rate in bb/100
+    /// @exception Guarantee No-throw
+    constexpr double getBbPer100(const double bigBlind) const noexcept { return this->mean / bigBlind * 100; };
+
+    /// @brief Gets the standard error of the win rate in big blinds per 100 hands
+    /// @param bigBlind The big blind
+    /// @return The standard error in bb/100 or 0 if there are less than 2 hands
+    /// @exception Guarantee No-throw
+    double getStandardError(const double bigBlind) const noexcept {
+        if (this->hands < 2) return 0;
+        return std::sqrt(this->m2 / (this->hands - 1) / this->hands) / bigBlind * 100;
+    };
+
+    /// @brief Gets the number of rebuys
+    /// @return The number of hands before which chips were added to the stack
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getRebuys() const noexcept { return this->rebuys; };
+
+    /// @brief Gets the chips of all rebuys
+    /// @return The chips that were added to the stack
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getRebuyChips() const noexcept { return this->rebuyChips; };
+
+   private:
+    /// @brief The number of hands
+    u_int64_t hands{};
+    /// @brief The mean result of a hand in chips
+    double mean{};
+    /// @brief The sum of the squared differences from the mean
+    double m2{};
+    /// @brief The number of rebuys
+    u_int64_t rebuys{};
+    /// @brief The chips of all rebuys
+    u_int64_t rebuyChips{};
+};
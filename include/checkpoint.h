@@ -0,0 +1,208 @@
+#pragma once
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "config.h"
+
+/// @brief The serialized state of a run that can be resumed
+/// @note The values are stored in host byte order in the order they are written and have to be read in the same order
+/// @note A checkpoint file holds a magic, the version, the size of the state, the state and an FNV-1a checksum of the state
+/// @see CheckpointWriter
+class Checkpoint {
+   public:
+    /// @brief Appends values to the state
+    /// @tparam T The trivially copyable type of the values
+    /// @param values The values
+    /// @param count The number of values
+    /// @exception Guarantee Strong
+    template <typename T>
+    void write(const T* values, const size_t count = 1) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be stored in a checkpoint");
+        const char* bytes = reinterpret_cast<const char*>(values);
+        this->bytes.insert(this->bytes.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    /// @brief Reads the next values of the state
+    /// @tparam T The trivially copyable type of the values
+    /// @param values The values
+    /// @param count The number of values
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the state has less bytes left
+    template <typename T>
+    void read(T* values, const size_t count = 1) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be stored in a checkpoint");
+        if (this->bytes.size() - this->position < count * sizeof(T)) {
+            PLOG_FATAL << "The checkpoint is too short";
+            throw std::invalid_argument("The checkpoint is too short");
+        }
+        std::memcpy(static_cast<void*>(values), this->bytes.data() + this->position, count * sizeof(T));
+        this->position += count * sizeof(T);
+    }
+
+    /// @brief Reads the next value of the state
+    /// @tparam T The trivially copyable type of the value
+    /// @return The value
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the state has less bytes left
+    template <typename T>
+    T read() {
+        T value;
+        this->read(&value);
+        return value;
+    }
+
+    /// @brief Removes the state, the memory is kept for the next state
+    /// @exception Guarantee No-throw
+    void clear() noexcept {
+        this->bytes.clear();
+        this->position = 0;
+    }
+
+    /// @brief Gets the bytes of the state
+    /// @return The bytes
+    /// @exception Guarantee No-throw
+    const char* getData() const noexcept { return this->bytes.data(); }
+
+    /// @brief Gets the size of the state
+    /// @return The number of bytes
+    /// @exception Guarantee No-throw
+    size_t getSize() const noexcept { return this->bytes.size(); }
+
+    /// @brief Checks if there is a state
+    /// @return True if the state is empty
+    /// @exception Guarantee No-throw
+    bool isEmpty() const noexcept { return this->bytes.empty(); }
+
+    /// @brief Checks if the whole state was read
+    /// @return True if there are no bytes left to read
+    /// @exception Guarantee No-throw
+    bool isRead() const noexcept { return this->position == this->bytes.size(); }
+
+    /// @brief Loads the state of a checkpoint file
+    /// @param path The path of the file
+    /// @return The checkpoint, the state is read from its beginning
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the file could not be read, is not a checkpoint of this version or the checksum does not match
+    static Checkpoint load(const std::string& path);
+
+    /// @brief Writes the state to a file atomically: to a temporary file next to it that is synced and renamed
+    /// @param path The path of the file, an existing checkpoint is only replaced by a complete one
+    /// @return True if the file was written
+    /// @exception Guarantee No-throw
+    bool save(const std::string& path) const noexcept;
+
+   private:
+    /// @brief The magic at the start of a checkpoint file
+    static constexpr char MAGIC[4] = {'P', 'W', 'C', 'P'};
+    /// @brief The version of the file format, a checkpoint of another version can not be resumed
+    static constexpr u_int32_t VERSION = 1;
+
+    /// @brief Computes the FNV-1a hash of the state
+    /// @return The checksum
+    /// @exception Guarantee No-throw
+    u_int64_t getChecksum() const noexcept;
+
+    /// @brief Swaps the states of two checkpoints
+    /// @param other The other checkpoint
+    /// @exception Guarantee No-throw
+    void swap(Checkpoint& other) noexcept {
+        this->bytes.swap(other.bytes);
+        std::swap(this->position, other.position);
+    }
+
+    /// @brief The state
+    std::vector<char> bytes;
+    /// @brief The position of the next value that is read
+    size_t position = 0;
+
+    /// @brief Swaps the states without copying them
+    friend class CheckpointWriter;
+};
+
+/// @brief Writes the checkpoints of a run to a file on a background thread
+/// @note The simulation thread only swaps its checkpoint with the pending one, it never waits for the file
+/// @note If the writer is still busy with the previous checkpoint when a newer one arrives, the pending checkpoint is replaced: only the latest state matters
+/// @see BasicGame::setCheckpointWriter()
+class CheckpointWriter {
+   public:
+    /// @brief Starts the writer thread
+    /// @param path The path of the checkpoint file
+    /// @param interval The number of games between two checkpoints (at least 1)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the interval is 0
+    CheckpointWriter(const std::string& path, const u_int64_t interval);
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    /// @brief Writes the pending checkpoint and stops the writer thread
+    /// @exception Guarantee No-throw
+    ~CheckpointWriter() { this->close(); }
+
+    /// @brief Hands a checkpoint to the writer thread
+    /// @param checkpoint The checkpoint, it gets the memory of an older checkpoint that can be cleared and reused
+    /// @exception Guarantee No-throw
+    /// @note Ignored after close()
+    void submit(Checkpoint& checkpoint) noexcept;
+
+    /// @brief Writes the pending checkpoint and stops the writer thread
+    /// @exception Guarantee No-throw
+    /// @note Blocks until the file is written, calling it again has no effect
+    void close() noexcept;
+
+    /// @brief Gets the number of games between two checkpoints
+    /// @return The interval
+    /// @exception Guarantee No-throw
+    u_int64_t getInterval() const noexcept { return this->interval; }
+
+    /// @brief Gets the path of the checkpoint file
+    /// @return The path
+    /// @exception Guarantee No-throw
+    const std::string& getPath() const noexcept { return this->path; }
+
+    /// @brief Gets the number of checkpoints that were written
+    /// @return The number of written checkpoints
+    /// @exception Guarantee No-throw
+    /// @note Only exact after close()
+    u_int64_t getWritten() const noexcept { return this->written; }
+
+    /// @brief Gets the number of checkpoints that were replaced by a newer one before they were written
+    /// @return The number of skipped checkpoints
+    /// @exception Guarantee No-throw
+    /// @note Only exact after close()
+    u_int64_t getSkipped() const noexcept { return this->skipped; }
+
+   private:
+    /// @brief The loop of the writer thread, writes the pending checkpoints until the writer is closed
+    /// @exception Guarantee No-throw
+    void writeCheckpoints() noexcept;
+
+    /// @brief The path of the checkpoint file
+    const std::string path;
+    /// @brief The number of games between two checkpoints
+    const u_int64_t interval;
+    /// @brief The latest checkpoint that was not written yet
+    Checkpoint pending;
+    /// @brief The checkpoint that the writer thread writes
+    Checkpoint writing;
+    /// @brief True if there is a pending checkpoint
+    bool hasPending = false;
+    /// @brief Protects pending, hasPending, closing and the counters
+    std::mutex mutex;
+    /// @brief Wakes the writer thread if a checkpoint is pending or the writer is closed
+    std::condition_variable writerCondition;
+    /// @brief Set by close(), the writer thread stops after the pending checkpoint
+    bool closing = false;
+    /// @brief Set after close() is finished
+    bool closed = false;
+    /// @brief The number of written checkpoints
+    u_int64_t written = 0;
+    /// @brief The number of replaced checkpoints
+    u_int64_t skipped = 0;
+    /// @brief The writer thread
+    std::thread writer;
+};
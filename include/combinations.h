@@ -0,0 +1,180 @@
+#pragma once
+#include <utility>
+
+#include "deck.h"
+
+/// @brief Computes the binomial coefficients that the combinations need
+/// @return binomials[n][k] = n choose k for n up to CARD_NUM and k up to MAX_COMBINATION_CARDS
+/// @exception Guarantee No-throw
+constexpr std::array<std::array<u_int64_t, MAX_COMBINATION_CARDS + 1>, CARD_NUM + 1> getBinomials() noexcept {
+    std::array<std::array<u_int64_t, MAX_COMBINATION_CARDS + 1>, CARD_NUM + 1> binomials{};
+    for (u_int8_t n = 0; n <= CARD_NUM; n++) {
+        binomials[n][0] = 1;
+        for (u_int8_t k = 1; k <= MAX_COMBINATION_CARDS && k <= n; k++) binomials[n][k] = binomials[n - 1][k - 1] + (k < n ? binomials[n - 1][k] : 0);
+    }
+    return binomials;
+}
+
+/// @brief The binomial coefficients n choose k for n up to CARD_NUM and k up to MAX_COMBINATION_CARDS
+const constexpr std::array<std::array<u_int64_t, MAX_COMBINATION_CARDS + 1>, CARD_NUM + 1> BINOMIALS = getBinomials();
+
+/// @brief Enumerates the k card subsets of the live cards (the cards that are left after the dead cards are removed) in colex order
+/// @note The cards are bits of a card mask (bit suit * 13 + rank - 2), the live cards are numbered from 0 to n - 1 in the order of their bits
+/// @note A subset of the positions c_0 < ... < c_k-1 has the index C(c_0, 1) + ... + C(c_k-1, k) (combinatorial number system), rank() and unrank() convert between the two
+/// @note The index space can be split into chunks, every worker enumerates its chunk without the subsets before it
+class CardCombinations {
+   public:
+    /// @brief Creates the enumerator of the k card subsets of the live cards
+    /// @param live The mask of the live cards
+    /// @param k The number of cards of a subset (at most MAX_COMBINATION_CARDS)
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if k > MAX_COMBINATION_CARDS
+    constexpr CardCombinations(const u_int64_t live, const u_int8_t k) noexcept : k(k) {
+        for (u_int8_t i = 0; i < CARD_NUM; i++) {
+            if (((live >> i) & 1) == 0) continue;
+            this->cards[this->n] = CardCombinations::getCard(i);
+            this->indices[this->n] = i;
+            this->n++;
+        }
+        this->count = k > this->n ? 0 : BINOMIALS[this->n][k];
+    }
+
+    /// @brief Gets the bit of a card in a card mask
+    /// @param card The card
+    /// @return The mask with the bit of the card
+    /// @exception Guarantee No-throw
+    static constexpr u_int64_t getCardMask(const Card card) noexcept { return (u_int64_t)1 << (card.suit * 13 + card.rank - 2); }
+
+    /// @brief Gets the card of a bit of a card mask
+    /// @param index The index of the bit
+    /// @return The card
+    /// @exception Guarantee No-throw
+    static constexpr Card getCard(const u_int8_t index) noexcept { return Card{(u_int8_t)(index % 13 + 2), (u_int8_t)(index / 13)}; }
+
+    /// @brief Gets the number of live cards
+    /// @return n
+    /// @exception Guarantee No-throw
+    constexpr u_int8_t getNumCards() const noexcept { return this->n; }
+
+    /// @brief Gets a live card
+    /// @param position The position of the card (0 to n - 1)
+    /// @return The card
+    /// @exception Guarantee No-throw
+    constexpr Card getLiveCard(const u_int8_t position) const noexcept { return this->cards[position]; }
+
+    /// @brief Gets the number of subsets
+    /// @return n choose k
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getCount() const noexcept { return this->count; }
+
+    /// @brief Gets the subset of an index
+    /// @param index The index (less than getCount())
+    /// @param subset The k cards of the subset in increasing positions
+    /// @return The card mask of the subset
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t unrank(u_int64_t index, Card subset[]) const noexcept {
+        u_int8_t positions[MAX_COMBINATION_CARDS]{};
+        this->unrankPositions(index, positions);
+        u_int64_t mask = 0;
+        for (u_int8_t i = 0; i < this->k; i++) {
+            subset[i] = this->cards[positions[i]];
+            mask |= (u_int64_t)1 << this->indices[positions[i]];
+        }
+        return mask;
+    }
+
+    /// @brief Gets the index of a subset
+    /// @param subset The card mask of the subset, k live cards
+    /// @return The index of the subset
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if the subset does not have k live cards
+    constexpr u_int64_t rank(const u_int64_t subset) const noexcept {
+        u_int64_t index = 0;
+        u_int8_t i = 0;
+        for (u_int8_t position = 0; position < this->n; position++) {
+            if ((subset >> this->indices[position]) & 1) index += BINOMIALS[position][++i];
+        }
+        return index;
+    }
+
+    /// @brief Gets the index range of a chunk of the subsets
+    /// @param chunk The chunk (0 to numChunks - 1)
+    /// @param numChunks The number of chunks, the chunks differ in size by at most one subset
+    /// @return The first index and the index after the last index of the chunk
+    /// @exception Guarantee No-throw
+    constexpr std::pair<u_int64_t, u_int64_t> getChunk(const u_int32_t chunk, const u_int32_t numChunks) const noexcept {
+        return {this->count / numChunks * chunk + std::min<u_int64_t>(chunk, this->count % numChunks),
+                this->count / numChunks * (chunk + 1) + std::min<u_int64_t>(chunk + 1, this->count % numChunks)};
+    }
+
+    /// @brief Calls a function for every subset of an index range in colex order
+    /// @tparam Function void(const Card subset[], u_int64_t mask)
+    /// @param first The index of the first subset
+    /// @param last The index after the last subset (at most getCount())
+    /// @param function The function, it gets the k cards of the subset in increasing positions and the card mask of the subset
+    /// @exception Guarantee No-throw if the function does not throw
+    template <typename Function>
+    constexpr void forEach(const u_int64_t first, const u_int64_t last, Function&& function) const {
+        if (first >= last) return;
+        u_int8_t positions[MAX_COMBINATION_CARDS + 1]{};
+        this->unrankPositions(first, positions);
+        // a sentinel after the last position
+        positions[this->k] = this->n;
+        Card subset[MAX_COMBINATION_CARDS]{};
+        u_int64_t mask = 0;
+        for (u_int8_t i = 0; i < this->k; i++) {
+            subset[i] = this->cards[positions[i]];
+            mask |= (u_int64_t)1 << this->indices[positions[i]];
+        }
+        for (u_int64_t index = first;;) {
+            function(static_cast<const Card*>(subset), mask);
+            if (++index == last) return;
+            // colex successor: increase the lowest position that can move up and reset the positions below it
+            u_int8_t i = 0;
+            while (positions[i] + 1 == positions[i + 1]) i++;
+            for (u_int8_t j = 0; j <= i; j++) mask &= ~((u_int64_t)1 << this->indices[positions[j]]);
+            positions[i]++;
+            for (u_int8_t j = 0; j < i; j++) positions[j] = j;
+            for (u_int8_t j = 0; j <= i; j++) {
+                subset[j] = this->cards[positions[j]];
+                mask |= (u_int64_t)1 << this->indices[positions[j]];
+            }
+        }
+    }
+
+    /// @brief Calls a function for every subset in colex order
+    /// @tparam Function void(const Card subset[], u_int64_t mask)
+    /// @param function The function
+    /// @exception Guarantee No-throw if the function does not throw
+    template <typename Function>
+    constexpr void forEach(Function&& function) const {
+        this->forEach(0, this->count, std::forward<Function>(function));
+    }
+
+   private:
+    /// @brief Gets the positions of the subset of an index
+    /// @param index The index
+    /// @param positions The k positions in increasing order
+    /// @exception Guarantee No-throw
+    constexpr void unrankPositions(u_int64_t index, u_int8_t positions[]) const noexcept {
+        // the highest position first: the greatest c with C(c, i + 1) <= index
+        u_int8_t c = this->n;
+        for (int8_t i = this->k - 1; i >= 0; i--) {
+            do c--;
+            while (BINOMIALS[c][i + 1] > index);
+            positions[i] = c;
+            index -= BINOMIALS[c][i + 1];
+        }
+    }
+
+    /// @brief The number of cards of a subset
+    u_int8_t k;
+    /// @brief The number of live cards
+    u_int8_t n = 0;
+    /// @brief The number of subsets
+    u_int64_t count = 0;
+    /// @brief The live cards by position
+    Card cards[CARD_NUM]{};
+    /// @brief The bit of the live card of a position in the card mask
+    u_int8_t indices[CARD_NUM]{};
+};
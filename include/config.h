@@ -1,7 +1,10 @@
 #pragma once
 #include <array>
 #include <iostream>
+#include <limits>
+#include <type_traits>
 
+#include "enums.h"
 #include "logger.h"
 
 /// @brief constexpr strlen implementation
@@ -31,10 +34,20 @@ const constexpr char* SUIT_SYMBOLS[] = {
     u8"\xE2\x99\xA0",  // Spades
     u8"\xE2\x99\xA3"   // Clubs
 };
-/// @brief The maximum number of players allowed in a game (affects the memory usage of the program)
-const constexpr u_int8_t MAX_PLAYERS = 10;  // 23 is the maximum value, because 23 * 2 hand cards + 5 community cards = 51 cards
+/// @brief The number of seats of the default table (Game), the maximum number of players allowed in a default game (affects the memory usage of the program)
+const constexpr u_int8_t MAX_PLAYERS = 10;
+/// @brief The maximum number of seats that a table (BasicGame) can be compiled with
+const constexpr u_int8_t MAX_SEATS = 23;  // 23 * 2 hand cards + 5 community cards = 51 cards
+static_assert(MAX_PLAYERS <= MAX_SEATS, "The default table has too many seats");
+
+/// @brief Applies the macro X to every table configuration (number of seats, chip type) that is compiled
+/// @note The templates (BasicGame, BasicPlayer and the players) are instantiated explicitly for these configurations in their source files
+/// @note Add a configuration here to use BasicGame with other template parameters
+#define POKER_TABLE_CONFIGS(X) X(2, u_int32_t) X(6, u_int32_t) X(MAX_PLAYERS, u_int64_t) X(MAX_SEATS, u_int64_t)
 /// @brief The maximum number of cards that can be included in a game
 const constexpr u_int8_t MAX_DRAWN_CARDS = MAX_PLAYERS * 2 + 5;  // 2 hand cards per player and 5 community cards
+/// @brief The maximum number of players for which the duplicate runner plays every permutation of the seats (8! = 40320 seatings per deal sequence)
+const constexpr u_int8_t MAX_DUPLICATE_PERMUTATION_PLAYERS = 8;
 /// @brief The maximum amount of chips in the game (MAX_CHIPS/numPlayers is the maximum starting amount for each player)
 constexpr u_int64_t MAX_CHIPS = INT64_MAX - 1;
 /// @brief The maximum character length allowed for a player name
@@ -45,8 +58,10 @@ const constexpr u_int8_t MAX_PLAYER_GET_NAME_LENGTH = MAX_PLAYER_NAME_LENGTH + 4
 const constexpr char STR_PLAYER[] = "Player ";
 /// @brief The maximum character length returned from the getPlayerInfo() function of a game
 const constexpr u_int16_t MAX_GET_PLAYER_INFO_LENGTH = constexpr_strlen(STR_PLAYER) + MAX_PLAYER_GET_NAME_LENGTH + 5 + 2 * LEN_UINT64;
-/// @brief The maximum character length for the string that represents the winning players
-const constexpr u_int16_t MAX_POT_DIST_STRING_LENGTH = (MAX_GET_PLAYER_INFO_LENGTH + 2) * MAX_PLAYERS;
+/// @brief The maximum character length per player for the string that represents the winning players
+const constexpr u_int16_t MAX_POT_DIST_STRING_LENGTH_PER_PLAYER = MAX_GET_PLAYER_INFO_LENGTH + 2;
+/// @brief The maximum character length for the string that represents the winning players of the default table
+const constexpr u_int16_t MAX_POT_DIST_STRING_LENGTH = MAX_POT_DIST_STRING_LENGTH_PER_PLAYER * MAX_PLAYERS;
 
 /// @brief Small blind error string constant
 const constexpr char STR_SMALL_BLIND_ERROR[] = "cannot fulfill small blind of ";
@@ -80,7 +95,7 @@ const constexpr char STR_TOOL_HANDSTRENGTHS_DEFAULT_FILE_NAME[] = "hand_strength
 const constexpr unsigned char HAND_INDEX_COUNT = 91;
 
 /// @brief The maximum number of optional arguments that can be passed to the main function
-const constexpr unsigned char MAX_OPTIONAL_ARGS = 10;
+const constexpr unsigned char MAX_OPTIONAL_ARGS = 19;
 
 /// @brief The maximum number of required arguments that can be passed to the main function
 const constexpr unsigned char MAX_REQUIRED_ARGS = 3;
@@ -91,24 +106,101 @@ const constexpr int64_t DEFAULT_HANDSTRENGTHS_ANALYTICS_ITERS = 10000000;
 /// @brief The default winner, split and total add values for the handstrengths analytics tool
 const constexpr u_int8_t DEFAULT_HANDSTRENGTHS_ANALYTICS_OPTIONS[3] = {1, 1, 1};
 
+/// @brief The number of deals that the DealGenerator generates at once (the cards of a block take 2 bytes * MAX_DRAWN_CARDS * DEAL_BLOCK_SIZE)
+const constexpr u_int32_t DEAL_BLOCK_SIZE = 2048;
+static_assert(DEAL_BLOCK_SIZE % 4 == 0, "A block of random numbers of the deal generator has 4 numbers");
+
+/// @brief The maximum number of cards of a subset of CardCombinations (a runout, a flop or the hole cards of a hand)
+const constexpr u_int8_t MAX_COMBINATION_CARDS = 7;
+
+/// @brief The number of hole card combinations (52 choose 2)
+const constexpr u_int16_t COMBO_NUM = CARD_NUM * (CARD_NUM - 1) / 2;
+
+/// @brief The number of times the DealSampler draws a hand from the alias table of a range before it draws from the combinations that are left by the dead cards
+const constexpr u_int8_t DEAL_SAMPLER_ALIAS_TRIES = 4;
+
 /// @brief The iteration count per gametest
 const constexpr int TEST_ITERS = 1000;
 
+/// @brief The number of buckets in the decision time histogram of a player (power of two buckets in nanoseconds)
+const constexpr u_int8_t TURN_TIME_HISTOGRAM_BUCKETS = 40;
+
+/// @brief The number of game records that the simulation thread collects before it hands them to the writer thread of a results sink
+const constexpr u_int32_t RESULTS_SINK_BATCH_SIZE = 4096;
+/// @brief The number of record batches of a results sink, the simulation thread only waits if the writer thread is behind by all of them
+const constexpr u_int8_t RESULTS_SINK_BATCHES = 4;
+/// @brief The size of the file buffer of a results sink in bytes
+const constexpr u_int32_t RESULTS_SINK_FILE_BUFFER = 1 << 20;
+/// @brief The magic bytes at the start of a binary results file
+const constexpr char RESULTS_SINK_BINARY_MAGIC[] = "PWRS";
+/// @brief The version of the binary results file format
+const constexpr u_int8_t RESULTS_SINK_BINARY_VERSION = 1;
+
+/// @brief The number of phases that the ring buffer of a thread keeps for the trace (the oldest phases are overwritten)
+const constexpr u_int32_t TRACE_BUFFER_EVENTS = 1 << 16;
+/// @brief The number of different phases that the allocation audit counts (the allocations of further phases are only in the total)
+const constexpr u_int8_t ALLOC_AUDIT_MAX_PHASES = 32;
+/// @brief The number of nested phases that the allocation audit attributes an allocation to
+const constexpr u_int8_t ALLOC_AUDIT_MAX_DEPTH = 16;
+
+/// @brief The number of records in the ring of the asynchronous log appender (a power of two)
+const constexpr u_int32_t ASYNC_LOG_CAPACITY = 1 << 14;
+static_assert((ASYNC_LOG_CAPACITY & (ASYNC_LOG_CAPACITY - 1)) == 0, "ASYNC_LOG_CAPACITY must be a power of two");
+/// @brief The maximum number of records that the asynchronous log appender writes at once
+const constexpr u_int32_t ASYNC_LOG_BATCH = 256;
+/// @brief One of this number of verbose to info records is kept by the SAMPLE policy while the ring is more than half full
+const constexpr u_int32_t ASYNC_LOG_SAMPLE_RATE = 16;
+/// @brief The time in microseconds that the background thread of the asynchronous log appender sleeps if the ring is empty
+const constexpr u_int32_t ASYNC_LOG_IDLE_US = 1000;
+
+/// @brief The number of rounds of the Philox generator
+const constexpr u_int8_t PHILOX_ROUNDS = 10;
+/// @brief The multipliers and the key increments (Weyl sequence) of the Philox4x32 generator
+const constexpr u_int32_t PHILOX_M0 = 0xD2511F53;
+const constexpr u_int32_t PHILOX_M1 = 0xCD9E8D57;
+const constexpr u_int32_t PHILOX_W0 = 0x9E3779B9;
+const constexpr u_int32_t PHILOX_W1 = 0xBB67AE85;
+
+/// @brief Contains the settings of the rule that stops a simulation before all games are played
+/// @see BasicEarlyStop
+struct EarlyStopConfig {
+    /// @brief The stopping rule, StopRule::NONE plays all games
+    StopRule rule = StopRule::NONE;
+    /// @brief The significance level
+    /// @note SPRT: the probability to report a gap between two players that do not differ. Confidence interval: the probability that a rate is outside of its interval
+    double alpha = 0.05;
+    /// @brief The probability to miss a gap of at least delta between two players (SPRT only)
+    double beta = 0.05;
+    /// @brief The tested gap (SPRT) or the maximum half-width of the confidence intervals
+    /// @note SPRT: a better player wins 0.5 + delta of the games that are only won by one of the two players (0 < delta < 0.5)
+    /// @note Confidence interval: the maximum half-width of the game-win rates, the chip-win rates use delta times the chips at the table
+    double delta = 0.05;
+    /// @brief The minimum number of games (deal sequences in duplicate runs) before the rule is checked
+    u_int32_t minGames = 100;
+};
+
 /**
  * @brief Sets parameters for the game
+ * @tparam N The number of seats at the table (maximum number of players)
+ * @tparam Chips The unsigned integer type that stores chip amounts
  * @note A Config is a set of parameters that are used to initialize a game.
  * @note It is passed to the Game constructor.
+ * @see Config for the default table
  */
-class Config {
+template <u_int8_t N, typename Chips>
+class BasicConfig {
+    static_assert(N >= 2 && N <= MAX_SEATS, "A table needs 2 to MAX_SEATS seats");
+    static_assert(std::is_unsigned_v<Chips>, "Chips have to be stored in an unsigned integer type");
+
    public:
     /// @brief Starting chips for each player
-    const std::array<u_int64_t, MAX_PLAYERS> startingChips;
+    const std::array<Chips, N> startingChips;
     /// @brief Small blind amount
     /// @note Big blind is always twice the small blind
-    const u_int64_t smallBlind;
+    const Chips smallBlind;
     /// @brief Increase blind for amount every time the dealer is again at position 0
     /// @note Used to avoid infinite games
-    const u_int64_t addBlindPerDealer0;
+    const Chips addBlindPerDealer0;
     /// @brief Number of games to play
     const u_int64_t numGames;
     /// @brief Number of players in the game
@@ -121,6 +213,23 @@ class Config {
     /// @note If the rounds exceed this number, the game will end and the player with the most chips will win
     /// @note Negative means no limit
     const int16_t maxRounds;
+    /// @brief Measure the decision time of every player turn
+    /// @note The decision times are reported with the statistics at the end of the run
+    const bool measureTurnTime;
+    /// @brief Maximum time in nanoseconds that a player may take for one decision
+    /// @note 0 means no limit. If the player exceeds the limit, the timeoutAction is played instead of the player´s action
+    const u_int64_t turnTimeBudget;
+    /// @brief The action that is played if a player exceeds the turnTimeBudget
+    /// @note FOLD checks if possible, otherwise folds. CALL checks or calls if possible, otherwise folds
+    /// @note A blind option is always called
+    const Actions timeoutAction;
+    /// @brief Number of runouts that are evaluated for the all-in EV statistics
+    /// @note 0 disables the all-in EV accounting. If the remaining runouts are not more than this number, all of them are enumerated, otherwise this number is sampled
+    /// @note Only the statistics are affected, the pots are still distributed on the dealt board
+    const u_int32_t allInEVSamples;
+    /// @brief The rule that stops the simulation as soon as the results are significant
+    /// @note The duplicate runner applies the rule to the deal sequences of every thread, the games of a seating are always played completely
+    const EarlyStopConfig earlyStop;
 
     /// @brief Create a Config object with the given parameters
     /// @param games Number of games to play
@@ -131,15 +240,21 @@ class Config {
     /// @param shufflePlayers Shuffle players at the start of each game
     /// @param shuffleDeck Shuffle deck at the start of each round
     /// @param maxRounds Maximum number of rounds per game. Negative means no limit
+    /// @param measureTurnTime Measure the decision time of every player turn
+    /// @param turnTimeBudget Maximum time in nanoseconds that a player may take for one decision. 0 means no limit
+    /// @param timeoutAction The action that is played if a player exceeds the turnTimeBudget (FOLD or CALL)
+    /// @param allInEVSamples Number of runouts that are evaluated for the all-in EV statistics. 0 disables the all-in EV accounting
+    /// @param earlyStop The rule that stops the simulation as soon as the results are significant
     /// @exception Guarantee Strong
     /// @throws std::invalid_argument if the parameters are invalid
     /// @note Big blind is always twice the small blind
     /// @note AddBlind is used to avoid infinite games
     /// @note Undefined behavior if the length of playerChips is less than players
-    /// @see MAX_PLAYERS for the maximum number of players
-    /// @see MAX_CHIPS for the maximum amount of chips
-    constexpr Config(const u_int16_t games, const u_int8_t players, const std::array<u_int64_t, MAX_PLAYERS> playerChips, const u_int64_t small, const u_int64_t addBlind,
-                     const bool shufflePlayers = true, const bool shuffleDeck = true, const int16_t maxRounds = -1)
+    /// @see N for the maximum number of players
+    /// @see getMaxChips() for the maximum amount of chips
+    constexpr BasicConfig(const u_int16_t games, const u_int8_t players, const std::array<Chips, N> playerChips, const Chips small, const Chips addBlind,
+                          const bool shufflePlayers = true, const bool shuffleDeck = true, const int16_t maxRounds = -1, const bool measureTurnTime = false, const u_int64_t turnTimeBudget = 0,
+                          const Actions timeoutAction = Actions::FOLD, const u_int32_t allInEVSamples = 0, const EarlyStopConfig earlyStop = EarlyStopConfig{})
         : startingChips(playerChips),
           smallBlind(small),
           addBlindPerDealer0(addBlind),
@@ -147,9 +262,14 @@ class Config {
           numPlayers(players),
           shufflePlayers(shufflePlayers),
           shuffleDeck(shuffleDeck),
-          maxRounds(maxRounds) {
-        if (this->numPlayers < 2 || this->numPlayers > MAX_PLAYERS) {
-            PLOG_FATAL << "Invalid number of players: " << this->numPlayers << " (min: 2, max: " << MAX_PLAYERS << ")";
+          maxRounds(maxRounds),
+          measureTurnTime(measureTurnTime),
+          turnTimeBudget(turnTimeBudget),
+          timeoutAction(timeoutAction),
+          allInEVSamples(allInEVSamples),
+          earlyStop(earlyStop) {
+        if (this->numPlayers < 2 || this->numPlayers > N) {
+            PLOG_FATAL << "Invalid number of players: " << this->numPlayers << " (min: 2, max: " << +N << ")";
             throw std::invalid_argument("Invalid number of players");
         }
         u_int64_t totalChips = 0;
@@ -160,10 +280,20 @@ class Config {
             }
             totalChips += this->startingChips[i];
         }
-        if (totalChips > MAX_CHIPS) {
-            PLOG_FATAL << "Too many chips: " << totalChips << " (max: " << MAX_CHIPS << ")";
+        if (totalChips > getMaxChips()) {
+            PLOG_FATAL << "Too many chips: " << totalChips << " (max: " << getMaxChips() << ")";
             throw std::invalid_argument("Too many chips");
         }
+        if (this->timeoutAction != Actions::FOLD && this->timeoutAction != Actions::CALL) {
+            PLOG_FATAL << "Invalid timeout action: " << EnumToString::enumToString(this->timeoutAction) << " (allowed: FOLD, CALL)";
+            throw std::invalid_argument("Invalid timeout action");
+        }
+        if (this->earlyStop.rule != StopRule::NONE && !(this->earlyStop.alpha > 0 && this->earlyStop.alpha < 1 && this->earlyStop.beta > 0 && this->earlyStop.beta < 1 &&
+                                                        this->earlyStop.delta > 0 && (this->earlyStop.rule != StopRule::SPRT || this->earlyStop.delta < 0.5))) {
+            PLOG_FATAL << "Invalid early stop config for " << EnumToString::enumToString(this->earlyStop.rule) << ": alpha " << this->earlyStop.alpha << ", beta " << this->earlyStop.beta
+                       << ", delta " << this->earlyStop.delta;
+            throw std::invalid_argument("Invalid early stop config");
+        }
     }
 
     /// @brief Create a Config object with the given parameters
@@ -175,15 +305,27 @@ class Config {
     /// @param shufflePlayers Shuffle players at the start of each game
     /// @param shuffleDeck Shuffle deck at the start of each round
     /// @param maxRounds Maximum number of rounds per game. Negative means no limit
+    /// @param measureTurnTime Measure the decision time of every player turn
+    /// @param turnTimeBudget Maximum time in nanoseconds that a player may take for one decision. 0 means no limit
+    /// @param timeoutAction The action that is played if a player exceeds the turnTimeBudget (FOLD or CALL)
+    /// @param allInEVSamples Number of runouts that are evaluated for the all-in EV statistics. 0 disables the all-in EV accounting
+    /// @param earlyStop The rule that stops the simulation as soon as the results are significant
     /// @exception Guarantee Strong
     /// @throws std::invalid_argument if the parameters are invalid
     /// @note Big blind is always twice the small blind
     /// @note AddBlind is used to avoid infinite games
-    /// @see MAX_PLAYERS for the maximum number of players
-    /// @see MAX_CHIPS for the maximum amount of chips
-    constexpr Config(const u_int16_t games, const u_int8_t players, const u_int64_t startChips, const u_int64_t small, const u_int64_t addBlind, const bool shufflePlayers = true,
-                     const bool shuffleDeck = true, const int16_t maxRounds = -1)
-        : Config(games, players, getPlayerChipsArray(startChips, players), small, addBlind, shufflePlayers, shuffleDeck, maxRounds){};
+    /// @see N for the maximum number of players
+    /// @see getMaxChips() for the maximum amount of chips
+    constexpr BasicConfig(const u_int16_t games, const u_int8_t players, const Chips startChips, const Chips small, const Chips addBlind, const bool shufflePlayers = true,
+                          const bool shuffleDeck = true, const int16_t maxRounds = -1, const bool measureTurnTime = false, const u_int64_t turnTimeBudget = 0,
+                          const Actions timeoutAction = Actions::FOLD, const u_int32_t allInEVSamples = 0, const EarlyStopConfig earlyStop = EarlyStopConfig{})
+        : BasicConfig(games, players, getPlayerChipsArray(startChips, players), small, addBlind, shufflePlayers, shuffleDeck, maxRounds, measureTurnTime, turnTimeBudget, timeoutAction,
+                      allInEVSamples, earlyStop){};
+
+    /// @brief Gets the maximum amount of chips in a game with this chip type
+    /// @return MAX_CHIPS or the maximum value of Chips - 1 if it is smaller
+    /// @exception Guarantee No-throw
+    static constexpr u_int64_t getMaxChips() noexcept { return std::min<u_int64_t>(MAX_CHIPS, std::numeric_limits<Chips>::max() - 1); }
 
    private:
     /// @brief Create an array of starting chips for each player
@@ -191,18 +333,29 @@ class Config {
     /// @param players Number of players in the game
     /// @return Array of starting chips for each player
     /// @exception Guarantee No-throw
-    constexpr const std::array<u_int64_t, MAX_PLAYERS> getPlayerChipsArray(const u_int64_t startChips, const u_int8_t players) const noexcept {
-        std::array<u_int64_t, MAX_PLAYERS> playerChips{};
-        for (u_int8_t i = 0; i < players; i++) {
+    constexpr const std::array<Chips, N> getPlayerChipsArray(const Chips startChips, const u_int8_t players) const noexcept {
+        std::array<Chips, N> playerChips{};
+        // an invalid number of players is rejected by the constructor, only the seats of the table are filled
+        for (u_int8_t i = 0; i < players && i < N; i++) {
             playerChips[i] = startChips;
         }
         return playerChips;
     }
 };
 
+/// @brief The Config of the default table (MAX_PLAYERS seats, 64 bit chips)
+using Config = BasicConfig<MAX_PLAYERS, u_int64_t>;
+
 /// @brief An example Config object
 class BaseConfig : public Config {
    public:
     /// @brief generates a Config object with default values
-    constexpr BaseConfig() : Config(10000, 5, 1000, 10, 1) {}
+    /// @param measureTurnTime Measure the decision time of every player turn
+    /// @param turnTimeBudget Maximum time in nanoseconds that a player may take for one decision. 0 means no limit
+    /// @param timeoutAction The action that is played if a player exceeds the turnTimeBudget (FOLD or CALL)
+    /// @param allInEVSamples Number of runouts that are evaluated for the all-in EV statistics. 0 disables the all-in EV accounting
+    /// @param earlyStop The rule that stops the simulation as soon as the results are significant
+    constexpr BaseConfig(const bool measureTurnTime = false, const u_int64_t turnTimeBudget = 0, const Actions timeoutAction = Actions::FOLD, const u_int32_t allInEVSamples = 0,
+                         const EarlyStopConfig earlyStop = EarlyStopConfig{})
+        : Config(10000, 5, 1000, 10, 1, true, true, -1, measureTurnTime, turnTimeBudget, timeoutAction, allInEVSamples, earlyStop) {}
 };
@@ -1,6 +1,8 @@
 #pragma once
 #include "deck.h"
 #include "enums.h"
+#include "pot.h"
+#include "seat_mask.h"
 
 /// @brief Represents a full action that a player can take in their turn
 /// @see Actions
@@ -12,27 +14,33 @@ struct Action {
 };
 
 /// @brief Contains the data for a single bet round (preflop, flop, turn, river)
-struct BetRoundData {
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+template <u_int8_t N, typename Chips>
+struct BasicBetRoundData {
     /// @brief Position of the player that is currently playing
     u_int8_t playerPos;
     /// @brief Current bet in the bet round
-    u_int64_t currentBet;
+    Chips currentBet;
     /// @brief Minimum raise allowed for the current player
-    u_int64_t minimumRaise;
+    Chips minimumRaise;
     /// @brief Number of chips betted for each player in the current round
-    u_int64_t playerBets[MAX_PLAYERS];
+    Chips playerBets[N];
 };
 
 /// @brief Contains the data for a single round (until the pot is won)
-struct RoundData {
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+template <u_int8_t N, typename Chips>
+struct BasicRoundData {
     /// @brief The current small blind
-    u_int64_t smallBlind;
+    Chips smallBlind;
     /// @brief The current big blind
-    u_int64_t bigBlind;
+    Chips bigBlind;
     /// @brief The actual big blind bet
-    u_int64_t bigBlindBet;
+    Chips bigBlindBet;
     /// @brief The amount of chips that are added to the small blind every time the dealer is again at position 0
-    u_int64_t addBlind;
+    Chips addBlind;
     /// @brief The position of the dealer
     u_int8_t dealerPos;
     /// @brief The position of the small blind
@@ -40,13 +48,17 @@ struct RoundData {
     /// @brief The position of the big blind
     u_int8_t bigBlindPos;
     /// @brief The current pot
-    u_int64_t pot;
+    Chips pot;
     /// @brief The number of players that are still in the round
+    /// @note Derived from the seat masks, see Data::updateSeatCounters()
     u_int8_t numActivePlayers;
     /// @brief The number of players that are all-in in the round
+    /// @note Derived from the seat masks, see Data::updateSeatCounters()
     u_int8_t numAllInPlayers;
-    /// @brief True if the player folded
-    bool playerFolded[MAX_PLAYERS];
+    /// @brief playerFolded[i] is true if the player folded
+    BasicSeatMask<N> playerFolded;
+    /// @brief playerAllIn[i] is true if the player is all-in
+    BasicSeatMask<N> playerAllIn;
     /// @brief The community cards, betRoundState needs to be checked to know how many of them are valid
     Card communityCards[5];
     /// @brief Whats the state of the round (continue, round won, game won)
@@ -54,38 +66,154 @@ struct RoundData {
     /// @brief Whats the state of the bet round (preflop, flop, turn, river)
     BetRoundState betRoundState;
     /// @brief Total number of chips betted for each player in the current round
-    u_int64_t playerBetsTotal[MAX_PLAYERS];
+    Chips playerBetsTotal[N];
+    /// @brief The main pot (index 0) and the side pots, every pot except the last one is capped by an all-in
+    /// @note The pots are updated with every bet, the sum of their values is always pot
+    /// @note One pot more than players is needed because the last all-in always opens a new (maybe empty) pot
+    BasicPot<N, Chips> pots[N + 1];
+    /// @brief The number of used pots (at least 1)
+    u_int8_t numPots;
 };
 
 /// @brief Contains the data for a single game (until only one player is left)
-struct GameData {
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+template <u_int8_t N, typename Chips>
+struct BasicGameData {
     /// @brief The number of players that are still in the game
+    /// @note Derived from the seat masks, see Data::updateSeatCounters()
     u_int8_t numNonOutPlayers;
-    /// @brief True if the player is out of the game
-    bool playerOut[MAX_PLAYERS];
+    /// @brief playerOut[i] is true if the player is out of the game
+    BasicSeatMask<N> playerOut;
     /// @brief The number of game wins for each player
-    u_int32_t gameWins[MAX_PLAYERS];
+    /// @note Indexed by the player id, see playerIds
+    u_int32_t gameWins[N];
     /// @brief The number of round wins for each player (side pot wins included)
-    u_int32_t chipWins[MAX_PLAYERS];
+    /// @note Indexed by the player id, see playerIds
+    u_int32_t chipWins[N];
     /// @brief The number of chips won for each player (side pot wins included)
-    u_int64_t chipWinsAmount[MAX_PLAYERS];
+    /// @note Indexed by the player id, see playerIds
+    u_int64_t chipWinsAmount[N];
+    /// @brief The expected minus the actual chips won in the all-in showdowns for each player
+    /// @note Indexed by the player id, see playerIds
+    /// @note Only collected if Config::allInEVSamples is not 0, chipWinsAmount + allInEVAdjustment is the all-in EV adjusted amount of chips won
+    double allInEVAdjustment[N];
     /// @brief The number of chips that each player has
-    u_int64_t playerChips[MAX_PLAYERS];
+    Chips playerChips[N];
+    /// @brief playerIds[i] is the stable id of the player on position i
+    /// @note The ids are the positions at the start of the game set, they do not change if the players are shuffled
+    u_int8_t playerIds[N];
+};
+
+/// @brief Contains the action statistics of a single player over all games of a game set
+/// @note The statistics are updated by the game with O(1) per action and can be used to model the opponents
+/// @note All rates return 0 if there is no sample yet
+struct PlayerStats {
+    /// @brief The number of hands the player was dealt in
+    u_int32_t hands;
+    /// @brief The number of hands where the player voluntarily put chips in the pot preflop (blinds and blind option checks excluded)
+    u_int32_t vpipHands;
+    /// @brief The number of hands where the player bet or raised preflop
+    u_int32_t pfrHands;
+    /// @brief The number of bets and raises (all-ins above the current bet included)
+    u_int32_t betsRaises;
+    /// @brief The number of calls (all-ins up to the current bet included)
+    u_int32_t calls;
+    /// @brief The number of decisions where the player had to add chips to stay in the hand (blind option excluded)
+    u_int32_t facedBets;
+    /// @brief The number of folds when the player had to add chips to stay in the hand
+    u_int32_t foldsToBet;
+    /// @brief The number of hands where the player was still in the hand when the flop was dealt
+    u_int32_t sawFlop;
+    /// @brief The number of hands where the player went to the showdown
+    u_int32_t showdowns;
+    /// @brief The number of showdowns where the player won chips
+    u_int32_t showdownsWon;
+    /// @brief True if the player already voluntarily put chips in the pot preflop in the current hand
+    bool vpipHand;
+    /// @brief True if the player already bet or raised preflop in the current hand
+    bool pfrHand;
+
+    /// @brief Counts a new hand for the player and resets the per hand flags
+    /// @exception Guarantee No-throw
+    constexpr void startHand() noexcept {
+        this->hands++;
+        this->vpipHand = false;
+        this->pfrHand = false;
+    }
+
+    /// @brief Counts a voluntary preflop investment (at most once per hand)
+    /// @exception Guarantee No-throw
+    constexpr void addVPIP() noexcept {
+        if (this->vpipHand) return;
+        this->vpipHand = true;
+        this->vpipHands++;
+    }
+
+    /// @brief Counts a preflop bet or raise (at most once per hand)
+    /// @exception Guarantee No-throw
+    constexpr void addPFR() noexcept {
+        if (this->pfrHand) return;
+        this->pfrHand = true;
+        this->pfrHands++;
+    }
+
+    /// @brief Gets the share of hands where the player voluntarily put chips in the pot preflop
+    /// @return VPIP (0-1)
+    /// @exception Guarantee No-throw
+    constexpr double getVPIP() const noexcept { return this->hands == 0 ? 0 : (double)this->vpipHands / this->hands; }
+
+    /// @brief Gets the share of hands where the player bet or raised preflop
+    /// @return PFR (0-1)
+    /// @exception Guarantee No-throw
+    constexpr double getPFR() const noexcept { return this->hands == 0 ? 0 : (double)this->pfrHands / this->hands; }
+
+    /// @brief Gets the ratio of aggressive (bets and raises) to passive (calls) actions
+    /// @return Aggression factor (bets and raises / calls), the number of bets and raises if there is no call
+    /// @exception Guarantee No-throw
+    constexpr double getAggressionFactor() const noexcept { return this->calls == 0 ? this->betsRaises : (double)this->betsRaises / this->calls; }
+
+    /// @brief Gets the share of folds when the player had to add chips to stay in the hand
+    /// @return Fold to bet (0-1)
+    /// @exception Guarantee No-throw
+    constexpr double getFoldToBet() const noexcept { return this->facedBets == 0 ? 0 : (double)this->foldsToBet / this->facedBets; }
+
+    /// @brief Gets the share of hands that went to the showdown after the player saw the flop
+    /// @return Went to showdown (0-1)
+    /// @exception Guarantee No-throw
+    constexpr double getShowdownFrequency() const noexcept { return this->sawFlop == 0 ? 0 : (double)this->showdowns / this->sawFlop; }
+
+    /// @brief Gets the share of showdowns where the player won chips
+    /// @return Won at showdown (0-1)
+    /// @exception Guarantee No-throw
+    constexpr double getShowdownWinRate() const noexcept { return this->showdowns == 0 ? 0 : (double)this->showdownsWon / this->showdowns; }
 };
 
 /// @brief Contains all Data for a game set (multiple games)
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
 /// @see GameData
 /// @see RoundData
 /// @see BetRoundData
-struct Data {
+/// @see Data for the default table
+template <u_int8_t N, typename Chips>
+struct BasicData {
+    /// @brief The seat mask type of the table
+    using Seats = BasicSeatMask<N>;
+    /// @brief The pot type of the table
+    using PotType = BasicPot<N, Chips>;
+
     /// @brief The number of players competing in the games
     u_int8_t numPlayers;
     /// @brief The data for the current game
-    GameData gameData;
+    BasicGameData<N, Chips> gameData;
     /// @brief The data for the current round
-    RoundData roundData;
+    BasicRoundData<N, Chips> roundData;
     /// @brief The data for the current bet round
-    BetRoundData betRoundData;
+    BasicBetRoundData<N, Chips> betRoundData;
+    /// @brief The action statistics of each player over all games
+    /// @note Indexed by the player id, use getPlayerId() to get the statistics of the player on a position
+    PlayerStats playerStats[N];
 
     /** @brief Gets the next active player position without changing it
      * @param playerPos The current player position
@@ -93,11 +221,71 @@ struct Data {
      * @return The next active player position
      * @exception Guarantee No-throw
      */
-    u_int8_t getNextPlayerPos(u_int8_t playerPos, const bool considerFolded) const noexcept {
-        do {
-            playerPos = (playerPos + 1) % this->numPlayers;
-        } while (this->gameData.playerOut[playerPos] || (considerFolded && this->roundData.playerFolded[playerPos]));
-        return playerPos;
+    u_int8_t getNextPlayerPos(const u_int8_t playerPos, const bool considerFolded) const noexcept {
+        return Seats::getNextSeat(considerFolded ? this->getActiveSeats() : (typename Seats::Bits)~this->gameData.playerOut.getBits(), playerPos, this->numPlayers);
+    }
+
+    /// @brief Gets the stable id of the player on a position
+    /// @param playerPos The position of the player
+    /// @return The id of the player, used as index for the statistics (gameWins, chipWins, chipWinsAmount, playerStats)
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if playerPos >= numPlayers
+    constexpr u_int8_t getPlayerId(const u_int8_t playerPos) const noexcept { return this->gameData.playerIds[playerPos]; }
+
+    /// @brief Gets the all-in EV adjusted amount of chips won by a player
+    /// @param playerId The id of the player
+    /// @return The chips won with the all-in showdowns credited by their expected value instead of the dealt board
+    /// @exception Guarantee No-throw
+    /// @note Equal to chipWinsAmount if Config::allInEVSamples is 0
+    constexpr double getChipWinsEV(const u_int8_t playerId) const noexcept { return this->gameData.chipWinsAmount[playerId] + this->gameData.allInEVAdjustment[playerId]; }
+
+    /// @brief Gets the players that are still in the round (not out and not folded, all-in players included)
+    /// @return The seat bits of the players
+    /// @exception Guarantee No-throw
+    constexpr typename Seats::Bits getActiveSeats() const noexcept { return ~(this->gameData.playerOut.getBits() | this->roundData.playerFolded.getBits()) & Seats::getSeats(this->numPlayers); }
+
+    /// @brief Gets the players that can still act in the round (not out, not folded and not all-in)
+    /// @return The seat bits of the players
+    /// @exception Guarantee No-throw
+    constexpr typename Seats::Bits getActingSeats() const noexcept { return this->getActiveSeats() & ~this->roundData.playerAllIn.getBits(); }
+
+    /// @brief Recalculates the player counters from the seat masks
+    /// @exception Guarantee No-throw
+    /// @note Has to be called after the seat masks changed
+    constexpr void updateSeatCounters() noexcept {
+        this->gameData.numNonOutPlayers = Seats(~this->gameData.playerOut.getBits() & Seats::getSeats(this->numPlayers)).count();
+        this->roundData.numActivePlayers = Seats(this->getActiveSeats()).count();
+        this->roundData.numAllInPlayers = this->roundData.playerAllIn.count();
+    }
+
+    /// @brief Sets the player out of the game and updates the counters
+    /// @param playerPos The position of the player
+    /// @exception Guarantee No-throw
+    constexpr void setPlayerOut(const u_int8_t playerPos) noexcept {
+        this->gameData.playerOut.set(playerPos);
+        this->updateSeatCounters();
+    }
+
+    /// @brief Sets the current player folded and updates the counters
+    /// @exception Guarantee No-throw
+    constexpr void setPlayerFolded() noexcept {
+        this->roundData.playerFolded.set(this->betRoundData.playerPos);
+        this->updateSeatCounters();
+    }
+
+    /// @brief Sets the current player all-in and updates the counters
+    /// @exception Guarantee No-throw
+    constexpr void setPlayerAllIn() noexcept {
+        this->roundData.playerAllIn.set(this->betRoundData.playerPos);
+        this->updateSeatCounters();
+    }
+
+    /// @brief Resets the folded and all-in players for a new round and updates the counters
+    /// @exception Guarantee No-throw
+    constexpr void resetRoundSeats() noexcept {
+        this->roundData.playerFolded.clear();
+        this->roundData.playerAllIn.clear();
+        this->updateSeatCounters();
     }
 
     /// @brief Skips to the next player
@@ -106,36 +294,87 @@ struct Data {
 
     /// @brief Skips to the next active player
     /// @exception Guarantee No-throw
-    void nextActivePlayer() noexcept {
-        do {
-            this->betRoundData.playerPos = (this->betRoundData.playerPos + 1) % this->numPlayers;
-        } while (this->gameData.playerOut[this->betRoundData.playerPos] || this->roundData.playerFolded[this->betRoundData.playerPos] || this->getChips() == 0);
-    }
+    void nextActivePlayer() noexcept { this->betRoundData.playerPos = Seats::getNextSeat(this->getActingSeats(), this->betRoundData.playerPos, this->numPlayers); }
 
     /// @brief Tries to skip to the next active player. If no active player is found, the method does nothing
     /// @exception Guarantee No-throw
-    void tryNextActivePlayer() noexcept {
-        const u_int8_t playerPos = this->betRoundData.playerPos;
-        do {
-            this->betRoundData.playerPos = (this->betRoundData.playerPos + 1) % this->numPlayers;
-        } while (playerPos != this->betRoundData.playerPos &&
-                 (this->gameData.playerOut[this->betRoundData.playerPos] || this->roundData.playerFolded[this->betRoundData.playerPos] || this->getChips() == 0));
-    }
+    void tryNextActivePlayer() noexcept { this->betRoundData.playerPos = Seats::getNextSeat(this->getActingSeats(), this->betRoundData.playerPos, this->numPlayers); }
 
     /// @brief Skips to the next active or all-in player
     /// @exception Guarantee No-throw
-    void nextActiveOrAllInPlayer() noexcept {
-        do {
-            this->betRoundData.playerPos = (this->betRoundData.playerPos + 1) % this->numPlayers;
-        } while (this->gameData.playerOut[this->betRoundData.playerPos] || this->roundData.playerFolded[this->betRoundData.playerPos]);
-    }
+    void nextActiveOrAllInPlayer() noexcept { this->betRoundData.playerPos = Seats::getNextSeat(this->getActiveSeats(), this->betRoundData.playerPos, this->numPlayers); }
 
     /// @brief Adds amount to the current player bets and the total pot
     /// @param bet The number of chips to add to the player bets
-    constexpr void addPlayerBet(const u_int64_t bet) noexcept {
+    /// @note The chips are also added to the side pots
+    constexpr void addPlayerBet(const Chips bet) noexcept {
         this->betRoundData.playerBets[this->betRoundData.playerPos] += bet;
         this->roundData.playerBetsTotal[this->betRoundData.playerPos] += bet;
         this->roundData.pot += bet;
+        // the bets relative to the start of the current pot
+        Chips wholeBet = this->roundData.playerBetsTotal[this->betRoundData.playerPos];
+        Chips previousBet = wholeBet - bet;
+        for (u_int8_t i = 0; i < this->roundData.numPots; i++) {
+            PotType& pot = this->roundData.pots[i];
+            if (pot.isCapped() && previousBet >= pot.getCap()) {
+                // the player already filled this pot
+                wholeBet -= pot.getCap();
+                previousBet -= pot.getCap();
+                continue;
+            }
+            wholeBet = pot.addChips(wholeBet, previousBet);
+            if (wholeBet == 0) return;
+            previousBet = 0;
+        }
+    }
+
+    /// @brief Adds dead money (like the big blind ante) to the total pot and the main pot
+    /// @param chips The number of chips
+    /// @exception Guarantee No-throw
+    /// @note The chips are not a bet of the current player, so they are not part of the player bets and do not raise the level at which the pots are capped
+    constexpr void addDeadChips(const Chips chips) noexcept {
+        this->roundData.pot += chips;
+        this->roundData.pots[0].addDeadChips(chips);
+    }
+
+    /// @brief Resets the pots to one empty main pot
+    /// @exception Guarantee No-throw
+    constexpr void resetPots() noexcept {
+        this->roundData.pots[0].reset();
+        this->roundData.numPots = 1;
+    }
+
+    /** @brief Caps the pots at the total bet of the current player who just went all-in
+     * @exception Guarantee No-throw
+     * @note Has to be called after the all-in chips were added with addPlayerBet()
+     * @note The pot containing the all-in amount is split, the player does not contend for any pot above
+     */
+    constexpr void capPots() noexcept {
+        const u_int8_t playerPos = this->betRoundData.playerPos;
+        // the all-in amount relative to the start of the current pot and the start of the current pot
+        Chips level = this->roundData.playerBetsTotal[playerPos];
+        Chips base = 0;
+        u_int8_t i = 0;
+        while (this->roundData.pots[i].isCapped() && level > this->roundData.pots[i].getCap()) {
+            level -= this->roundData.pots[i].getCap();
+            base += this->roundData.pots[i].getCap();
+            i++;
+        }
+        PotType& pot = this->roundData.pots[i];
+        if (!pot.isCapped() || level < pot.getCap()) {
+            // sum up the bet parts above the new cap that have to be moved to the new pot
+            Chips overflow = 0;
+            for (u_int8_t j = 0; j < this->numPlayers; j++) {
+                const Chips bet = this->roundData.playerBetsTotal[j] < base ? 0 : this->roundData.playerBetsTotal[j] - base;
+                const Chips potBet = pot.isCapped() ? std::min(bet, pot.getCap()) : bet;
+                if (potBet > level) overflow += potBet - level;
+            }
+            // insert the new pot after the split one
+            for (u_int8_t j = this->roundData.numPots; j > i + 1; j--) this->roundData.pots[j] = this->roundData.pots[j - 1];
+            this->roundData.pots[i + 1] = pot.split(level, overflow);
+            this->roundData.numPots++;
+        }
+        for (u_int8_t j = i + 1; j < this->roundData.numPots; j++) this->roundData.pots[j].addNonContender(playerPos);
     }
 
     /** @brief Selects the dealer position for the next round
@@ -148,9 +387,7 @@ struct Data {
         if (firstRound) {
             this->roundData.dealerPos = 0;
         } else {
-            do {
-                this->roundData.dealerPos = (this->roundData.dealerPos + 1) % this->numPlayers;
-            } while (this->gameData.playerOut[this->roundData.dealerPos]);
+            this->roundData.dealerPos = Seats::getNextSeat((typename Seats::Bits)~this->gameData.playerOut.getBits(), this->roundData.dealerPos, this->numPlayers);
         }
     }
     /** @brief Removes chips from the current player but only if he has at least 1 chip left after the removal
@@ -174,13 +411,13 @@ struct Data {
      * @return Number of chips that the current player has
      * @exception Guarantee No-throw
      */
-    u_int64_t getChips() const noexcept { return this->gameData.playerChips[this->betRoundData.playerPos]; }
+    Chips getChips() const noexcept { return this->gameData.playerChips[this->betRoundData.playerPos]; }
 
     /** @brief Gets the number of chips that the current player has to add to match the current bet
      * @return Number of chips that the current player has to add to match the current bet
      * @exception Guarantee No-throw
      */
-    u_int64_t getCallAdd() const noexcept { return this->betRoundData.currentBet - this->betRoundData.playerBets[this->betRoundData.playerPos]; }
+    Chips getCallAdd() const noexcept { return this->betRoundData.currentBet - this->betRoundData.playerBets[this->betRoundData.playerPos]; }
 
     /** @brief Gets the number of chips that the current player has to add to raise to a bet
      * @param bet The bet that the player wants to raise to
@@ -244,4 +481,13 @@ struct Data {
         std::cout << std::endl;
         std::cout << "********************** END OF DATA *********************" << std::endl;
     }
-};
\ No newline at end of file
+};
+
+/// @brief The bet round data of the default table
+using BetRoundData = BasicBetRoundData<MAX_PLAYERS, u_int64_t>;
+/// @brief The round data of the default table
+using RoundData = BasicRoundData<MAX_PLAYERS, u_int64_t>;
+/// @brief The game data of the default table
+using GameData = BasicGameData<MAX_PLAYERS, u_int64_t>;
+/// @brief The data of the default table (MAX_PLAYERS seats, 64 bit chips)
+using Data = BasicData<MAX_PLAYERS, u_int64_t>;
@@ -0,0 +1,81 @@
+#pragma once
+#include <memory>
+
+#include "deck.h"
+
+/// @brief A block of deals (5 community cards and the hole cards of every player) in structure of arrays layout
+/// @note cards[slot][deal] is a card of a deal, the slots 0 to 4 are the community cards and the slots 5 + 2 * p and 6 + 2 * p are the hole cards of player p
+/// @note The cards of a slot are contiguous, so the consumers can stream over one slot of all deals of the block
+/// @see DealGenerator
+struct DealBlock {
+    /// @brief The cards of the deals, cards[slot][deal]
+    Card cards[MAX_DRAWN_CARDS][DEAL_BLOCK_SIZE];
+    /// @brief The number of deals in the block
+    u_int32_t size = 0;
+    /// @brief The number of players of every deal
+    u_int8_t players = 0;
+
+    /// @brief Copies the community cards of a deal
+    /// @param deal The index of the deal in the block
+    /// @param communityCards The 5 community cards
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if deal >= size
+    constexpr void getCommunityCards(const u_int32_t deal, Card communityCards[]) const noexcept {
+        for (u_int8_t i = 0; i < 5; i++) communityCards[i] = this->cards[i][deal];
+    }
+
+    /// @brief Gets the hole cards of a player in a deal
+    /// @param deal The index of the deal in the block
+    /// @param player The player
+    /// @return The hole cards of the player
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if deal >= size or player >= players
+    constexpr std::pair<Card, Card> getHand(const u_int32_t deal, const u_int8_t player) const noexcept {
+        return {this->cards[5 + 2 * player][deal], this->cards[6 + 2 * player][deal]};
+    }
+};
+
+/// @brief Generates whole blocks of random deals for the Monte Carlo tools
+/// @note The random numbers of a block are generated first, slot by slot with the counter-based generator (Philox), in a loop without dependencies that the compiler vectorizes
+/// @note Then every deal draws its cards with a partial Fisher-Yates shuffle from a fresh deck, so the generation does not share state with the evaluation
+/// @note Block b of a seed is a pure function of the seed and b, the blocks can be generated by different threads
+class DealGenerator {
+   public:
+    /// @brief Creates a generator
+    /// @param seed The seed of the deals
+    /// @param players The number of players of every deal (1 to MAX_PLAYERS)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the number of players is 0 or greater than MAX_PLAYERS
+    DealGenerator(const u_int64_t seed, const u_int8_t players);
+
+    /// @brief Fills a block with the next deals
+    /// @param block The block
+    /// @param size The number of deals (at most DEAL_BLOCK_SIZE)
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if size > DEAL_BLOCK_SIZE
+    void generate(DealBlock& block, const u_int32_t size = DEAL_BLOCK_SIZE) noexcept;
+
+    /// @brief Gets the number of generated blocks
+    /// @return The index of the next block
+    /// @exception Guarantee No-throw
+    u_int64_t getBlocks() const noexcept { return this->nextBlock; }
+
+    /// @brief Fills the random numbers of a block, random[i] is the number i of the counter-based stream of the block
+    /// @param seed The seed (the key)
+    /// @param block The index of the block
+    /// @param random The random numbers
+    /// @param count The number of random numbers, a multiple of 4
+    /// @exception Guarantee No-throw
+    /// @note The same numbers as Philox{seed, block, 0, RandomStream::DEAL_BLOCK}.next() count times, but every block of four numbers is generated independently
+    static void fillRandom(const u_int64_t seed, const u_int64_t block, u_int32_t random[], const u_int32_t count) noexcept;
+
+   private:
+    /// @brief The seed of the deals
+    const u_int64_t seed;
+    /// @brief The number of cards of a deal
+    const u_int8_t numCards;
+    /// @brief The index of the next block
+    u_int64_t nextBlock = 0;
+    /// @brief The random numbers of the current block, random[slot * DEAL_BLOCK_SIZE + deal]
+    std::unique_ptr<u_int32_t[]> random;
+};
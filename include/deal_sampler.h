@@ -0,0 +1,196 @@
+#pragma once
+#include <vector>
+
+#include "deal_generator.h"
+
+/// @brief The weights of the 1326 hole card combinations of a seat
+/// @note A combination is indexed by the indices of its two cards (suit * 13 + rank - 2), a weight of 0 excludes it
+/// @see DealSampler
+class HandRange {
+   public:
+    /// @brief Creates an empty range
+    /// @exception Guarantee No-throw
+    constexpr HandRange() noexcept {}
+
+    /// @brief Creates the range of every hand
+    /// @return The range with weight 1 for every combination
+    /// @exception Guarantee No-throw
+    static HandRange any() noexcept {
+        return HandRange{}.addIf([](const Card, const Card) { return true; });
+    }
+
+    /// @brief Creates the range of the pocket pairs
+    /// @return The range with weight 1 for every pocket pair
+    /// @exception Guarantee No-throw
+    static HandRange pocketPairs() noexcept {
+        return HandRange{}.addIf([](const Card first, const Card second) { return first.rank == second.rank; });
+    }
+
+    /// @brief Creates the range of the suited connectors (including A2 suited)
+    /// @return The range with weight 1 for every suited connector
+    /// @exception Guarantee No-throw
+    static HandRange suitedConnectors() noexcept {
+        return HandRange{}.addIf([](const Card first, const Card second) {
+            const u_int8_t gap = first.rank > second.rank ? first.rank - second.rank : second.rank - first.rank;
+            return first.suit == second.suit && (gap == 1 || gap == 12);
+        });
+    }
+
+    /// @brief Adds a weight to a combination
+    /// @param first The first card
+    /// @param second The second card
+    /// @param weight The weight that is added (the weight of a combination is at most UINT16_MAX)
+    /// @return The range
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if a card is invalid or the cards are equal
+    HandRange& add(const Card first, const Card second, const u_int16_t weight = 1);
+
+    /// @brief Adds a weight to every combination that satisfies a predicate
+    /// @tparam Predicate bool(Card, Card)
+    /// @param predicate The predicate of the combinations
+    /// @param weight The weight that is added (the weight of a combination is at most UINT16_MAX)
+    /// @return The range
+    /// @exception Guarantee No-throw
+    template <typename Predicate>
+    HandRange& addIf(const Predicate& predicate, const u_int16_t weight = 1) noexcept {
+        for (u_int8_t first = 0; first < CARD_NUM; first++) {
+            for (u_int8_t second = first + 1; second < CARD_NUM; second++) {
+                u_int16_t& combo = this->weights[HandRange::getComboIndex(first, second)];
+                if (predicate(HandRange::getCard(first), HandRange::getCard(second))) combo = std::min<u_int32_t>(combo + weight, UINT16_MAX);
+            }
+        }
+        return *this;
+    }
+
+    /// @brief Gets the weight of a combination
+    /// @param combo The index of the combination
+    /// @return The weight
+    /// @exception Guarantee No-throw
+    constexpr u_int16_t getWeight(const u_int16_t combo) const noexcept { return this->weights[combo]; }
+
+    /// @brief Gets the index of a combination
+    /// @param first The index of the first card
+    /// @param second The index of the second card, not equal to first
+    /// @return The index from 0 to COMBO_NUM - 1, the same for both orders of the cards
+    /// @exception Guarantee No-throw
+    static constexpr u_int16_t getComboIndex(u_int8_t first, u_int8_t second) noexcept {
+        if (first > second) std::swap(first, second);
+        // the combinations of the lower first cards come before
+        return first * (2 * CARD_NUM - first - 1) / 2 + second - first - 1;
+    }
+
+    /// @brief Gets the index of a card
+    /// @param card The card
+    /// @return The index suit * 13 + rank - 2
+    /// @exception Guarantee No-throw
+    static constexpr u_int8_t getCardIndex(const Card card) noexcept { return card.suit * 13 + card.rank - 2; }
+
+    /// @brief Gets the card of an index
+    /// @param index The index suit * 13 + rank - 2
+    /// @return The card
+    /// @exception Guarantee No-throw
+    static constexpr Card getCard(const u_int8_t index) noexcept { return Card{(u_int8_t)(index % 13 + 2), (u_int8_t)(index / 13)}; }
+
+   private:
+    /// @brief The weight of every combination
+    u_int16_t weights[COMBO_NUM]{};
+};
+
+/// @brief The cards of a deal
+struct Deal {
+    /// @brief The hole cards of every seat
+    std::pair<Card, Card> hands[MAX_PLAYERS];
+    /// @brief The community cards, the first three are the flop
+    Card board[5];
+};
+
+/// @brief Draws deals directly from the hand ranges of the seats and a flop texture (no rejection of whole deals)
+/// @note Every range is an alias table (Vose), a combination that collides with the cards of the seats before is drawn again
+/// @note After DEAL_SAMPLER_ALIAS_TRIES collisions the combination is drawn from the remaining weights of the range
+/// @note The seats are drawn in order, every seat from its range without the dead cards of the seats before (conditional sampling with card removal)
+/// @note The flop is drawn from the groups of the BoardTexture weighted by their number of flops, so every possible flop of the texture is equally likely
+class DealSampler {
+   public:
+    /// @brief Creates a sampler where every seat can hold any hand and the flop is unconstrained
+    /// @param numPlayers The number of seats (1 to MAX_PLAYERS)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the number of seats is 0 or greater than MAX_PLAYERS
+    DealSampler(const u_int8_t numPlayers);
+
+    /// @brief Sets the range of a seat
+    /// @param seat The seat
+    /// @param range The range
+    /// @return The sampler
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the seat is invalid or the range is empty
+    DealSampler& setRange(const u_int8_t seat, const HandRange& range);
+
+    /// @brief Sets the texture of the flop
+    /// @param texture The texture
+    /// @return The sampler
+    /// @exception Guarantee No-throw
+    DealSampler& setBoardTexture(const BoardTexture texture) noexcept {
+        this->texture = texture;
+        return *this;
+    }
+
+    /// @brief Gets the number of seats
+    /// @return The number of seats
+    /// @exception Guarantee No-throw
+    u_int8_t getNumPlayers() const noexcept { return this->numPlayers; }
+
+    /// @brief Draws a deal
+    /// @param rng The generator
+    /// @param deal The deal, the hands of the seats and the board
+    /// @return False if the cards of the seats before left no combination of the range of a seat or no flop of the texture
+    /// @exception Guarantee No-throw
+    bool sample(Philox& rng, Deal& deal) const noexcept;
+
+    /// @brief Fills a block of deals for the Monte Carlo tools
+    /// @param rng The generator
+    /// @param block The block
+    /// @param size The number of deals (at most DEAL_BLOCK_SIZE)
+    /// @return False if a deal could not be drawn (see sample())
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if size > DEAL_BLOCK_SIZE
+    bool sample(Philox& rng, DealBlock& block, const u_int32_t size = DEAL_BLOCK_SIZE) const noexcept;
+
+   private:
+    /// @brief The alias table of a range
+    struct AliasTable {
+        /// @brief The combinations with a weight, the indices of the cards as first << 8 | second
+        std::vector<u_int16_t> combos;
+        /// @brief The weights of the combinations
+        std::vector<u_int16_t> weights;
+        /// @brief The threshold of a column, the combination of the column is drawn if a number below total weight is below it
+        std::vector<u_int32_t> thresholds;
+        /// @brief The other combination of a column (an index in combos)
+        std::vector<u_int16_t> aliases;
+        /// @brief The sum of the weights
+        u_int32_t totalWeight = 0;
+    };
+
+    /// @brief Draws the hand of a seat
+    /// @param rng The generator
+    /// @param table The alias table of the seat
+    /// @param dead The dead cards (bit i for card index i)
+    /// @param hand The hand
+    /// @return False if every combination of the range collides with the dead cards
+    /// @exception Guarantee No-throw
+    static bool sampleHand(Philox& rng, const AliasTable& table, const u_int64_t dead, std::pair<Card, Card>& hand) noexcept;
+
+    /// @brief Draws the board
+    /// @param rng The generator
+    /// @param dead The dead cards (bit i for card index i)
+    /// @param board The board
+    /// @return False if there is no flop of the texture
+    /// @exception Guarantee No-throw
+    bool sampleBoard(Philox& rng, u_int64_t dead, Card board[]) const noexcept;
+
+    /// @brief The number of seats
+    u_int8_t numPlayers;
+    /// @brief The texture of the flop
+    BoardTexture texture = BoardTexture::ANY;
+    /// @brief The alias table of the range of every seat
+    AliasTable tables[MAX_PLAYERS];
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "config.h"
+#include "philox.h"
 
 /// @brief Represents one of the 52 cards in a poker deck
 struct Card {
@@ -54,6 +55,34 @@ class Deck {
     /// @exception Guarantee No-throw
     void shuffle() noexcept { std::random_shuffle(&this->cards[0], &this->cards[CARD_NUM]); }
 
+    /// @brief Shuffles the deck with a seeded generator (splitmix64 Fisher-Yates shuffle)
+    /// @param seed The seed of the shuffle
+    /// @exception Guarantee No-throw
+    /// @note The same seed always results in the same order if the deck had the same order before (e.g. a new deck)
+    /// @note Independent of the global random state, therefore it can be used to replay deals
+    constexpr void shuffle(u_int64_t seed) noexcept {
+        for (u_int8_t i = CARD_NUM - 1; i > 0; i--) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            u_int64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z ^= z >> 31;
+            std::swap(this->cards[i], this->cards[z % (i + 1)]);
+        }
+    }
+
+    /// @brief Replaces the deck with a new deck that is shuffled by the counter-based generator (Philox Fisher-Yates shuffle)
+    /// @param seed The seed of the run
+    /// @param game The index of the game
+    /// @param round The index of the round in the game
+    /// @exception Guarantee No-throw
+    /// @note The order is a pure function of the seed, the game and the round, so any round can be dealt again without the rounds before it
+    constexpr void shuffle(const u_int64_t seed, const u_int64_t game, const u_int32_t round) noexcept {
+        *this = Deck();
+        Philox rng{seed, game, round, RandomStream::DECK};
+        for (u_int8_t i = CARD_NUM - 1; i > 0; i--) std::swap(this->cards[i], this->cards[rng.uniform(i + 1)]);
+    }
+
     /// @brief Resets the deck to its initial state
     /// @exception Guarantee No-throw
     /// @note The deck will be in the same order as it was before drawing the first card
@@ -65,6 +94,14 @@ class Deck {
     /// @throws std::logic_error if the deck is empty
     Card draw();
 
+    /// @brief Moves cards to the top of the remaining deck, so they are drawn in the given order
+    /// @param order The cards, order[0] is the next card to draw
+    /// @param numCards The number of cards
+    /// @exception Guarantee Basic
+    /// @throws std::invalid_argument if a card is not in the remaining deck or there are more cards than the remaining deck
+    /// @note The other cards keep their order
+    void arrange(const Card order[], const u_int8_t numCards);
+
     /// @brief Gets the string representation of the deck
     /// @param sep The separator character between each card
     /// @return The string representation of the deck
@@ -0,0 +1,181 @@
+#pragma once
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "game.h"
+
+/// @brief Contains the settings of a duplicate run
+/// @see BasicDuplicateRunner
+struct DuplicateConfig {
+    /// @brief The number of deal sequences, every sequence is played once per seating
+    u_int32_t numDeals;
+    /// @brief The seed of the deal sequences, the seed of every sequence is derived from it
+    u_int64_t seed;
+    /// @brief How the players are seated for every deal sequence
+    DuplicateSeating seating = DuplicateSeating::ROTATIONS;
+    /// @brief The number of threads that play the deal sequences
+    u_int8_t threads = 1;
+};
+
+/// @brief Contains the result of one player against another player over all deal sequences of a duplicate run
+/// @note The score of a deal sequence is the difference of the (all-in EV adjusted) chips won by the two players, averaged over all seatings
+/// @note The mean and the variance are updated with Welford's algorithm, the results of multiple threads can be merged
+struct DuplicatePairResult {
+    /// @brief The number of deal sequences
+    u_int32_t deals;
+    /// @brief The mean score of the deal sequences
+    double mean;
+    /// @brief The sum of the squared differences from the mean
+    double m2;
+
+    /// @brief Adds the score of a deal sequence
+    /// @param score The score of the deal sequence
+    /// @exception Guarantee No-throw
+    constexpr void add(const double score) noexcept {
+        this->deals++;
+        const double delta = score - this->mean;
+        this->mean += delta / this->deals;
+        this->m2 += delta * (score - this->mean);
+    }
+
+    /// @brief Merges the result of other deal sequences into this result
+    /// @param other The result of the other deal sequences
+    /// @exception Guarantee No-throw
+    constexpr void merge(const DuplicatePairResult& other) noexcept {
+        if (other.deals == 0) return;
+        const u_int32_t deals = this->deals + other.deals;
+        const double delta = other.mean - this->mean;
+        this->mean += delta * other.deals / deals;
+        this->m2 += other.m2 + delta * delta * this->deals * other.deals / deals;
+        this->deals = deals;
+    }
+
+    /// @brief Gets the sample variance of the scores
+    /// @return The sample variance or 0 if there are less than 2 deal sequences
+    /// @exception Guarantee No-throw
+    constexpr double getVariance() const noexcept { return this->deals < 2 ? 0 : this->m2 / (this->deals - 1); }
+
+    /// @brief Gets the standard error of the mean score
+    /// @return The standard error or 0 if there are less than 2 deal sequences
+    /// @exception Guarantee No-throw
+    double getStandardError() const noexcept { return this->deals < 2 ? 0 : std::sqrt(this->getVariance() / this->deals); }
+};
+
+/// @brief Compares players with duplicate deals: every deal sequence is replayed with the players seated in every rotation or permutation
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+/// @note The deal sequences are distributed over multiple threads, every thread plays whole deal sequences on its own game
+/// @note Every seating plays Config::numGames games, the players are created again for every seating
+/// @note Config::earlyStop is applied to the deal sequences of every thread, a thread stops its range as soon as its own results are significant
+/// @see DuplicateRunner for the default table
+template <u_int8_t N, typename Chips>
+class BasicDuplicateRunner {
+   public:
+    /// @brief Creates the player with the given id
+    using PlayerFactory = std::function<std::unique_ptr<BasicPlayer<N, Chips>>(const u_int8_t id)>;
+
+    /// @brief Creates a duplicate runner
+    /// @param config The config of the games that are played for every seating
+    /// @param duplicateConfig The settings of the duplicate run
+    /// @param playerFactory Creates the player with the given id or nullptr for the default players of the game
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the number of deals or threads is 0
+    /// @throws std::invalid_argument if every permutation is requested for more than MAX_DUPLICATE_PERMUTATION_PLAYERS players
+    /// @note The factory is called from multiple threads if more than one thread is used
+    BasicDuplicateRunner(const BasicConfig<N, Chips>& config, const DuplicateConfig& duplicateConfig, const PlayerFactory& playerFactory = nullptr);
+
+    /// @brief Plays all deal sequences with all seatings and logs the aggregated results
+    /// @exception Guarantee Basic
+    /// @throws std::logic_error if a game could not be played (see BasicGame::run())
+    /// @note The results of a previous run are reset
+    void run();
+
+    /// @brief Gets the number of seatings per deal sequence
+    /// @return The number of seatings
+    /// @exception Guarantee No-throw
+    u_int32_t getNumSeatings() const noexcept { return this->seatings.size(); }
+
+    /// @brief Gets the number of games won by a player over all deal sequences and seatings
+    /// @param playerId The id of the player
+    /// @return The number of games won
+    /// @exception Guarantee No-throw
+    u_int64_t getGameWins(const u_int8_t playerId) const noexcept { return this->results.gameWins[playerId]; }
+
+    /// @brief Gets the all-in EV adjusted chips won by a player over all deal sequences and seatings
+    /// @param playerId The id of the player
+    /// @return The chips won
+    /// @exception Guarantee No-throw
+    /// @see Data::getChipWinsEV()
+    double getChipWins(const u_int8_t playerId) const noexcept { return this->results.chipWins[playerId]; }
+
+    /// @brief Gets the result of a player against another player
+    /// @param playerId The id of the first player
+    /// @param otherId The id of the second player (has to be greater than playerId)
+    /// @return The result, a positive mean score favours the first player
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if otherId <= playerId
+    const DuplicatePairResult& getPairResult(const u_int8_t playerId, const u_int8_t otherId) const noexcept { return this->results.pairs[playerId][otherId]; }
+
+    /// @brief Gets the number of deal sequences played in the last run
+    /// @return DuplicateConfig::numDeals or less if the threads were stopped early by Config::earlyStop
+    /// @exception Guarantee No-throw
+    u_int32_t getDealsPlayed() const noexcept { return this->results.deals; }
+
+    /// @brief Lets every thread count its work in its own counters of a progress reporter
+    /// @param progressReporter The reporter or nullptr, it has to outlive the runs
+    /// @exception Guarantee No-throw
+    void setProgressReporter(ProgressReporter* progressReporter) noexcept { this->progressReporter = progressReporter; }
+
+   private:
+    /// @brief Contains the aggregated results of deal sequences
+    struct Results {
+        /// @brief The number of deal sequences played
+        u_int32_t deals;
+        /// @brief The number of games won per player id
+        u_int64_t gameWins[N];
+        /// @brief The all-in EV adjusted chips won per player id
+        double chipWins[N];
+        /// @brief The results per pair of player ids (only [a][b] with a < b is used)
+        DuplicatePairResult pairs[N][N];
+
+        /// @brief Merges the results of other deal sequences into these results
+        /// @param other The results of the other deal sequences
+        /// @exception Guarantee No-throw
+        void merge(const Results& other) noexcept;
+    };
+
+    /// @brief Plays a range of deal sequences with all seatings
+    /// @param firstDeal The first deal sequence
+    /// @param lastDeal The deal sequence after the last one
+    /// @param results The results the deal sequences are added to
+    /// @exception Guarantee Basic
+    /// @throws std::logic_error if a game could not be played (see BasicGame::run())
+    void runDeals(const u_int32_t firstDeal, const u_int32_t lastDeal, Results& results) const;
+
+    /// @brief Derives the seed of a deal sequence (splitmix64)
+    /// @param deal The number of the deal sequence
+    /// @return The seed of the deal sequence
+    /// @exception Guarantee No-throw
+    u_int64_t getDealSeed(const u_int32_t deal) const noexcept;
+
+    /// @brief Logs the aggregated results
+    /// @exception Guarantee No-throw
+    void logResults() const noexcept;
+
+    /// @brief The config of the games
+    const BasicConfig<N, Chips> config;
+    /// @brief The settings of the duplicate run
+    const DuplicateConfig duplicateConfig;
+    /// @brief Creates the players or nullptr for the default players
+    const PlayerFactory playerFactory;
+    /// @brief The seatings that are played for every deal sequence, seatings[k][i] is the id of the player on position i
+    std::vector<std::array<u_int8_t, N>> seatings;
+    /// @brief The aggregated results of the last run
+    Results results{};
+    /// @brief The reporter that gets the counters of every thread or nullptr
+    ProgressReporter* progressReporter = nullptr;
+};
+
+/// @brief The duplicate runner of the default table
+using DuplicateRunner = BasicDuplicateRunner<MAX_PLAYERS, u_int64_t>;
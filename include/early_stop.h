@@ -0,0 +1,130 @@
+#pragma once
+#include "checkpoint.h"
+
+/// @brief Tracks streaming estimates of the game-win and chip-win rates of every player and decides if a simulation can be stopped early
+/// @tparam N The number of seats at the table
+/// @note A sample is one game, or one deal sequence with all seatings in duplicate runs (the wins are the share of the games won then)
+/// @note The means and variances are updated with Welford's algorithm
+/// @see EarlyStopConfig for the stopping rules
+template <u_int8_t N>
+class BasicEarlyStop {
+   public:
+    /// @brief Creates an estimator without samples
+    /// @param config The settings of the stopping rule
+    /// @param numPlayers The number of players
+    /// @param tableChips The chips at the table per sample, the scale of the chip-win confidence intervals
+    /// @exception Guarantee No-throw
+    BasicEarlyStop(const EarlyStopConfig& config, const u_int8_t numPlayers, const double tableChips) noexcept;
+
+    /// @brief Adds a sample
+    /// @param wins The share of the games won per player id (0 or 1 for a single game)
+    /// @param chips The chips won per player id
+    /// @exception Guarantee No-throw
+    void addSample(const double wins[], const double chips[]) noexcept;
+
+    /// @brief Checks the stopping rule
+    /// @return True if the rule is enabled, at least minGames samples were added and the results are significant
+    /// @exception Guarantee No-throw
+    /// @note SPRT: every pair of players is decided, either one player is better by at least delta or the gap is smaller than delta
+    /// @note Confidence interval: the intervals of all game-win and chip-win rates are narrower than delta
+    bool isDecided() const noexcept;
+
+    /// @brief Gets the number of samples
+    /// @return The number of samples
+    /// @exception Guarantee No-throw
+    u_int64_t getSamples() const noexcept { return this->samples; }
+
+    /// @brief Gets the game-win rate of a player
+    /// @param playerId The id of the player
+    /// @return The mean share of the games won per sample
+    /// @exception Guarantee No-throw
+    double getWinRate(const u_int8_t playerId) const noexcept { return this->wins[playerId].mean; }
+
+    /// @brief Gets the half-width of the confidence interval of the game-win rate of a player (at the significance level alpha)
+    /// @param playerId The id of the player
+    /// @return The half-width or 0 if there are less than 2 samples
+    /// @exception Guarantee No-throw
+    double getWinRateHalfWidth(const u_int8_t playerId) const noexcept { return this->z * this->wins[playerId].getStandardError(this->samples); }
+
+    /// @brief Gets the chip-win rate of a player
+    /// @param playerId The id of the player
+    /// @return The mean amount of chips won per sample
+    /// @exception Guarantee No-throw
+    double getChipRate(const u_int8_t playerId) const noexcept { return this->chips[playerId].mean; }
+
+    /// @brief Gets the half-width of the confidence interval of the chip-win rate of a player (at the significance level alpha)
+    /// @param playerId The id of the player
+    /// @return The half-width or 0 if there are less than 2 samples
+    /// @exception Guarantee No-throw
+    double getChipRateHalfWidth(const u_int8_t playerId) const noexcept { return this->z * this->chips[playerId].getStandardError(this->samples); }
+
+    /// @brief Gets the log-likelihood ratio that a player wins 0.5 + delta of the games that are only won by one of two players (against 0.5)
+    /// @param playerId The id of the player
+    /// @param otherId The id of the other player
+    /// @return The log-likelihood ratio, the SPRT accepts the gap if it reaches log((1 - beta) / alpha)
+    /// @exception Guarantee No-throw
+    double getLLR(const u_int8_t playerId, const u_int8_t otherId) const noexcept;
+
+    /// @brief Logs the estimates of every player and the samples that were saved
+    /// @param maxSamples The number of samples that would have been played without the stopping rule
+    /// @param sampleName The name of a sample in the log (e.g. "games")
+    /// @exception Guarantee No-throw
+    void logResults(const u_int64_t maxSamples, const char* sampleName) const noexcept;
+
+    /// @brief Appends the samples to a checkpoint
+    /// @param checkpoint The checkpoint
+    /// @exception Guarantee Basic
+    void save(Checkpoint& checkpoint) const;
+
+    /// @brief Restores the samples of a checkpoint
+    /// @param checkpoint The checkpoint that is read
+    /// @exception Guarantee Basic
+    /// @throws std::invalid_argument if the checkpoint is too short
+    /// @note The settings of the stopping rule are not part of the checkpoint
+    void restore(Checkpoint& checkpoint);
+
+   private:
+    /// @brief The streaming mean and variance of one rate
+    struct Rate {
+        /// @brief The mean of the samples
+        double mean;
+        /// @brief The sum of the squared differences from the mean
+        double m2;
+
+        /// @brief Adds a sample
+        /// @param value The value of the sample
+        /// @param samples The number of samples including this one
+        /// @exception Guarantee No-throw
+        void add(const double value, const u_int64_t samples) noexcept;
+
+        /// @brief Gets the standard error of the mean
+        /// @param samples The number of samples
+        /// @return The standard error or 0 if there are less than 2 samples
+        /// @exception Guarantee No-throw
+        double getStandardError(const u_int64_t samples) const noexcept;
+    };
+
+    /// @brief The settings of the stopping rule
+    const EarlyStopConfig config;
+    /// @brief The number of players
+    const u_int8_t numPlayers;
+    /// @brief The chips at the table per sample
+    const double tableChips;
+    /// @brief The two-sided standard normal quantile of alpha
+    double z;
+    /// @brief The SPRT bound that accepts a gap: log((1 - beta) / alpha)
+    double upperBound;
+    /// @brief The SPRT bound that rejects a gap: log(beta / (1 - alpha))
+    double lowerBound;
+    /// @brief The number of samples
+    u_int64_t samples = 0;
+    /// @brief The game-win rate per player id
+    Rate wins[N]{};
+    /// @brief The chip-win rate per player id
+    Rate chips[N]{};
+    /// @brief decisive[a][b] is the share of the games that were won by player a but not by player b
+    double decisive[N][N]{};
+};
+
+/// @brief The early stop estimator of the default table
+using EarlyStop = BasicEarlyStop<MAX_PLAYERS>;
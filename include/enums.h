@@ -78,6 +78,86 @@ enum class OutEnum {
     ROUND_SHOWDOWN,
 };
 
+/// @brief Represents how the duplicate runner seats the players for every deal sequence
+enum class DuplicateSeating {
+    /// @brief Every rotation of the initial seating (numPlayers seatings)
+    ROTATIONS,
+    /// @brief Every permutation of the seats (numPlayers! seatings)
+    PERMUTATIONS,
+};
+
+/// @brief Represents the rule that stops a simulation before all games are played
+enum class StopRule {
+    /// @brief All games are played
+    NONE,
+    /// @brief Sequential probability ratio test on the game wins of every pair of players
+    SPRT,
+    /// @brief Stop as soon as the confidence intervals of the game-win and chip-win rates of every player are narrow enough
+    CONFIDENCE_INTERVAL,
+};
+
+/// @brief Represents the file format of a results sink
+enum class ResultsFormat {
+    /// @brief Comma separated values with a header line, the first column is the record type
+    CSV,
+    /// @brief One JSON object per line
+    JSONL,
+    /// @brief Compact binary records in host byte order
+    BINARY,
+};
+
+/// @brief Represents what the asynchronous log appender does with a record if its ring is full
+enum class LogOverflow {
+    /// @brief The logging thread waits until the background thread freed a slot
+    BLOCK,
+    /// @brief The record is dropped and counted
+    DROP,
+    /// @brief Only one of ASYNC_LOG_SAMPLE_RATE verbose to info records is kept while the ring is more than half full, warnings and errors wait like BLOCK
+    SAMPLE,
+};
+
+/// @brief Represents an event of a hand that makes the hand log keep the debug log of the hand
+enum class HandLogTrigger {
+    /// @brief The pot is distributed in a showdown with all-in players
+    ALL_IN_SHOWDOWN,
+    /// @brief A pot is split between several winners
+    SPLIT_POT,
+    /// @brief A player is out because of an illegal move
+    ILLEGAL_MOVE,
+};
+
+/// @brief Represents what the numbers of a counter-based random stream are used for (see Philox)
+enum class RandomStream {
+    /// @brief The deck of a round
+    DECK,
+    /// @brief The player order of a game
+    PLAYER_ORDER,
+    /// @brief The sampled runouts of the all-in EV of a round
+    ALL_IN_EV,
+    /// @brief A block of deals of the Monte Carlo tools (see DealGenerator)
+    DEAL_BLOCK,
+    /// @brief The deal of a round drawn from the hand ranges (see DealSampler)
+    DEAL_SAMPLER,
+    /// @brief The seat draw of a tournament (see BasicTournamentRunner)
+    SEATING,
+    /// @brief The sampled finish orders of the ICM equities of a big field (see IcmCalculator)
+    ICM,
+};
+
+/// @brief Represents a constraint on the flop of a sampled deal (see DealSampler)
+enum class BoardTexture {
+    /// @brief Any flop
+    ANY,
+    /// @brief Three cards of one suit
+    MONOTONE,
+    /// @brief Two cards of one suit and one card of another suit
+    TWO_TONE,
+    /// @brief Three different suits
+    RAINBOW,
+    /// @brief Exactly two cards of one rank
+    PAIRED,
+};
+
 /// @brief This class is used to convert the enum values to strings for logging purposes
 class EnumToString {
    public:
@@ -222,4 +302,159 @@ class EnumToString {
                 return "INVALID BetRoundState value";
         }
     }
-};
\ No newline at end of file
+
+    /// @brief Converts DuplicateSeating to a corresponding string
+    /// @param seating The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const DuplicateSeating seating) noexcept {
+        switch (seating) {
+            case DuplicateSeating::ROTATIONS:
+                return "ROTATIONS";
+
+            case DuplicateSeating::PERMUTATIONS:
+                return "PERMUTATIONS";
+
+            default:
+                return "INVALID DuplicateSeating value";
+        }
+    }
+
+    /// @brief Converts StopRule to a corresponding string
+    /// @param rule The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const StopRule rule) noexcept {
+        switch (rule) {
+            case StopRule::NONE:
+                return "NONE";
+
+            case StopRule::SPRT:
+                return "SPRT";
+
+            case StopRule::CONFIDENCE_INTERVAL:
+                return "CONFIDENCE_INTERVAL";
+
+            default:
+                return "INVALID StopRule value";
+        }
+    }
+
+    /// @brief Converts ResultsFormat to a corresponding string
+    /// @param format The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const ResultsFormat format) noexcept {
+        switch (format) {
+            case ResultsFormat::CSV:
+                return "CSV";
+
+            case ResultsFormat::JSONL:
+                return "JSONL";
+
+            case ResultsFormat::BINARY:
+                return "BINARY";
+
+            default:
+                return "INVALID ResultsFormat value";
+        }
+    }
+
+    /// @brief Converts LogOverflow to a corresponding string
+    /// @param overflow The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const LogOverflow overflow) noexcept {
+        switch (overflow) {
+            case LogOverflow::BLOCK:
+                return "BLOCK";
+
+            case LogOverflow::DROP:
+                return "DROP";
+
+            case LogOverflow::SAMPLE:
+                return "SAMPLE";
+
+            default:
+                return "INVALID LogOverflow value";
+        }
+    }
+
+    /// @brief Converts HandLogTrigger to a corresponding string
+    /// @param trigger The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const HandLogTrigger trigger) noexcept {
+        switch (trigger) {
+            case HandLogTrigger::ALL_IN_SHOWDOWN:
+                return "ALL_IN_SHOWDOWN";
+
+            case HandLogTrigger::SPLIT_POT:
+                return "SPLIT_POT";
+
+            case HandLogTrigger::ILLEGAL_MOVE:
+                return "ILLEGAL_MOVE";
+
+            default:
+                return "INVALID HandLogTrigger value";
+        }
+    }
+
+    /// @brief Converts RandomStream to a corresponding string
+    /// @param stream The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const RandomStream stream) noexcept {
+        switch (stream) {
+            case RandomStream::DECK:
+                return "DECK";
+
+            case RandomStream::PLAYER_ORDER:
+                return "PLAYER_ORDER";
+
+            case RandomStream::ALL_IN_EV:
+                return "ALL_IN_EV";
+
+            case RandomStream::DEAL_BLOCK:
+                return "DEAL_BLOCK";
+
+            case RandomStream::DEAL_SAMPLER:
+                return "DEAL_SAMPLER";
+
+            case RandomStream::SEATING:
+                return "SEATING";
+
+            case RandomStream::ICM:
+                return "ICM";
+
+            default:
+                return "INVALID RandomStream value";
+        }
+    }
+
+    /// @brief Converts BoardTexture to a corresponding string
+    /// @param texture The enum value to convert
+    /// @return The string representation of the enum value
+    /// @exception Guarantee No-throw
+    static constexpr const char* enumToString(const BoardTexture texture) noexcept {
+        switch (texture) {
+            case BoardTexture::ANY:
+                return "ANY";
+
+            case BoardTexture::MONOTONE:
+                return "MONOTONE";
+
+            case BoardTexture::TWO_TONE:
+                return "TWO_TONE";
+
+            case BoardTexture::RAINBOW:
+                return "RAINBOW";
+
+            case BoardTexture::PAIRED:
+                return "PAIRED";
+
+            default:
+                return "INVALID BoardTexture value";
+        }
+    }
+};
@@ -1,20 +1,52 @@
 #pragma once
+#include <atomic>
 #include <memory>
 
+#include "cash_stats.h"
+#include "checkpoint.h"
+#include "deal_sampler.h"
+#include "early_stop.h"
 #include "hand_strengths.h"
+#include "progress.h"
+#include "results_sink.h"
+#include "turn_time_stats.h"
 
 /// @brief Simulates a set of poker games
+/// @tparam N The number of seats at the table, all per player state is sized by it
+/// @tparam Chips The unsigned integer type that stores chip amounts (bets, pots and stacks)
 /// @note Holds all required Data
-class Game {
+/// @note Only the configurations of POKER_TABLE_CONFIGS are compiled
+/// @see Game for the default table
+template <u_int8_t N, typename Chips>
+class BasicGame {
     /// @brief Used for unit testing
     friend class GameTest;
+    /// @brief Sets the players of the duplicate games
+    template <u_int8_t, typename>
+    friend class BasicDuplicateRunner;
+    /// @brief Seats the entrants at the tables of a tournament
+    template <u_int8_t, typename>
+    friend class BasicTournamentRunner;
 
    public:
     /// @brief Creates a Game object with the given Config
     /// @param config Holds all important settings that the simulation should consider
     /// @exception Guarantee No-throw
     /// @see Config
-    Game(const Config& config) noexcept : config(config), players(new std::unique_ptr<Player>[config.numPlayers]) {}
+    BasicGame(const BasicConfig<N, Chips>& config) noexcept : config(config), players(new std::unique_ptr<BasicPlayer<N, Chips>>[config.numPlayers]) {}
+
+    /// @brief Seats the default lineup (check, rand, check, rand, equity) at the table
+    /// @exception Guarantee No-throw
+    /// @note run() and runCash() seat it themselves if initPlayers is set to true
+    void setDefaultPlayers() noexcept;
+
+    /// @brief Checks if the decisions of all seated players are reproducible
+    /// @return True if every player is deterministic
+    /// @exception Guarantee No-throw
+    /// @note Only then a resumed run has the same results as a run without interruption
+    /// @note Undefined behavior if the players are not initialized
+    /// @see BasicPlayer::isDeterministic()
+    bool hasDeterministicPlayers() const noexcept;
 
     /// @brief Runs the simulation
     /// @param initPlayers Whether the method is responsible for initializing the players
@@ -27,13 +59,152 @@ class Game {
     /// @note Undefined behavior if the players are not initialized externally and initPlayers is set to false
     void run(const bool initPlayers = true);
 
+    /// @brief Runs the simulation with a fixed seating and a replayable deal sequence (duplicate mode)
+    /// @param dealSeed The seed of the deal sequence, the deck of every round is derived from it, the game and the round
+    /// @param seatOrder seatOrder[i] is the id of the player on position i (a permutation of the ids 0 to numPlayers - 1)
+    /// @param initPlayers Whether the method is responsible for initializing the players
+    /// @exception Guarantee None
+    /// @throws std::invalid_argument if the player name is too long
+    /// @throws std::logic_error if the deck is empty
+    /// @throws std::logic_error if the player could not call a matched bet
+    /// @throws std::logic_error if the player choose an action which is not covered
+    /// @note Config::shufflePlayers and Config::shuffleDeck are ignored, the statistics are not logged
+    /// @note The player ids are the positions before the players are seated, like in run()
+    /// @see BasicDuplicateRunner
+    void runDuplicate(const u_int64_t dealSeed, const u_int8_t seatOrder[], const bool initPlayers = true);
+
+    /// @brief Runs the simulation as cash games: every game is a session of a fixed number of hands with fixed blinds
+    /// @param hands The number of hands of every game (1 to INT16_MAX)
+    /// @param initPlayers Whether the method is responsible for initializing the players
+    /// @exception Guarantee None
+    /// @throws std::invalid_argument if the number of hands is 0 or greater than INT16_MAX
+    /// @throws std::invalid_argument if the player name is too long
+    /// @throws std::logic_error if the deck is empty
+    /// @throws std::logic_error if the player could not call a matched bet
+    /// @throws std::logic_error if the player choose an action which is not covered
+    /// @note Before every hand each stack below the starting chips is topped up to them (automatic rebuy), so nobody is out and the table stays full
+    /// @note Config::addBlindPerDealer0 and Config::maxRounds are ignored, a game is won by the players with the best net result of the session
+    /// @note The net result of every hand is collected per player, see getCashStats()
+    void runCash(const u_int16_t hands, const bool initPlayers = true);
+
+    /// @brief Plays one hand of a tournament table with the given blinds
+    /// @param smallBlind The small blind, the big blind is twice the small blind
+    /// @param ante The big blind ante or 0, it is posted after the big blind and only from the chips behind the big blind
+    /// @exception Guarantee None
+    /// @throws std::logic_error if the deck is empty
+    /// @throws std::logic_error if the player could not call a matched bet
+    /// @throws std::logic_error if the player choose an action which is not covered
+    /// @note The table has to be set up with initTournamentTable() and seatPlayer(), the seats without chips are out after the hand
+    /// @see BasicTournamentRunner
+    void playTournamentHand(const Chips smallBlind, const Chips ante);
+
+    /// @brief Makes the decks and the player order of run() a pure function of the seed, the game and the round (counter-based generator)
+    /// @param seed The seed of the games
+    /// @param firstGame The index of the first game of the run, so a range of games can be played by different games or processes
+    /// @exception Guarantee No-throw
+    /// @note The sampled all-in EV runouts are derived from the coordinates too, the decisions of random players are not
+    /// @see Philox
+    void setSeed(const u_int64_t seed, const u_int64_t firstGame = 0) noexcept {
+        this->seeded = true;
+        this->seed = seed;
+        this->firstGame = firstGame;
+    }
+
+    /// @brief Gets the decision time statistics of a player
+    /// @param playerId The player id (position at the start of the game set)
+    /// @return The decision time statistics of the player
+    /// @exception Guarantee No-throw
+    /// @note The statistics are only collected if Config::measureTurnTime is set or Config::turnTimeBudget is not 0
+    /// @note Undefined behavior if playerId >= N
+    /// @see TurnTimeStats
+    const TurnTimeStats& getTurnTimeStats(const u_int8_t playerId) const noexcept { return this->turnTimeStats[playerId]; }
+
+    /// @brief Gets the hand results of a player in the last cash run
+    /// @param playerId The player id (position at the start of the game set)
+    /// @return The hand results of the player
+    /// @exception Guarantee No-throw
+    /// @note The statistics are only collected by runCash(), the results are all-in EV adjusted if Config::allInEVSamples is not 0
+    /// @note Undefined behavior if playerId >= N
+    /// @see CashStats
+    const CashStats& getCashStats(const u_int8_t playerId) const noexcept { return this->cashStats[playerId]; }
+
+    /// @brief Gets the data of the simulation (game results, chips and player statistics)
+    /// @return The data of the game
+    /// @exception Guarantee No-throw
+    const BasicData<N, Chips>& getData() const noexcept { return this->data; }
+
+    /// @brief Gets the number of games played in the last run
+    /// @return Config::numGames or less if the run was stopped early by Config::earlyStop
+    /// @exception Guarantee No-throw
+    u_int64_t getGamesPlayed() const noexcept { return this->game; }
+
+    /// @brief Gets the work counters of the game (games, rounds, actions, showdowns, all-in settlements and hand evaluations)
+    /// @return The counters that the game currently writes to
+    /// @exception Guarantee No-throw
+    const ProgressCounters& getProgressCounters() const noexcept { return *this->progress; }
+
+    /// @brief Lets the game count its work in other counters, e.g. counters of a ProgressReporter
+    /// @param counters The counters, only written by the thread that runs the game
+    /// @exception Guarantee No-throw
+    /// @note The counters have to outlive the game
+    void setProgressCounters(ProgressCounters& counters) noexcept { this->progress = &counters; }
+
+    /// @brief Streams a record of every game and the summary of every run to a results sink
+    /// @param resultsSink The sink or nullptr to stop streaming, the game does not take ownership
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the sink is set up for another number of players
+    /// @note The sink has to outlive the runs of the game, duplicate runs are not streamed
+    void setResultsSink(ResultsSink* resultsSink) {
+        if (resultsSink != nullptr && resultsSink->getNumPlayers() != this->config.numPlayers) {
+            PLOG_FATAL << "The results sink is set up for " << +resultsSink->getNumPlayers() << " players, the game has " << +this->config.numPlayers;
+            throw std::invalid_argument("The results sink is set up for another number of players");
+        }
+        this->resultsSink = resultsSink;
+    }
+
+    /// @brief Writes a checkpoint of the run every CheckpointWriter::getInterval() games and at the end of every run
+    /// @param checkpointWriter The writer or nullptr to stop writing checkpoints, the game does not take ownership
+    /// @exception Guarantee No-throw
+    /// @note The writer has to outlive the runs of the game, duplicate runs are not checkpointed
+    /// @note The game only serializes its state, the writer thread writes the file
+    void setCheckpointWriter(CheckpointWriter* checkpointWriter) noexcept { this->checkpointWriter = checkpointWriter; }
+
+    /// @brief Continues the next run() or runCash() from a checkpoint instead of the first game
+    /// @param path The path of the checkpoint file
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the file is not a valid checkpoint or belongs to another config
+    /// @note The results and the seed of the checkpoint are restored, so a seeded run with deterministic players has the same results as a run without interruption
+    /// @note A run which continues with players that are not deterministic logs a warning, see hasDeterministicPlayers()
+    /// @note The run throws std::invalid_argument if it is not of the mode (normal or cash game) of the checkpoint
+    /// @note A checkpoint of a finished run only restores its results, the records of the games before the checkpoint are not streamed again
+    void resume(const std::string& path);
+
+    /// @brief Stops the current run after the current game, the checkpoint of the run can be resumed later
+    /// @exception Guarantee No-throw
+    /// @note Can be called from another thread or a signal handler, a request before the run stops it before the first game
+    void requestStop() noexcept { this->stopRequested.store(true, std::memory_order_relaxed); }
+
+    /// @brief Draws the cards of every round from the hand ranges of a sampler instead of the shuffled deck
+    /// @param dealSampler The sampler or nullptr to deal from the deck again, the game does not take ownership
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the sampler is set up for another number of players
+    /// @note The seats of the sampler are the player ids, the deals follow setSeed() and the duplicate deal sequences like the deck
+    /// @note The sampler has to outlive the runs of the game
+    void setDealSampler(const DealSampler* dealSampler) {
+        if (dealSampler != nullptr && dealSampler->getNumPlayers() != this->config.numPlayers) {
+            PLOG_FATAL << "The deal sampler is set up for " << +dealSampler->getNumPlayers() << " players, the game has " << +this->config.numPlayers;
+            throw std::invalid_argument("The deal sampler is set up for another number of players");
+        }
+        this->dealSampler = dealSampler;
+    }
+
     /// @brief Frees the allocated memory for the players
     /// @exception Guarantee No-throw
-    ~Game() { delete[] this->players; }
+    ~BasicGame() { delete[] this->players; }
 
    private:
     /// @brief Gets a string with the current player info in the format: "pos:name[chips <+/-> diff]" (chips = player chips + baseChipsDiff)
-    /// @param playerPos The player position or MAX_PLAYERS for the current player
+    /// @param playerPos The player position or N for the current player
     /// @param chipsDiff The chip difference which is shown in the string or 0 for not showing
     /// @param baseChipDiff The amount of chips that is added/removed from the player´s base chips before showing the difference
     /// @return The string with the player info
@@ -41,20 +212,77 @@ class Game {
     /// @note The difference is used to show how the player´s chips changed
     /// @note If chipsDiff is 0 then the output format is: "pos:name[chips]"
     /// @see MAX_GET_PLAYER_INFO_LENGTH for the maximum length of the returned string
-    const char* getPlayerInfo(u_int8_t playerPos = MAX_PLAYERS, const int64_t chipsDiff = 0, const int64_t baseChipsDiff = 0) const noexcept;
+    const char* getPlayerInfo(u_int8_t playerPos = N, const int64_t chipsDiff = 0, const int64_t baseChipsDiff = 0) const noexcept;
 
-    /// @brief Shuffles the players, sets their positions and sets the winners array
+    /// @brief Gets the counter-based generator of a stream of the current round
+    /// @param stream What the numbers are used for
+    /// @return The generator of the coordinates of the round in duplicate mode or after setSeed(), otherwise a generator with a key from std::rand()
     /// @exception Guarantee No-throw
-    /// @note The number of wins is stored in the player objects, it is extracted once at the game start and stored in the winners array
-    /// @see Player
+    Philox getRandomStream(const RandomStream stream) const noexcept;
+
+    /// @brief Shuffles the players and maps their new positions to their player ids
+    /// @exception Guarantee No-throw
+    /// @note The statistics are indexed by the player ids, so they are not rearranged
+    /// @see Data::getPlayerId()
     void initPlayerOrder() noexcept;
 
+    /// @brief Plays one round (hand) of the current game
+    /// @return True if the game is won (only one player with chips is left)
+    /// @exception Guarantee None
+    /// @throws std::logic_error if the deck is empty
+    /// @throws std::logic_error if the player could not call a matched bet
+    /// @throws std::logic_error if the player choose an action which is not covered
+    bool playRound();
+
+    /// @brief Resets the game to an empty tournament table before the entrants are seated
+    /// @exception Guarantee No-throw
+    /// @note The first hand starts with the dealer on the first seat
+    /// @see seatPlayer()
+    void initTournamentTable() noexcept;
+
+    /// @brief Seats a player with a stack at a tournament table
+    /// @param seat The seat
+    /// @param player The player, it is swapped with the player that sat on the seat before
+    /// @param chips The stack of the player, the seat is out if it is 0
+    /// @exception Guarantee No-throw
+    /// @note The player id of a seat is the seat, so the statistics of a table belong to its seats
+    void seatPlayer(const u_int8_t seat, std::unique_ptr<BasicPlayer<N, Chips>>& player, const Chips chips) noexcept;
+
     /// @brief Starts a round by shuffling the deck, setting the dealer and the blinds and dealing the cards
     /// @exception Guarantee Basic
     /// @throws std::logic_error if the deck is empty
+    /// @throws std::logic_error if the ranges of the deal sampler leave no deal
     /// @note uses first round to determine if the dealer should be set to 0 or to the next player after the last dealer
     void startRound();
 
+    /// @brief Tops up the stacks below the starting chips and brings every player back into the game before a cash hand
+    /// @exception Guarantee No-throw
+    /// @note Also stores the stacks and the all-in EV adjustments that the result of the hand is measured against
+    void rebuy() noexcept;
+
+    /// @brief Adds the net result of the last cash hand of every player to the cash statistics and the result of the session
+    /// @exception Guarantee No-throw
+    void addCashHand() noexcept;
+
+    /// @brief Serializes the state of the run at a game boundary and hands it to the checkpoint writer
+    /// @param earlyStop The estimator of the stopping rule
+    /// @param nextGame The game that a resumed run continues with
+    /// @param finished True if the run is finished
+    /// @exception Guarantee Basic
+    void saveCheckpoint(const BasicEarlyStop<N>& earlyStop, const u_int64_t nextGame, const bool finished);
+
+    /// @brief Restores the state of the run from the checkpoint of resume()
+    /// @param earlyStop The estimator of the stopping rule
+    /// @return True if the run of the checkpoint was finished
+    /// @exception Guarantee Basic
+    /// @throws std::invalid_argument if the checkpoint is not of the mode of the current run or is damaged
+    bool restoreCheckpoint(BasicEarlyStop<N>& earlyStop);
+
+    /// @brief Serializes the settings that a checkpoint belongs to
+    /// @param checkpoint The checkpoint
+    /// @exception Guarantee Basic
+    void writeCheckpointConfig(Checkpoint& checkpoint) const;
+
     /// @brief Sets the blinds for the round by betting the small and big blind automatically
     /// @exception Guarantee No-throw
     /// @note The heads up rule is considered
@@ -88,6 +316,44 @@ class Game {
     /// @note This is used to consider the live big blind rule (blind option)
     inline bool currentPlayerBlindOption() const noexcept;
 
+    /// @brief Gets the action of the current player and measures the decision time if required
+    /// @param blindOption If true, the player has the blind option (can only call, raise or all-in)
+    /// @param equalize If true, the player has to equalize the last bet (can only call (bet), fold or all-in (not higher than last bet))
+    /// @return The Action of the player or the timeout action if the player exceeded the turn time budget
+    /// @exception Guarantee No-throw
+    /// @note The decision time is only measured if Config::measureTurnTime is set or Config::turnTimeBudget is not 0
+    /// @see Player::turn
+    /// @see getTimeoutAction()
+    Action getPlayerAction(const bool blindOption = false, const bool equalize = false) noexcept;
+
+    /// @brief Gets the action that is played for the current player if the turn time budget is exceeded
+    /// @param blindOption If true, the player has the blind option (can only call, raise or all-in)
+    /// @param equalize If true, the player has to equalize the last bet (can only call (bet), fold or all-in (not higher than last bet))
+    /// @return A legal action derived from Config::timeoutAction
+    /// @exception Guarantee No-throw
+    /// @note The blind option is always called
+    /// @note FOLD checks if possible, otherwise folds. CALL checks or calls, a player who can not afford the call goes all-in
+    Action getTimeoutAction(const bool blindOption, const bool equalize) const noexcept;
+
+    /// @brief Updates the action statistics of the current player
+    /// @param action The action that the player plays
+    /// @param callAdd The chips the player had to add to stay in the hand before the action (0 for the blind option, calling is a check)
+    /// @param chips The chips of the player before the action
+    /// @exception Guarantee No-throw
+    /// @note Has to be called once the action is known to be legal and before the next player is selected, illegal actions are not counted
+    /// @see PlayerStats
+    void countAction(const Action& action, const Chips callAdd, const Chips chips) noexcept;
+
+    /// @brief Counts the seen flop for every player that is still in the hand
+    /// @exception Guarantee No-throw
+    /// @see PlayerStats
+    void countSawFlop() noexcept;
+
+    /// @brief Logs the decision time statistics of all players
+    /// @exception Guarantee No-throw
+    /// @note Only logs if the decision times were measured
+    void logTurnTimeStats() const noexcept;
+
     /// @brief Simulates a single non out player turn
     /// @param firstChecker The first player who checked in this bet round
     /// @return An OutEnum which indicates if the game or round should continue
@@ -127,7 +393,7 @@ class Game {
     /// @return Actual bet amount
     /// @exception Guarantee No-throw
     /// @note If the player cannot bet the blind amount, he is all-in (therefore the actual bet amount is returned)
-    u_int64_t betBlind(const u_int64_t blind) noexcept;
+    Chips betBlind(const Chips blind) noexcept;
 
     /// @brief The current player bets the amount
     /// @param amount The total amount that the player bets
@@ -221,6 +487,17 @@ class Game {
     /// @see distributePotNoAllIn() for the no all-in case
     bool distributePotAllIn() noexcept;
 
+    /** @brief Credits the expected pot shares of the remaining runouts to the all-in EV statistics
+     * @param contenders The positions of the players that are still in the round
+     * @param numContenders The number of contenders
+     * @param playerChipsBefore The chips of the players before the pots were distributed
+     * @exception Guarantee No-throw
+     * @note All runouts are enumerated if there are at most Config::allInEVSamples, otherwise Config::allInEVSamples runouts are sampled
+     * @note The pots are split like in distributePotAllIn(), but without rounding
+     * @see GameData::allInEVAdjustment
+     */
+    void creditAllInEV(const u_int8_t contenders[], const u_int8_t numContenders, const Chips playerChipsBefore[]) noexcept;
+
     /// @brief Handles the players who lost all their chips
     /// @param winners The winners array which holds at least one winner at index 0
     /// @return True if the game ends after the pot distribution
@@ -240,24 +517,34 @@ class Game {
     /// @brief The Config object which holds all settings for the simulation
     /// @note This is passed to the constructor
     /// @see Config
-    const Config config;
+    const BasicConfig<N, Chips> config;
 
     /// @brief The players array which holds all players for the simulation
     /// @note This is allocated in the constructor on the heap because the Player object is abstract
     /// @see Player
-    std::unique_ptr<Player>* players;
+    std::unique_ptr<BasicPlayer<N, Chips>>* players;
 
     /// @brief The Data object which holds all data and results of the simulation
     /// @see Data
-    Data data;
+    BasicData<N, Chips> data;
 
     /// @brief The Deck object which holds all cards for the simulation
     /// @note This is initialized every round
     /// @see Deck
     Deck deck;
 
+    /// @brief The decision time statistics of each player
+    /// @note Indexed by the player id, see Data::getPlayerId()
+    /// @see TurnTimeStats
+    TurnTimeStats turnTimeStats[N];
+
+    /// @brief The hand results of each player in cash games
+    /// @note Indexed by the player id, see Data::getPlayerId()
+    /// @see CashStats
+    CashStats cashStats[N];
+
     /// @brief The string that is constructed to show the pot winner(s) of the round
-    char winnerString[MAX_POT_DIST_STRING_LENGTH];
+    char winnerString[MAX_POT_DIST_STRING_LENGTH_PER_PLAYER * N];
 
     /// @brief The game counter
     u_int64_t game;
@@ -265,6 +552,79 @@ class Game {
     /// @brief The round counter
     int16_t round;
 
-    /// @brief Position of the last player that raised or MAX_PLAYERS if no player raised yet
-    u_int8_t lastRaiser = MAX_PLAYERS;
+    /// @brief Position of the last player that raised or N if no player raised yet
+    u_int8_t lastRaiser = N;
+
+    /// @brief The number of community cards that were dealt when the betting stopped because of all-ins
+    /// @note 5 if the betting was not stopped before the river, no runout has to be evaluated then
+    u_int8_t knownCommunityCards = 5;
+
+    /// @brief The work counters of the game if no other counters are set
+    ProgressCounters ownProgress;
+
+    /// @brief The counters that the game writes to
+    ProgressCounters* progress = &this->ownProgress;
+
+    /// @brief The sink that the game records are streamed to or nullptr
+    ResultsSink* resultsSink = nullptr;
+
+    /// @brief The writer of the checkpoints or nullptr
+    CheckpointWriter* checkpointWriter = nullptr;
+
+    /// @brief The checkpoint that is serialized, it reuses the memory of the older checkpoints
+    Checkpoint checkpoint;
+
+    /// @brief The checkpoint that the next run continues from, empty if the next run starts from the first game
+    Checkpoint resumeCheckpoint;
+
+    /// @brief Set by requestStop(), the run stops before the next game
+    std::atomic<bool> stopRequested{false};
+
+    /// @brief True while runDuplicate() is running
+    bool duplicate = false;
+
+    /// @brief True while runCash() is running
+    bool cash = false;
+
+    /// @brief True while the game is a tournament table (see initTournamentTable())
+    bool tournament = false;
+
+    /// @brief The small blind of the current tournament hand
+    Chips tournamentSmallBlind = 0;
+
+    /// @brief The big blind ante of the current tournament hand or 0
+    Chips ante = 0;
+
+    /// @brief The number of hands of a cash game
+    int16_t cashHands = 0;
+
+    /// @brief The stacks at the start of the current cash hand by position (after the rebuys)
+    Chips cashHandChips[N]{};
+
+    /// @brief The all-in EV adjustments at the start of the current cash hand by player id
+    double cashHandAdjustment[N]{};
+
+    /// @brief The net chips of the current cash game by player id (without the rebuys)
+    int64_t cashSessionResult[N]{};
+
+    /// @brief The seed of the deal sequence in duplicate mode
+    u_int64_t dealSeed = 0;
+
+    /// @brief The sampler of the deals or nullptr to deal from the deck
+    const DealSampler* dealSampler = nullptr;
+
+    /// @brief Whether setSeed() was called
+    bool seeded = false;
+
+    /// @brief The seed of the games set by setSeed()
+    u_int64_t seed = 0;
+
+    /// @brief The index of the first game set by setSeed()
+    u_int64_t firstGame = 0;
+
+    /// @brief seatOrder[i] is the id of the player on position i in duplicate mode
+    u_int8_t seatOrder[N]{};
 };
+
+/// @brief The game of the default table (MAX_PLAYERS seats, 64 bit chips)
+using Game = BasicGame<MAX_PLAYERS, u_int64_t>;
@@ -0,0 +1,128 @@
+#pragma once
+#include <vector>
+
+#include "config.h"
+
+/// @brief Keeps the debug log of only some hands: one of every N hands of a thread and the hands with a HandLogTrigger
+/// @note The log is only filtered if a sample rate or a trigger is set, otherwise every hand is logged like before
+/// @note The sampled hands are logged as they are played, the other hands are captured by HandLogAppender and their debug records are only written if a trigger fired until the end of the hand
+/// @note The debug records of the game use POKER_HAND_LOG, so the records of a silent hand are not even formatted
+/// @see HandLogScope
+class HandLog {
+   public:
+    /// @brief Sets how many hands are logged, one of every rate hands of a thread
+    /// @param rate The sample rate (0 only logs the hands with a trigger)
+    /// @exception Guarantee No-throw
+    /// @note Call it before the simulation threads are started
+    static void setSampleRate(const u_int32_t rate) noexcept;
+
+    /// @brief Adds a trigger that keeps the log of a hand
+    /// @param trigger The trigger
+    /// @exception Guarantee No-throw
+    /// @note Call it before the simulation threads are started
+    static void addTrigger(const HandLogTrigger trigger) noexcept;
+
+    /// @brief Parses a hand log spec: comma separated triggers (allin, split, illegal) and at most one sample rate
+    /// @param spec The spec, e.g. "1000,allin,illegal"
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if a part of the spec is neither a trigger nor a number
+    static void configure(const std::string& spec);
+
+    /// @brief Logs every hand again and removes the triggers
+    /// @exception Guarantee No-throw
+    static void reset() noexcept;
+
+    /// @brief Checks if the hands are filtered
+    /// @return True if a sample rate or a trigger is set
+    /// @exception Guarantee No-throw
+    static bool isActive() noexcept { return HandLog::active; }
+
+    /// @brief Checks if the debug records of the calling thread are logged (or captured) right now
+    /// @return True if the log is not filtered or the current hand is sampled or captured
+    /// @exception Guarantee No-throw
+    static bool isDetailed() noexcept { return !HandLog::active || HandLog::detailed; }
+
+    /// @brief Checks if the records of the calling thread are captured until the end of the hand
+    /// @return True if the current hand is not sampled but could be kept by a trigger
+    /// @exception Guarantee No-throw
+    static bool isCapturing() noexcept { return HandLog::capturing; }
+
+    /// @brief Starts a hand of the calling thread and decides if it is sampled or captured
+    /// @exception Guarantee No-throw
+    static void beginHand() noexcept;
+
+    /// @brief Marks the current hand of the calling thread, its log is kept if the trigger is set
+    /// @param trigger The event of the hand
+    /// @exception Guarantee No-throw
+    static void fire(const HandLogTrigger trigger) noexcept;
+
+    /// @brief Ends the hand of the calling thread and writes its captured records if a trigger fired
+    /// @exception Guarantee No-throw
+    /// @note The captured warnings and infos are always written, the kept records get the time of the end of the hand
+    static void endHand() noexcept;
+
+    /// @brief Gets the number of hands whose debug log was kept
+    /// @return The number of sampled and triggered hands of all threads
+    /// @exception Guarantee No-throw
+    static u_int64_t getLoggedHands() noexcept;
+
+   private:
+    friend class HandLogAppender;
+
+    /// @brief Captures a record of the calling thread until the end of the hand
+    /// @param record The record
+    /// @exception Guarantee No-throw
+    static void capture(const plog::Record& record) noexcept;
+
+    /// @brief Whether the log is filtered (set before the simulation threads start)
+    static bool active;
+    /// @brief Whether the debug records of the thread pass the filter
+    static thread_local bool detailed;
+    /// @brief Whether the records of the thread are captured
+    static thread_local bool capturing;
+};
+
+/// @brief Starts a hand for the hand log and ends it when the scope is left
+class HandLogScope {
+   public:
+    /// @brief Starts the hand
+    /// @exception Guarantee No-throw
+    HandLogScope() noexcept {
+        if (HandLog::isActive()) HandLog::beginHand();
+    }
+
+    HandLogScope(const HandLogScope&) = delete;
+    HandLogScope& operator=(const HandLogScope&) = delete;
+
+    /// @brief Ends the hand
+    /// @exception Guarantee No-throw
+    ~HandLogScope() {
+        if (HandLog::isActive()) HandLog::endHand();
+    }
+};
+
+/// @brief The appender that filters the records for the hand log and passes them to other appenders
+/// @note The debug and verbose records are dropped outside of the logged hands, the records of a captured hand go to HandLog
+class HandLogAppender : public plog::IAppender {
+   public:
+    /// @brief Adds an appender that the records are passed to
+    /// @param appender The appender, has to outlive the hand log appender
+    /// @return The hand log appender
+    /// @exception Guarantee Strong
+    HandLogAppender& addAppender(plog::IAppender* appender) {
+        this->appenders.push_back(appender);
+        return *this;
+    }
+
+    /// @brief Filters or captures a record
+    /// @param record The record
+    /// @exception Guarantee No-throw
+    void write(const plog::Record& record) noexcept override;
+
+   private:
+    /// @brief The appenders that the records are passed to
+    std::vector<plog::IAppender*> appenders;
+};
+
+/// @brief Logs a debug detail of the current hand, the record is only formatted if the hand is logged (see HandLog)
+#define POKER_HAND_LOG PLOG_DEBUG_IF(HandLog::isDetailed())
@@ -39,7 +39,8 @@ class HandStrengths {
     /// @note Players who are not active are ignored
     /// @see Data
     /// @see Player
-    static constexpr void getHandStrengths(const std::unique_ptr<Player> players[], const Data& data, HandStrengths result[]) noexcept {
+    template <u_int8_t N, typename Chips>
+    static constexpr void getHandStrengths(const std::unique_ptr<BasicPlayer<N, Chips>> players[], const BasicData<N, Chips>& data, HandStrengths result[]) noexcept {
         for (u_int8_t i = 0; i < data.numPlayers; i++) {
             if (!(data.roundData.playerFolded[i] || data.gameData.playerOut[i])) {
                 // only calculate hand strength if player is still in the game
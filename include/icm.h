@@ -0,0 +1,104 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "data_structs.h"
+#include "philox.h"
+
+/// @brief Computes the Independent Chip Model (ICM) equities of the stacks of a tournament
+/// @note A player finishes first with the probability stack / total chips, the following places are distributed in the same way among the players that are left (Malmuth-Harville)
+/// @note Up to MAX_PLAYERS players with chips the equities are exact: a dynamic program over the subsets of the players that took the paid places
+/// @note Bigger fields are estimated by sampling finish orders: every player draws an exponential time with the stack as rate, the fastest players take the places
+/// @note The equities of the last stacks are cached, so a bot can ask for them in every decision, the calculator is not thread safe
+class IcmCalculator {
+   public:
+    /// @brief Creates an ICM calculator
+    /// @param payouts payouts[k] is the prize of place k + 1, the places after the payouts get nothing
+    /// @param samples The number of sampled finish orders of a field of more than MAX_PLAYERS players
+    /// @param seed The seed of the sampled finish orders, the same stacks always get the same estimate
+    /// @param cacheSize The maximum number of cached stack vectors, the cache is cleared when it is full (0 disables the cache)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if a payout is negative or not finite or the number of samples is 0
+    IcmCalculator(const std::vector<double>& payouts, const u_int32_t samples = 100000, const u_int64_t seed = 0, const u_int32_t cacheSize = 4096);
+
+    /// @brief Gets the ICM equities of the stacks
+    /// @param stacks The stacks, a stack of 0 is a busted player that is not part of the field
+    /// @return The equity of every stack (0 for the busted players), valid until the next call
+    /// @exception Guarantee Strong
+    /// @note The sum of the equities is the sum of the payouts of the places that the players with chips can take
+    const std::vector<double>& getEquities(const std::vector<u_int64_t>& stacks);
+
+    /// @brief Gets the ICM equities of the stacks of a table
+    /// @tparam N The number of seats at the table
+    /// @tparam Chips The unsigned integer type that stores chip amounts
+    /// @param data The data of the table
+    /// @return The equity of every position of the table (0 for the players that are out), valid until the next call
+    /// @exception Guarantee Strong
+    template <u_int8_t N, typename Chips>
+    const std::vector<double>& getEquities(const BasicData<N, Chips>& data) {
+        this->stacks.assign(data.gameData.playerChips, data.gameData.playerChips + data.numPlayers);
+        return this->getEquities(this->stacks);
+    }
+
+    /// @brief Computes the exact ICM equities
+    /// @param stacks The stacks of at most MAX_PLAYERS players, a stack of 0 is a busted player
+    /// @param numPlayers The number of stacks
+    /// @param payouts The prizes of the places
+    /// @param equities The equity of every stack
+    /// @exception Guarantee No-throw
+    /// @note prob[placed] is the probability that the players of the subset placed took the first places, it is pushed to the subsets with one more player
+    static void computeExact(const u_int64_t stacks[], const u_int8_t numPlayers, const std::vector<double>& payouts, double equities[]) noexcept;
+
+    /// @brief Estimates the ICM equities by sampling finish orders
+    /// @param stacks The stacks, a stack of 0 is a busted player
+    /// @param numPlayers The number of stacks
+    /// @param payouts The prizes of the places
+    /// @param samples The number of sampled finish orders
+    /// @param seed The seed of the finish orders
+    /// @param equities The equity of every stack
+    /// @exception Guarantee Strong
+    static void computeMonteCarlo(const u_int64_t stacks[], const u_int32_t numPlayers, const std::vector<double>& payouts, const u_int32_t samples, const u_int64_t seed, double equities[]);
+
+    /// @brief Gets the number of calls that were answered from the cache
+    /// @return The number of cache hits
+    /// @exception Guarantee No-throw
+    u_int64_t getCacheHits() const noexcept { return this->cacheHits; }
+
+    /// @brief Gets the number of calls that computed the equities
+    /// @return The number of cache misses
+    /// @exception Guarantee No-throw
+    u_int64_t getCacheMisses() const noexcept { return this->cacheMisses; }
+
+   private:
+    /// @brief Hashes a stack vector (FNV-1a over the stacks)
+    struct StacksHash {
+        /// @brief Hashes the stacks
+        /// @param stacks The stacks
+        /// @return The hash
+        /// @exception Guarantee No-throw
+        size_t operator()(const std::vector<u_int64_t>& stacks) const noexcept {
+            u_int64_t hash = 14695981039346656037ULL;
+            for (const u_int64_t stack : stacks) hash = (hash ^ stack) * 1099511628211ULL;
+            return hash;
+        }
+    };
+
+    /// @brief The prizes of the places
+    const std::vector<double> payouts;
+    /// @brief The number of sampled finish orders of a big field
+    const u_int32_t samples;
+    /// @brief The seed of the sampled finish orders
+    const u_int64_t seed;
+    /// @brief The maximum number of cached stack vectors
+    const u_int32_t cacheSize;
+    /// @brief The equities of the last stack vectors
+    std::unordered_map<std::vector<u_int64_t>, std::vector<double>, StacksHash> cache;
+    /// @brief The equities of the last call if the cache is disabled
+    std::vector<double> equities;
+    /// @brief The stacks of the last table, reused to avoid an allocation per call
+    std::vector<u_int64_t> stacks;
+    /// @brief The number of cache hits
+    u_int64_t cacheHits = 0;
+    /// @brief The number of cache misses
+    u_int64_t cacheMisses = 0;
+};
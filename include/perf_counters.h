@@ -0,0 +1,98 @@
+#pragma once
+#include "config.h"
+
+/// @brief The values of the hardware performance counters
+/// @note A value is scaled up if the kernel had to multiplex the counter (more counters than the CPU has)
+struct PerfValues {
+    /// @brief The retired instructions
+    u_int64_t instructions;
+    /// @brief The CPU cycles
+    u_int64_t cycles;
+    /// @brief The retired branch instructions
+    u_int64_t branches;
+    /// @brief The mispredicted branch instructions
+    u_int64_t branchMisses;
+    /// @brief The L1 data cache read misses
+    u_int64_t l1dMisses;
+    /// @brief The last level cache misses
+    u_int64_t llcMisses;
+};
+
+/// @brief Counts hardware events of the calling thread with the Linux perf_event_open system call
+/// @note Only user space is counted, the counters are stopped until start() is called and accumulate over every start() and stop()
+/// @note A counter that the CPU, the kernel or the permissions (perf_event_paranoid) do not allow is unavailable and stays 0, on other systems all are unavailable
+/// @note start() and stop() are system calls, measure phases of at least a few microseconds
+class PerfCounters {
+   public:
+    /// @brief The number of counted events
+    static constexpr u_int8_t NUM_EVENTS = 6;
+
+    /// @brief Opens the counters of the calling thread
+    /// @param inheritThreads Whether the threads that are started later are counted as well (their counts are added when they are finished)
+    /// @exception Guarantee No-throw
+    explicit PerfCounters(const bool inheritThreads = false) noexcept;
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// @brief Closes the counters
+    /// @exception Guarantee No-throw
+    ~PerfCounters();
+
+    /// @brief Checks if any counter is available
+    /// @return True if at least one counter could be opened
+    /// @exception Guarantee No-throw
+    bool isAvailable() const noexcept;
+
+    /// @brief Starts counting
+    /// @exception Guarantee No-throw
+    void start() noexcept;
+
+    /// @brief Stops counting, the values are kept
+    /// @exception Guarantee No-throw
+    void stop() noexcept;
+
+    /// @brief Sets all counters to 0
+    /// @exception Guarantee No-throw
+    void reset() noexcept;
+
+    /// @brief Reads the counters
+    /// @return The values, 0 for unavailable counters
+    /// @exception Guarantee No-throw
+    PerfValues read() const noexcept;
+
+    /// @brief Logs the values per unit of work with the IPC and the branch miss rate
+    /// @param phase The name of the measured phase
+    /// @param units The number of units of work in the phase (e.g. evaluated hands)
+    /// @param unitName The name of a unit (e.g. "hand")
+    /// @exception Guarantee No-throw
+    void logReport(const char* phase, const u_int64_t units, const char* unitName) const noexcept;
+
+   private:
+    /// @brief The file descriptors of the counters in the order of PerfValues, -1 if a counter is unavailable
+    int fds[NUM_EVENTS];
+};
+
+/// @brief Counts the rest of the enclosing scope with perf counters
+class PerfScope {
+   public:
+    /// @brief Starts the counters
+    /// @param counters The counters, nullptr to count nothing
+    /// @exception Guarantee No-throw
+    explicit PerfScope(PerfCounters* counters) noexcept : counters(counters) {
+        if (this->counters != nullptr) this->counters->start();
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+    /// @brief Stops the counters
+    /// @exception Guarantee No-throw
+    ~PerfScope() {
+        if (this->counters != nullptr) this->counters->stop();
+    }
+
+   private:
+    /// @brief The counters or nullptr
+    PerfCounters* const counters;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+
+#include "config.h"
+
+/// @brief Counter-based random number generator (Philox4x32-10, Salmon et al. "Parallel random numbers: as easy as 1, 2, 3")
+/// @note Every block of four numbers is a pure function of the key (the seed) and the counter (the coordinates of the numbers), so any game or round can be generated without the ones before it
+/// @note The counter is made of the game, the round, the RandomStream and the index of the block, therefore the deck of a round, the player order of a game and the all-in EV runouts are independent
+class Philox {
+   public:
+    /// @brief A counter or a block of random numbers
+    using Block = std::array<u_int32_t, 4>;
+    /// @brief A key
+    using Key = std::array<u_int32_t, 2>;
+
+    /// @brief Generates the block of a counter
+    /// @param counter The counter
+    /// @param key The key
+    /// @return The four random numbers of the counter
+    /// @exception Guarantee No-throw
+    static constexpr Block generate(Block counter, Key key) noexcept {
+        for (u_int8_t i = 0; i < PHILOX_ROUNDS; i++) {
+            const u_int64_t product0 = (u_int64_t)PHILOX_M0 * counter[0];
+            const u_int64_t product1 = (u_int64_t)PHILOX_M1 * counter[2];
+            counter = Block{(u_int32_t)(product1 >> 32) ^ counter[1] ^ key[0], (u_int32_t)product1, (u_int32_t)(product0 >> 32) ^ counter[3] ^ key[1], (u_int32_t)product0};
+            key[0] += PHILOX_W0;
+            key[1] += PHILOX_W1;
+        }
+        return counter;
+    }
+
+    /// @brief Creates the generator of a stream of a round
+    /// @param seed The seed (the key)
+    /// @param game The index of the game
+    /// @param round The index of the round in the game (less than 2^24)
+    /// @param stream What the numbers are used for
+    /// @exception Guarantee No-throw
+    constexpr Philox(const u_int64_t seed, const u_int64_t game, const u_int32_t round, const RandomStream stream) noexcept
+        : key{(u_int32_t)seed, (u_int32_t)(seed >> 32)}, counter{0, (round & 0xFFFFFF) | (u_int32_t)stream << 24, (u_int32_t)game, (u_int32_t)(game >> 32)} {}
+
+    /// @brief Gets the next random number
+    /// @return A uniformly distributed 32 bit number
+    /// @exception Guarantee No-throw
+    constexpr u_int32_t next() noexcept {
+        if (this->used == 4) {
+            this->block = Philox::generate(this->counter, this->key);
+            this->counter[0]++;
+            this->used = 0;
+        }
+        return this->block[this->used++];
+    }
+
+    /// @brief Gets the next 64 bit random number
+    /// @return A uniformly distributed 64 bit number
+    /// @exception Guarantee No-throw
+    /// @note The high half is the first number, the order of the two calls is fixed so every compiler gives the same sequence
+    constexpr u_int64_t next64() noexcept {
+        const u_int64_t high = this->next();
+        return high << 32 | this->next();
+    }
+
+    /// @brief Gets a random number below a bound without modulo bias (Lemire's multiply and reject)
+    /// @param bound The exclusive upper bound, greater than 0
+    /// @return A uniformly distributed number from 0 to bound - 1
+    /// @exception Guarantee No-throw
+    constexpr u_int32_t uniform(const u_int32_t bound) noexcept {
+        u_int64_t product = (u_int64_t)this->next() * bound;
+        if ((u_int32_t)product < bound) {
+            // reject the products of the numbers that would be mapped more often
+            const u_int32_t threshold = -bound % bound;
+            while ((u_int32_t)product < threshold) product = (u_int64_t)this->next() * bound;
+        }
+        return product >> 32;
+    }
+
+   private:
+    /// @brief The key (the seed)
+    Key key;
+    /// @brief The counter of the next block, counter[0] is the index of the block
+    Block counter;
+    /// @brief The current block
+    Block block{};
+    /// @brief The number of used numbers of the current block
+    u_int8_t used = 4;
+};
@@ -2,12 +2,16 @@
 #include "data_structs.h"
 
 /// @brief Player class contains functionalities for a player in the game
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
 /// @note Player is an abstract class
-class Player {
+/// @see Player for the default table
+template <u_int8_t N, typename Chips>
+class BasicPlayer {
    public:
     /// @brief Default constructor
     /// @exception Guarantee No-throw
-    constexpr Player() noexcept = default;
+    constexpr BasicPlayer() noexcept = default;
 
     /// @brief Gets the name of the player
     /// @return The name of the player in the format: "<playerPosNum>:<name>"
@@ -18,9 +22,9 @@ class Player {
     /// @brief Sets the playerPosNum of the player
     /// @param num The playerPosNum of the player
     /// @exception Guarantee Strong
-    /// @throws std::invalid_argument If the number is too high (>= MAX_PLAYERS)
+    /// @throws std::invalid_argument If the number is too high (>= N)
     void setPlayerPosNum(const u_int8_t num) {
-        if (num >= MAX_PLAYERS) {
+        if (num >= N) {
             PLOG_FATAL << "Player position number too high";
             throw std::invalid_argument("Player position number too high");
         }
@@ -32,6 +36,24 @@ class Player {
     /// @exception Guarantee No-throw
     constexpr u_int8_t getPlayerPosNum() const noexcept { return this->playerPosNum; };
 
+    /// @brief Sets the stable id of the player
+    /// @param id The id of the player (its position at the start of the game set)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument If the id is too high (>= N)
+    /// @note Unlike the playerPosNum the id does not change if the players are shuffled
+    void setPlayerId(const u_int8_t id) {
+        if (id >= N) {
+            PLOG_FATAL << "Player id too high";
+            throw std::invalid_argument("Player id too high");
+        }
+        this->playerId = id;
+    };
+
+    /// @brief Gets the stable id of the player
+    /// @return The id of the player
+    /// @exception Guarantee No-throw
+    constexpr u_int8_t getPlayerId() const noexcept { return this->playerId; };
+
     /// @brief Sets the hand of the player
     /// @param card1 First card
     /// @param card2 Second card
@@ -53,10 +75,17 @@ class Player {
     /// @note This method should be implemented by the child classes
     /// @see Data
     /// @see Action
-    virtual Action turn(const Data& data, const bool blindOption = false, const bool equalize = false) const noexcept = 0;
+    virtual Action turn(const BasicData<N, Chips>& data, const bool blindOption = false, const bool equalize = false) const noexcept = 0;
+
+    /// @brief Checks if the decisions of the player only depend on the data of the turn and the hand
+    /// @return True if the player decides the same in the same situation, false if it draws random numbers or keeps a state between the turns
+    /// @exception Guarantee No-throw
+    /// @note Only players with reproducible decisions play a resumed run like a run without interruption
+    /// @see BasicGame::hasDeterministicPlayers()
+    virtual bool isDeterministic() const noexcept { return false; }
 
     /// @brief Default destructor
-    virtual ~Player() noexcept = default;
+    virtual ~BasicPlayer() noexcept = default;
 
    protected:
     /// @brief Player constructor with player name
@@ -64,7 +93,7 @@ class Player {
     /// @exception Guarantee Strong
     /// @throws std::invalid_argument If the name is too long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the name
-    Player(const char* name);
+    BasicPlayer(const char* name);
 
     /// @brief Creates a player name with the player number and name
     /// @param name A name for the player
@@ -87,4 +116,10 @@ class Player {
 
     /// @brief Player table position number
     u_int8_t playerPosNum = 0;
-};
\ No newline at end of file
+
+    /// @brief Stable player id, index of the player statistics
+    u_int8_t playerId = 0;
+};
+
+/// @brief The player of the default table
+using Player = BasicPlayer<MAX_PLAYERS, u_int64_t>;
@@ -1,14 +1,18 @@
 #pragma once
 
-#include "config.h"
+#include "seat_mask.h"
 
 /// @brief Pot class contains functionalities for a pot in the game
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
 /// @note There are multiple pots in the game (main pot, side pots)
-class Pot {
+/// @see Pot for the default table
+template <u_int8_t N, typename Chips>
+class BasicPot {
    public:
     /// @brief Default constructor
     /// @exception Guarantee No-throw
-    constexpr Pot() noexcept { this->reset(); };
+    constexpr BasicPot() noexcept { this->reset(); };
 
     /// @brief Reset method allows reuse of the pot object by being performant
     /// @exception Guarantee No-throw
@@ -16,7 +20,7 @@ class Pot {
     constexpr void reset() noexcept {
         this->potValue = 0;
         this->potCap = 0;
-        std::memset(this->nonContenders, 0, sizeof(this->nonContenders));
+        this->nonContenders.clear();
     };
 
     /// @brief Checks if the pot is capped
@@ -27,7 +31,12 @@ class Pot {
     /// @brief Sets the cap of the pot
     /// @param cap The cap of the pot
     /// @exception Guarantee No-throw
-    constexpr void setCap(const u_int64_t cap) noexcept { this->potCap = cap; };
+    constexpr void setCap(const Chips cap) noexcept { this->potCap = cap; };
+
+    /// @brief Gets the cap of the pot
+    /// @return The cap of the pot (0 if there is none)
+    /// @exception Guarantee No-throw
+    constexpr Chips getCap() const noexcept { return this->potCap; };
 
     /// @brief Adds chips to the pot up to the cap if there is one
     /// @param previousBet The bet that was made before the current one (from the same player)
@@ -36,7 +45,7 @@ class Pot {
     /// @exception Guarantee No-throw
     /// @note If the pot is capped, the chips are added up to the cap and the rest is returned
     /// @note If the pot is not capped, the chips are added to the pot and 0 is returned
-    constexpr u_int64_t addChips(const u_int64_t wholeBet, const u_int64_t previousBet = 0) noexcept {
+    constexpr Chips addChips(const Chips wholeBet, const Chips previousBet = 0) noexcept {
         // pot is not capped or the bet is smaller than the cap
         if (this->potCap == 0 || (wholeBet <= this->potCap))
             this->potValue += wholeBet - previousBet;
@@ -48,15 +57,21 @@ class Pot {
         return 0;
     };
 
+    /// @brief Adds dead money that is not part of any bet to the pot, ignoring the cap
+    /// @param chips The chips to add
+    /// @exception Guarantee No-throw
+    /// @note The chips are not matched by the other players, so they have to be added to the main pot that every player in the hand contends for
+    constexpr void addDeadChips(const Chips chips) noexcept { this->potValue += chips; };
+
     /// @brief Gets the pot value
     /// @return The pot value
     /// @exception Guarantee No-throw
-    constexpr u_int64_t getPotValue() const noexcept { return this->potValue; };
+    constexpr Chips getPotValue() const noexcept { return this->potValue; };
 
     /// @brief Adds a player to the non-contenders array
     /// @param playerPos The playerPos of the player to be added
     /// @exception Guarantee No-throw
-    constexpr void addNonContender(const u_int8_t playerPos) noexcept { this->nonContenders[playerPos] = true; };
+    constexpr void addNonContender(const u_int8_t playerPos) noexcept { this->nonContenders.set(playerPos); };
 
     /// @brief Checks if the player is a contender
     /// @param playerPos The playerPos of the player to be checked
@@ -64,15 +79,33 @@ class Pot {
     /// @exception Guarantee No-throw
     constexpr bool isContender(const u_int8_t playerPos) const noexcept { return !this->nonContenders[playerPos]; };
 
+    /// @brief Splits the pot at a lower cap, the chips above the new cap are moved to the returned pot
+    /// @param cap The new cap of this pot (has to be lower than the current cap if the pot is capped)
+    /// @param overflow The sum of all bet parts above the new cap
+    /// @return The pot above the new cap, it keeps the non-contenders and gets the remaining cap (0 if this pot was not capped)
+    /// @exception Guarantee No-throw
+    /// @note Used when a player goes all-in with less than the cap of the pot
+    constexpr BasicPot split(const Chips cap, const Chips overflow) noexcept {
+        BasicPot upper = *this;
+        upper.potValue = overflow;
+        upper.potCap = this->potCap == 0 ? 0 : this->potCap - cap;
+        this->potValue -= overflow;
+        this->potCap = cap;
+        return upper;
+    };
+
    private:
     /// @brief The amount of chips in the pot
-    u_int64_t potValue{};
+    Chips potValue{};
     /// @brief Pot cap (0 if there is none), used to cap the bet size for each player
     /// @see addChips()
-    u_int64_t potCap{};
-    /// @brief Array of non-contenders (players who are not fighting for the pot)
+    Chips potCap{};
+    /// @brief Mask of non-contenders (players who are not fighting for the pot)
     /// @note FOLDS AND OUTS ARE NOT CONSIDERED NON-CONTENDERS
     /// @note Used for side pots where the all in player(s) are not fighting for the pot
     /// @example nonContenders[i] true if the player on position i does not fight for the pot, false otherwise
-    bool nonContenders[MAX_PLAYERS]{};
-};
\ No newline at end of file
+    BasicSeatMask<N> nonContenders{};
+};
+
+/// @brief The pot of the default table
+using Pot = BasicPot<MAX_PLAYERS, u_int64_t>;
@@ -0,0 +1,145 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "config.h"
+
+/// @brief A counter that is only written by one thread and read by the progress reporter
+/// @note The owning thread adds with a relaxed load and store instead of an atomic read-modify-write, so counting costs a plain add
+class ProgressCounter {
+   public:
+    /// @brief Adds to the counter, only called by the owning thread
+    /// @param value The value to add
+    /// @exception Guarantee No-throw
+    void add(const u_int64_t value = 1) noexcept { this->value.store(this->value.load(std::memory_order_relaxed) + value, std::memory_order_relaxed); }
+
+    /// @brief Gets the value of the counter, can be called by any thread
+    /// @return The value of the counter
+    /// @exception Guarantee No-throw
+    u_int64_t get() const noexcept { return this->value.load(std::memory_order_relaxed); }
+
+   private:
+    /// @brief The value of the counter
+    std::atomic<u_int64_t> value{0};
+};
+
+/// @brief The work counters of one thread
+/// @note Aligned to a cache line, so the counters of different threads do not share cache lines
+/// @see ProgressReporter
+struct alignas(64) ProgressCounters {
+    /// @brief The number of games that were finished
+    ProgressCounter games;
+    /// @brief The number of rounds (hands) that were started
+    ProgressCounter rounds;
+    /// @brief The number of player actions
+    ProgressCounter actions;
+    /// @brief The number of rounds that ended in a showdown
+    ProgressCounter showdowns;
+    /// @brief The number of showdowns that were settled with side pots because of all-in players
+    ProgressCounter allInSettlements;
+    /// @brief The number of hand evaluations (one per hand and board)
+    ProgressCounter evaluations;
+};
+
+/// @brief Prints the progress of a long run every few seconds and writes a Prometheus text snapshot of the counters
+/// @note The reporter thread sums the counters of all watched threads, the counting threads never wait for it
+class ProgressReporter {
+   public:
+    /// @brief Creates a reporter, the reporter thread is started by start()
+    /// @param interval The time between two reports
+    /// @param totalGames The number of games of the run, used for the ETA (0 if unknown)
+    /// @param metricsPath The path of the Prometheus text file or an empty string for no file
+    /// @exception Guarantee No-throw
+    ProgressReporter(const std::chrono::milliseconds interval, const u_int64_t totalGames, const std::string& metricsPath = "") noexcept
+        : interval(interval), totalGames(totalGames), metricsPath(metricsPath) {}
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /// @brief Stops the reporter thread
+    /// @exception Guarantee No-throw
+    ~ProgressReporter() { this->stop(); }
+
+    /// @brief Adds counters of a thread to the report
+    /// @param counters The counters, they have to outlive the reporter thread
+    /// @exception Guarantee Strong
+    void watch(const ProgressCounters& counters);
+
+    /// @brief Creates counters that are owned by the reporter and adds them to the report
+    /// @return The counters for one thread
+    /// @exception Guarantee Strong
+    ProgressCounters& createCounters();
+
+    /// @brief Starts the reporter thread
+    /// @exception Guarantee Strong
+    /// @throws std::system_error if the thread could not be started
+    void start();
+
+    /// @brief Stops the reporter thread and prints a final report
+    /// @exception Guarantee No-throw
+    /// @note Calling it again has no effect
+    void stop() noexcept;
+
+    /// @brief Prints a report and writes the Prometheus file
+    /// @exception Guarantee No-throw
+    /// @note Called by the reporter thread, the rates are measured since the previous report
+    void report() noexcept;
+
+   private:
+    /// @brief The summed values of all counters
+    struct Totals {
+        /// @brief The number of finished games
+        u_int64_t games;
+        /// @brief The number of started rounds
+        u_int64_t rounds;
+        /// @brief The number of player actions
+        u_int64_t actions;
+        /// @brief The number of showdowns
+        u_int64_t showdowns;
+        /// @brief The number of all-in settlements
+        u_int64_t allInSettlements;
+        /// @brief The number of hand evaluations
+        u_int64_t evaluations;
+    };
+
+    /// @brief Sums the counters of all watched threads
+    /// @return The summed values
+    /// @exception Guarantee No-throw
+    Totals getTotals() noexcept;
+
+    /// @brief Writes the Prometheus text file (written to a temporary file and renamed, so readers never see a partial file)
+    /// @param totals The summed values
+    /// @param gamesPerSecond The games per second since the previous report
+    /// @param roundsPerSecond The rounds per second since the previous report
+    /// @param eta The estimated remaining seconds or a negative value if unknown
+    /// @exception Guarantee No-throw
+    void writeMetrics(const Totals& totals, const double gamesPerSecond, const double roundsPerSecond, const double eta) noexcept;
+
+    /// @brief The time between two reports
+    const std::chrono::milliseconds interval;
+    /// @brief The number of games of the run
+    const u_int64_t totalGames;
+    /// @brief The path of the Prometheus text file
+    const std::string metricsPath;
+    /// @brief The watched counters
+    std::deque<const ProgressCounters*> watched;
+    /// @brief The counters that are owned by the reporter (a deque keeps them in place)
+    std::deque<ProgressCounters> owned;
+    /// @brief Protects watched, owned and stopping
+    std::mutex mutex;
+    /// @brief Wakes the reporter thread if it is stopped
+    std::condition_variable stopCondition;
+    /// @brief Set by stop()
+    bool stopping = false;
+    /// @brief The totals of the previous report
+    Totals lastTotals{};
+    /// @brief The time of the previous report
+    std::chrono::steady_clock::time_point lastTime = std::chrono::steady_clock::now();
+    /// @brief The reporter thread
+    std::thread reporter;
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "config.h"
+
+/// @brief The result of one game that is streamed to a results sink
+struct GameRecord {
+    /// @brief The number of the game in the run
+    u_int64_t game;
+    /// @brief The number of rounds that were played in the game
+    u_int32_t rounds;
+    /// @brief The winners of the game, bit i is set if the player with the id i won
+    u_int32_t winners;
+    /// @brief The chips at the end of the game minus the starting chips per player id
+    int64_t chipDeltas[MAX_SEATS];
+};
+
+/// @brief The aggregated results of a run that are streamed to a results sink after the last game
+struct SummaryRecord {
+    /// @brief The number of games that were played
+    u_int64_t games;
+    /// @brief The number of game wins per player id
+    u_int32_t gameWins[MAX_SEATS];
+    /// @brief The number of round wins per player id
+    u_int32_t chipWins[MAX_SEATS];
+    /// @brief The amount of chips won per player id
+    u_int64_t chipWinsAmount[MAX_SEATS];
+    /// @brief The all-in EV adjusted amount of chips won per player id
+    double chipWinsEV[MAX_SEATS];
+};
+
+/// @brief Streams game records and summaries of a run to a file in CSV, JSON-lines or binary format
+/// @note The simulation thread only collects the records in batches of RESULTS_SINK_BATCH_SIZE, a background thread formats and writes them
+/// @note The memory is bounded by RESULTS_SINK_BATCHES batches, the simulation thread only waits for a free batch if the writer is behind by all of them
+/// @note A sink is fed by one simulation thread
+/// @see BasicGame::setResultsSink()
+class ResultsSink {
+   public:
+    /// @brief Opens the file and starts the writer thread
+    /// @param path The path of the file, an existing file is overwritten
+    /// @param format The format of the records
+    /// @param numPlayers The number of players of the runs, the number of chip deltas per record
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the number of players is invalid or the file could not be opened
+    ResultsSink(const std::string& path, const ResultsFormat format, const u_int8_t numPlayers);
+
+    ResultsSink(const ResultsSink&) = delete;
+    ResultsSink& operator=(const ResultsSink&) = delete;
+
+    /// @brief Writes the remaining records and closes the file
+    /// @exception Guarantee No-throw
+    ~ResultsSink() { this->close(); }
+
+    /// @brief Adds the record of a game
+    /// @param record The record of the game
+    /// @exception Guarantee No-throw
+    /// @note Ignored after close()
+    void addGame(const GameRecord& record) noexcept;
+
+    /// @brief Adds the summary of a run, it is written after the games that were added before
+    /// @param summary The summary of the run
+    /// @exception Guarantee No-throw
+    /// @note Ignored after close()
+    void addSummary(const SummaryRecord& summary) noexcept;
+
+    /// @brief Writes the remaining records, stops the writer thread and closes the file
+    /// @exception Guarantee No-throw
+    /// @note Blocks until all records are written, calling it again has no effect
+    void close() noexcept;
+
+    /// @brief Gets the number of players of the records
+    /// @return The number of players
+    /// @exception Guarantee No-throw
+    u_int8_t getNumPlayers() const noexcept { return this->numPlayers; }
+
+    /// @brief Gets how often the simulation thread had to wait for the writer thread
+    /// @return The number of waits for a free batch
+    /// @exception Guarantee No-throw
+    u_int64_t getStalls() const noexcept { return this->stalls; }
+
+    /// @brief Gets the format that belongs to the extension of a path (.csv, .jsonl or .bin)
+    /// @param path The path of the file
+    /// @return The format of the extension
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the extension is unknown
+    static ResultsFormat getFormat(const std::string& path);
+
+   private:
+    /// @brief Records that are handed to the writer thread at once
+    struct Batch {
+        /// @brief The game records
+        std::vector<GameRecord> games;
+        /// @brief Whether a summary follows the game records
+        bool hasSummary = false;
+        /// @brief The summary that is written after the game records
+        SummaryRecord summary;
+    };
+
+    /// @brief Hands the current batch to the writer thread and takes a free batch (waits if there is none)
+    /// @exception Guarantee No-throw
+    void handOff() noexcept;
+
+    /// @brief The loop of the writer thread, writes the batches until the sink is closed
+    /// @exception Guarantee No-throw
+    void writeBatches() noexcept;
+
+    /// @brief Writes the header of the file (CSV header line or binary magic)
+    /// @exception Guarantee No-throw
+    void writeHeader() noexcept;
+
+    /// @brief Writes a game record
+    /// @param record The game record
+    /// @exception Guarantee No-throw
+    void writeGame(const GameRecord& record) noexcept;
+
+    /// @brief Writes a summary record
+    /// @param summary The summary record
+    /// @exception Guarantee No-throw
+    void writeSummary(const SummaryRecord& summary) noexcept;
+
+    /// @brief Writes a list of values in the format of the sink (CSV columns or JSON array)
+    /// @tparam T The type of the values
+    /// @param values The values, one per player
+    /// @exception Guarantee No-throw
+    template <typename T>
+    void writeValues(const T values[]) noexcept;
+
+    /// @brief Writes a value in host byte order
+    /// @tparam T The type of the value
+    /// @param value The value
+    /// @exception Guarantee No-throw
+    template <typename T>
+    void writeBinary(const T value) noexcept {
+        this->file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /// @brief The format of the records
+    const ResultsFormat format;
+    /// @brief The number of players of the records
+    const u_int8_t numPlayers;
+    /// @brief The buffer of the file stream
+    std::unique_ptr<char[]> fileBuffer;
+    /// @brief The file, only used by the writer thread after the header
+    std::ofstream file;
+    /// @brief The storage of all batches
+    Batch batches[RESULTS_SINK_BATCHES];
+    /// @brief The batch that the simulation thread fills
+    Batch* current;
+    /// @brief The batches that wait for the writer thread (in order)
+    std::deque<Batch*> fullBatches;
+    /// @brief The batches that were written and can be filled again
+    std::vector<Batch*> freeBatches;
+    /// @brief Protects fullBatches, freeBatches and closing
+    std::mutex mutex;
+    /// @brief Wakes the writer thread if a batch is full or the sink is closed
+    std::condition_variable writerCondition;
+    /// @brief Wakes the simulation thread if a batch was written
+    std::condition_variable freeCondition;
+    /// @brief Set by close(), the writer thread stops after the last full batch
+    bool closing = false;
+    /// @brief Set after close() is finished
+    bool closed = false;
+    /// @brief How often the simulation thread had to wait for a free batch
+    u_int64_t stalls = 0;
+    /// @brief The writer thread
+    std::thread writer;
+};
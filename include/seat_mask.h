@@ -0,0 +1,86 @@
+#pragma once
+
+#include "config.h"
+
+/// @brief Bitmask with one bit per seat, used for the seat states (out, folded, all-in)
+/// @tparam N The number of seats at the table
+/// @note Bit i belongs to the player on position i
+/// @note Seat lookups are done with a rotate and count trailing zeros, counters with a popcount
+/// @see SeatMask for the default table
+template <u_int8_t N>
+class BasicSeatMask {
+    static_assert(N <= 32, "BasicSeatMask stores one bit per seat in at most 32 bits");
+
+   public:
+    /// @brief The smallest unsigned integer type that has a bit for every seat
+    using Bits = std::conditional_t<N <= 16, u_int16_t, u_int32_t>;
+
+    /// @brief Default constructor, no seat is set
+    /// @exception Guarantee No-throw
+    constexpr BasicSeatMask() noexcept = default;
+
+    /// @brief Constructor with the raw bits
+    /// @param bits The bits of the mask, bit i belongs to seat i
+    /// @exception Guarantee No-throw
+    constexpr explicit BasicSeatMask(const Bits bits) noexcept : bits(bits){};
+
+    /// @brief Checks if the seat is set
+    /// @param seat The seat to check
+    /// @return True if the seat is set
+    /// @exception Guarantee No-throw
+    constexpr bool operator[](const u_int8_t seat) const noexcept { return (this->bits >> seat) & 1; };
+
+    /// @brief Sets the seat
+    /// @param seat The seat to set
+    /// @exception Guarantee No-throw
+    constexpr void set(const u_int8_t seat) noexcept { this->bits |= (Bits)((Bits)1 << seat); };
+
+    /// @brief Resets the seat
+    /// @param seat The seat to reset
+    /// @exception Guarantee No-throw
+    constexpr void reset(const u_int8_t seat) noexcept { this->bits &= (Bits) ~((Bits)1 << seat); };
+
+    /// @brief Clears all seats
+    /// @exception Guarantee No-throw
+    constexpr void clear() noexcept { this->bits = 0; };
+
+    /// @brief Gets the raw bits of the mask
+    /// @return The bits, bit i belongs to seat i
+    /// @exception Guarantee No-throw
+    constexpr Bits getBits() const noexcept { return this->bits; };
+
+    /// @brief Gets the number of set seats
+    /// @return The number of set seats
+    /// @exception Guarantee No-throw
+    constexpr u_int8_t count() const noexcept { return __builtin_popcount(this->bits); };
+
+    /// @brief Gets the mask of all seats at a table
+    /// @param numSeats The number of seats at the table (at most N)
+    /// @return The bits of the first numSeats seats
+    /// @exception Guarantee No-throw
+    static constexpr Bits getSeats(const u_int8_t numSeats) noexcept { return (Bits)(((u_int64_t)1 << numSeats) - 1); };
+
+    /** @brief Gets the next seat of the mask after a seat in the clockwise order
+     * @param bits The seats to choose from
+     * @param seat The seat to start from (exclusive), the seat itself is only returned if it is the only set seat
+     * @param numSeats The number of seats at the table (at most N)
+     * @return The next set seat or seat itself if no seat is set
+     * @exception Guarantee No-throw
+     */
+    static constexpr u_int8_t getNextSeat(const Bits bits, const u_int8_t seat, const u_int8_t numSeats) noexcept {
+        const u_int64_t seats = bits & getSeats(numSeats);
+        if (seats == 0) return seat;
+        // rotate the mask so that the seat after seat is bit 0
+        const u_int8_t start = seat + 1 == numSeats ? 0 : seat + 1;
+        const u_int64_t rotated = ((seats >> start) | (seats << (numSeats - start))) & getSeats(numSeats);
+        const u_int8_t next = start + __builtin_ctzll(rotated);
+        return next >= numSeats ? next - numSeats : next;
+    };
+
+   private:
+    /// @brief The bits of the mask, bit i belongs to seat i
+    Bits bits{};
+};
+
+/// @brief The seat mask of the default table
+using SeatMask = BasicSeatMask<MAX_PLAYERS>;
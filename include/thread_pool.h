@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "config.h"
+
+/// @brief Runs the tasks of a parallel loop on threads that are kept alive between the loops
+/// @note The calling thread also runs tasks, so a pool of one thread does not start a thread
+/// @note The tasks are taken from an atomic counter, a fast thread takes more of them
+class ThreadPool {
+   public:
+    /// @brief Starts the threads of the pool
+    /// @param threads The number of threads including the calling thread (at least 1)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the number of threads is 0
+    /// @note If a thread could not be started the pool works with less threads
+    ThreadPool(const u_int8_t threads);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Stops and joins the threads
+    /// @exception Guarantee No-throw
+    ~ThreadPool();
+
+    /// @brief Runs a task for every index and waits until all tasks are finished
+    /// @param count The number of tasks
+    /// @param task The task, it gets the index from 0 to count - 1
+    /// @exception Guarantee Basic
+    /// @throws The first exception of a task, the other tasks are still finished
+    /// @note Not reentrant, a task must not call parallelFor() of the same pool
+    void parallelFor(const u_int32_t count, const std::function<void(const u_int32_t)>& task);
+
+    /// @brief Gets the number of threads including the calling thread
+    /// @return The number of threads
+    /// @exception Guarantee No-throw
+    u_int8_t getNumThreads() const noexcept { return this->workers.size() + 1; }
+
+   private:
+    /// @brief The loop of a worker thread, it waits for the next parallel loop and runs tasks of it
+    /// @exception Guarantee No-throw
+    void work() noexcept;
+
+    /// @brief Runs tasks of the current parallel loop until there are no tasks left
+    /// @exception Guarantee No-throw
+    /// @note The first exception of a task is stored in error
+    void runTasks() noexcept;
+
+    /// @brief The worker threads
+    std::vector<std::thread> workers;
+    /// @brief Protects the state of the current parallel loop
+    std::mutex mutex;
+    /// @brief Wakes up the workers for a new parallel loop or to stop
+    std::condition_variable start;
+    /// @brief Wakes up the calling thread when the last worker finished its tasks
+    std::condition_variable done;
+    /// @brief The task of the current parallel loop
+    const std::function<void(const u_int32_t)>* task = nullptr;
+    /// @brief The number of tasks of the current parallel loop
+    u_int32_t count = 0;
+    /// @brief The index of the next task
+    std::atomic<u_int32_t> next{0};
+    /// @brief The number of the current parallel loop, a worker joins a loop once
+    u_int64_t generation = 0;
+    /// @brief The number of workers that are still running tasks of the current parallel loop
+    u_int8_t busy = 0;
+    /// @brief True if the threads have to stop
+    bool stopping = false;
+    /// @brief The first exception of a task of the current parallel loop
+    std::exception_ptr error;
+};
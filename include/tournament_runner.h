@@ -0,0 +1,190 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+#include "game.h"
+#include "thread_pool.h"
+
+/// @brief A level of the blind schedule of a tournament
+/// @see TournamentConfig
+struct BlindLevel {
+    /// @brief The small blind, the big blind is always twice the small blind
+    u_int64_t smallBlind;
+    /// @brief The big blind ante or 0 for no ante
+    /// @note The big blind posts it once for the whole table after the big blind, only from the chips behind the big blind
+    u_int64_t ante = 0;
+    /// @brief The number of hands of the level at every table
+    u_int32_t hands = 100;
+};
+
+/// @brief Contains the settings of a tournament run
+/// @see BasicTournamentRunner
+struct TournamentConfig {
+    /// @brief The number of tournaments
+    u_int32_t numTournaments;
+    /// @brief The number of entrants of every tournament
+    u_int32_t numEntrants;
+    /// @brief The starting chips of every entrant
+    u_int64_t startingChips;
+    /// @brief The blind schedule, the blinds and the ante of the last level are doubled after every further hands of the last level
+    std::vector<BlindLevel> levels;
+    /// @brief The number of different bots, entrant e plays bot e % numBots
+    u_int8_t numBots = 5;
+    /// @brief The number of seats of a table (2 to the number of seats of the game)
+    u_int8_t tableSize = MAX_PLAYERS;
+    /// @brief The number of hands that every table plays between two synchronization points
+    /// @note The tables are broken and balanced and the level changes only at the synchronization points
+    u_int16_t syncHands = 10;
+    /// @brief The seed of the seat draws and the decks, the decks of a table are derived from it, the tournament and the table
+    u_int64_t seed = 0;
+    /// @brief The number of threads that play the tables
+    u_int8_t threads = 1;
+};
+
+/// @brief Plays multi-table tournaments and collects the distribution of the finish positions of every bot
+/// @tparam N The number of seats of a table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+/// @note The entrants are drawn to the tables, every table is a game that plays syncHands hands on the thread pool, then the tables are synchronized:
+/// @note the eliminated entrants get their finish positions, the tables that are not needed anymore are broken and the other tables are balanced
+/// @note Entrants that bust in the same synchronization interval are ordered by the hand of the table in which they busted, then by their stacks at the start of that hand
+/// @see BasicGame::playTournamentHand()
+/// @see TournamentRunner for the default table
+template <u_int8_t N, typename Chips>
+class BasicTournamentRunner {
+   public:
+    /// @brief Creates the player of the given bot
+    using PlayerFactory = std::function<std::unique_ptr<BasicPlayer<N, Chips>>(const u_int8_t bot)>;
+
+    /// @brief Creates a tournament runner
+    /// @param config The settings of the tournaments
+    /// @param playerFactory Creates the player of the given bot or nullptr for the default lineup of the game
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the settings are invalid
+    /// @note The factory is called from the thread that calls run()
+    BasicTournamentRunner(const TournamentConfig& config, const PlayerFactory& playerFactory = nullptr);
+
+    /// @brief Plays all tournaments and logs the finish positions of the bots
+    /// @exception Guarantee Basic
+    /// @throws std::logic_error if a hand could not be played (see BasicGame::run())
+    /// @note The results of a previous run are reset
+    void run();
+
+    /// @brief Gets how often a bot finished on a position
+    /// @param bot The bot
+    /// @param position The finish position (1 is the winner, numEntrants is the first eliminated entrant)
+    /// @return The number of finishes over all tournaments and entrants of the bot
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if the bot or the position is invalid
+    u_int64_t getFinishes(const u_int8_t bot, const u_int32_t position) const noexcept { return this->finishes[(u_int64_t)bot * this->config.numEntrants + position - 1]; }
+
+    /// @brief Gets the mean finish position of a bot
+    /// @param bot The bot
+    /// @return The mean finish position or 0 if the bot did not play
+    /// @exception Guarantee No-throw
+    double getMeanFinish(const u_int8_t bot) const noexcept;
+
+    /// @brief Gets the number of tournaments played in the last run
+    /// @return The number of tournaments
+    /// @exception Guarantee No-throw
+    u_int32_t getTournamentsPlayed() const noexcept { return this->tournamentsPlayed; }
+
+    /// @brief Gets the number of hands played in the last run
+    /// @return The number of hands of all tables
+    /// @exception Guarantee No-throw
+    u_int64_t getHandsPlayed() const noexcept { return this->handsPlayed; }
+
+    /// @brief Gets the blind level of the tournament clock
+    /// @param hands The number of hands that every table played
+    /// @return The level of the schedule, after the last level the last level with doubled blinds and ante
+    /// @exception Guarantee No-throw
+    BlindLevel getLevel(const u_int64_t hands) const noexcept;
+
+   private:
+    /// @brief The entrant of an empty seat
+    static constexpr u_int32_t NO_ENTRANT = UINT32_MAX;
+
+    /// @brief An entrant that busted in a synchronization interval
+    struct Bust {
+        /// @brief The hand of the interval in which the entrant busted
+        u_int16_t hand;
+        /// @brief The stack of the entrant at the start of the hand
+        Chips chips;
+        /// @brief The entrant
+        u_int32_t entrant;
+    };
+
+    /// @brief A table of a tournament
+    struct Table {
+        /// @brief The game that plays the hands of the table, the empty seats are out of the game
+        std::unique_ptr<BasicGame<N, Chips>> game;
+        /// @brief The entrant of every seat or NO_ENTRANT
+        u_int32_t entrants[N];
+        /// @brief The number of seated entrants
+        u_int8_t seated;
+        /// @brief The entrants that busted in the current synchronization interval
+        std::vector<Bust> busts;
+        /// @brief The number of hands the table played in the current synchronization interval
+        u_int16_t hands;
+    };
+
+    /// @brief Plays one tournament
+    /// @param tournament The number of the tournament
+    /// @param pool The thread pool that plays the tables
+    /// @exception Guarantee Basic
+    /// @throws std::logic_error if a hand could not be played (see BasicGame::run())
+    void runTournament(const u_int32_t tournament, ThreadPool& pool);
+
+    /// @brief Plays the hands of a table until the next synchronization point
+    /// @param table The table
+    /// @param level The blind level of the interval
+    /// @exception Guarantee Basic
+    /// @throws std::logic_error if a hand could not be played (see BasicGame::run())
+    /// @note Stops early if only one entrant is left at the table
+    void playTable(Table& table, const BlindLevel& level) const;
+
+    /// @brief Breaks the tables that are not needed anymore and moves entrants until the tables differ by at most one entrant
+    /// @param tables The tables, the broken tables are removed
+    /// @param remaining The number of entrants left in the tournament
+    /// @exception Guarantee No-throw
+    void balance(std::vector<Table>& tables, const u_int32_t remaining) const noexcept;
+
+    /// @brief Moves an entrant with its stack to an empty seat of another table
+    /// @param from The table of the entrant
+    /// @param seat The seat of the entrant
+    /// @param to The table with an empty seat
+    /// @exception Guarantee No-throw
+    void moveEntrant(Table& from, const u_int8_t seat, Table& to) const noexcept;
+
+    /// @brief Checks the settings of the tournaments and creates the config of the games of the tables
+    /// @param config The settings of the tournaments
+    /// @return The config of the games of the tables
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the settings are invalid
+    static BasicConfig<N, Chips> createTableConfig(const TournamentConfig& config);
+
+    /// @brief Creates the player of a bot
+    /// @param bot The bot
+    /// @return The player
+    /// @exception Guarantee Strong
+    std::unique_ptr<BasicPlayer<N, Chips>> createPlayer(const u_int8_t bot) const;
+
+    /// @brief Logs the finish positions of the bots
+    /// @exception Guarantee No-throw
+    void logResults() const noexcept;
+
+    /// @brief The settings of the tournaments
+    const TournamentConfig config;
+    /// @brief Creates the players or nullptr for the default lineup
+    const PlayerFactory playerFactory;
+    /// @brief The config of the games of the tables
+    const BasicConfig<N, Chips> tableConfig;
+    /// @brief finishes[bot * numEntrants + position - 1] is the number of finishes of the bot on the position
+    std::vector<u_int64_t> finishes;
+    /// @brief The number of tournaments played in the last run
+    u_int32_t tournamentsPlayed = 0;
+    /// @brief The number of hands played in the last run
+    u_int64_t handsPlayed = 0;
+};
+
+/// @brief The tournament runner of the default table
+using TournamentRunner = BasicTournamentRunner<MAX_PLAYERS, u_int64_t>;
@@ -0,0 +1,128 @@
+#pragma once
+#include <chrono>
+#include <string>
+
+#include "alloc_audit.h"
+#include "config.h"
+
+/// @brief Records the phases of sampled hands in per-thread ring buffers and exports them as a Chrome trace (Perfetto)
+/// @note The phases are only recorded if the program is compiled with POKER_TRACING (CMake option), otherwise the POKER_TRACE_* macros are empty
+/// @note POKER_TRACE_SCOPE also attributes the allocations of the phase if the program is compiled with POKER_ALLOC_AUDIT
+/// @note Every thread writes to its own ring buffer of TRACE_BUFFER_EVENTS events, the oldest events are overwritten if it is full
+/// @see TraceScope
+class Tracer {
+   public:
+    /// @brief A finished phase
+    struct Event {
+        /// @brief The name of the phase (a string literal)
+        const char* name;
+        /// @brief The start of the phase in nanoseconds since the start of the program
+        u_int64_t start;
+        /// @brief The duration of the phase in nanoseconds
+        u_int64_t duration;
+    };
+
+    /// @brief Sets how many hands are recorded, one of every rate hands of a thread
+    /// @param rate The sample rate (1 records every hand)
+    /// @exception Guarantee Strong
+    /// @throws std::invalid_argument if the rate is 0
+    static void setSampleRate(const u_int32_t rate);
+
+    /// @brief Gets the sample rate
+    /// @return One of every rate hands is recorded
+    /// @exception Guarantee No-throw
+    static u_int32_t getSampleRate() noexcept;
+
+    /// @brief Starts a hand of the calling thread and decides if its phases are recorded
+    /// @exception Guarantee No-throw
+    static void beginHand() noexcept;
+
+    /// @brief Checks if the current hand of the calling thread is recorded
+    /// @return True if the phases are recorded
+    /// @exception Guarantee No-throw
+    static bool isRecording() noexcept { return Tracer::recording; }
+
+    /// @brief Gets the current time of the trace clock
+    /// @return The nanoseconds since the start of the program
+    /// @exception Guarantee No-throw
+    static u_int64_t now() noexcept { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Tracer::epoch).count(); }
+
+    /// @brief Adds a finished phase to the ring buffer of the calling thread
+    /// @param name The name of the phase, has to outlive the tracer (a string literal)
+    /// @param start The start of the phase (now())
+    /// @param end The end of the phase (now())
+    /// @exception Guarantee No-throw
+    /// @note The first event of a thread allocates its ring buffer
+    static void record(const char* name, const u_int64_t start, const u_int64_t end) noexcept;
+
+    /// @brief Gets the number of events in the ring buffers of all threads
+    /// @return The number of events that would be exported
+    /// @exception Guarantee No-throw
+    static u_int64_t getNumEvents() noexcept;
+
+    /// @brief Writes the events of all threads as Chrome trace JSON (chrome://tracing or ui.perfetto.dev)
+    /// @param path The path of the file, an existing file is overwritten
+    /// @return True if the file was written
+    /// @exception Guarantee No-throw
+    /// @note Call it after the simulation threads are finished, the ring buffers are not locked
+    static bool writeChromeTrace(const std::string& path) noexcept;
+
+    /// @brief Logs the total time and the share of every phase of the recorded hands
+    /// @exception Guarantee No-throw
+    /// @note Nested phases are contained in their parents, the shares are relative to the time of the hands
+    static void logSummary() noexcept;
+
+    /// @brief Removes the events of all threads
+    /// @exception Guarantee No-throw
+    /// @note Call it while no simulation thread is running
+    static void clear() noexcept;
+
+   private:
+    /// @brief The start of the trace clock
+    static const std::chrono::steady_clock::time_point epoch;
+    /// @brief Whether the current hand of the thread is recorded
+    static thread_local bool recording;
+};
+
+/// @brief Records the time from its construction to its destruction as a phase if the current hand is recorded
+/// @note Use POKER_TRACE_SCOPE, so the scope is not compiled without POKER_TRACING
+class TraceScope {
+   public:
+    /// @brief Starts the phase
+    /// @param name The name of the phase (a string literal)
+    /// @exception Guarantee No-throw
+    explicit TraceScope(const char* name) noexcept : name(name), active(Tracer::isRecording()), start(this->active ? Tracer::now() : 0) {}
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    /// @brief Ends the phase and records it
+    /// @exception Guarantee No-throw
+    ~TraceScope() {
+        if (this->active) Tracer::record(this->name, this->start, Tracer::now());
+    }
+
+   private:
+    /// @brief The name of the phase
+    const char* name;
+    /// @brief Whether the phase is recorded
+    const bool active;
+    /// @brief The start of the phase
+    const u_int64_t start;
+};
+
+#define POKER_TRACE_CONCAT_(a, b) a##b
+#define POKER_TRACE_CONCAT(a, b) POKER_TRACE_CONCAT_(a, b)
+#ifdef POKER_TRACING
+/// @brief Records the rest of the enclosing scope as a phase with the given name
+#define POKER_TRACE_TIMER(name) const TraceScope POKER_TRACE_CONCAT(traceScope, __LINE__)(name)
+/// @brief Starts a hand, its phases are recorded if it is sampled
+#define POKER_TRACE_HAND() Tracer::beginHand()
+#else
+#define POKER_TRACE_TIMER(name) static_cast<void>(0)
+#define POKER_TRACE_HAND() static_cast<void>(0)
+#endif
+/// @brief Marks the rest of the enclosing scope as a phase with the given name for the trace and the allocation audit
+#define POKER_TRACE_SCOPE(name) \
+    POKER_TRACE_TIMER(name);    \
+    POKER_ALLOC_PHASE(name)
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "config.h"
+
+/// @brief Collects the decision latencies of a single player
+/// @note The latencies are stored in a power of two histogram, therefore the percentiles are approximations
+/// @note Bucket 0 holds 0ns, bucket i > 0 holds latencies in [2^(i-1), 2^i) nanoseconds, the last bucket holds everything above
+class TurnTimeStats {
+   public:
+    /// @brief Default constructor
+    /// @exception Guarantee No-throw
+    constexpr TurnTimeStats() noexcept { this->reset(); };
+
+    /// @brief Reset method allows reuse of the stats object by being performant
+    /// @exception Guarantee No-throw
+    /// @note Resets all values to their defaults
+    constexpr void reset() noexcept {
+        this->decisions = 0;
+        this->totalTime = 0;
+        this->maxTime = 0;
+        this->overruns = 0;
+        for (u_int8_t i = 0; i < TURN_TIME_HISTOGRAM_BUCKETS; i++) this->histogram[i] = 0;
+    };
+
+    /// @brief Adds the latency of one decision
+    /// @param nanoseconds The time in nanoseconds that the player needed for the decision
+    /// @exception Guarantee No-throw
+    constexpr void addTurnTime(const u_int64_t nanoseconds) noexcept {
+        this->decisions++;
+        this->totalTime += nanoseconds;
+        if (nanoseconds > this->maxTime) this->maxTime = nanoseconds;
+        this->histogram[getBucket(nanoseconds)]++;
+    };
+
+    /// @brief Counts a decision that exceeded the time budget
+    /// @exception Guarantee No-throw
+    /// @note The decision itself has to be added with addTurnTime()
+    constexpr void addOverrun() noexcept { this->overruns++; };
+
+    /// @brief Gets the number of measured decisions
+    /// @return The number of measured decisions
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getDecisions() const noexcept { return this->decisions; };
+
+    /// @brief Gets the total time of all measured decisions
+    /// @return The total time in nanoseconds
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getTotalTime() const noexcept { return this->totalTime; };
+
+    /// @brief Gets the mean time of all measured decisions
+    /// @return The mean time in nanoseconds or 0 if no decision was measured
+    /// @exception Guarantee No-throw
+    constexpr double getMeanTime() const noexcept { return this->decisions == 0 ? 0 : (double)this->totalTime / this->decisions; };
+
+    /// @brief Gets the longest measured decision
+    /// @return The maximum time in nanoseconds
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getMaxTime() const noexcept { return this->maxTime; };
+
+    /// @brief Gets the number of decisions that exceeded the time budget
+    /// @return The number of overruns
+    /// @exception Guarantee No-throw
+    constexpr u_int64_t getOverruns() const noexcept { return this->overruns; };
+
+    /// @brief Gets an upper bound for the given percentile of the decision times
+    /// @param percentile The percentile (0-1; 0.99 = p99)
+    /// @return The upper bound of the histogram bucket that contains the percentile in nanoseconds (at most the maximum time)
+    /// @exception Guarantee No-throw
+    /// @note Returns 0 if no decision was measured
+    constexpr u_int64_t getPercentile(const double percentile) const noexcept {
+        if (this->decisions == 0) return 0;
+        // the number of decisions that have to be covered by the buckets
+        const u_int64_t required = std::max<u_int64_t>(1, (u_int64_t)(percentile * this->decisions + 0.999999));
+        u_int64_t covered = 0;
+        for (u_int8_t i = 0; i < TURN_TIME_HISTOGRAM_BUCKETS; i++) {
+            covered += this->histogram[i];
+            if (covered >= required) return std::min(getBucketUpperBound(i), this->maxTime);
+        }
+        return this->maxTime;
+    };
+
+    /// @brief Gets the number of decisions in a histogram bucket
+    /// @param bucket The bucket index
+    /// @return The number of decisions in the bucket
+    /// @exception Guarantee No-throw
+    /// @note Undefined behavior if bucket >= TURN_TIME_HISTOGRAM_BUCKETS
+    constexpr u_int64_t getHistogram(const u_int8_t bucket) const noexcept { return this->histogram[bucket]; };
+
+    /// @brief Gets the histogram bucket for a decision time
+    /// @param nanoseconds The decision time in nanoseconds
+    /// @return The bucket index
+    /// @exception Guarantee No-throw
+    static constexpr u_int8_t getBucket(const u_int64_t nanoseconds) noexcept {
+        if (nanoseconds == 0) return 0;
+        // bit width of the value
+        const u_int8_t bucket = 64 - __builtin_clzll(nanoseconds);
+        return bucket < TURN_TIME_HISTOGRAM_BUCKETS ? bucket : TURN_TIME_HISTOGRAM_BUCKETS - 1;
+    };
+
+    /// @brief Gets the exclusive upper bound of a histogram bucket
+    /// @param bucket The bucket index
+    /// @return The upper bound in nanoseconds
+    /// @exception Guarantee No-throw
+    static constexpr u_int64_t getBucketUpperBound(const u_int8_t bucket) noexcept { return bucket == 0 ? 1 : (u_int64_t)1 << bucket; };
+
+   private:
+    /// @brief The number of measured decisions
+    u_int64_t decisions{};
+    /// @brief The sum of all decision times in nanoseconds
+    u_int64_t totalTime{};
+    /// @brief The longest decision time in nanoseconds
+    u_int64_t maxTime{};
+    /// @brief The number of decisions that exceeded the time budget
+    u_int64_t overruns{};
+    /// @brief The histogram of the decision times
+    /// @see getBucket()
+    u_int64_t histogram[TURN_TIME_HISTOGRAM_BUCKETS]{};
+};
@@ -0,0 +1,163 @@
+#include "alloc_audit.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+/// @brief The allocations inside a phase
+struct PhaseAllocations {
+    /// @brief The name of the phase
+    const char* name;
+    /// @brief The number of allocations while the phase was open
+    u_int64_t allocations;
+};
+
+/// @brief The allocation counts of a thread or of the finished threads
+/// @note Only fixed arrays, counting must not allocate
+struct Allocations {
+    /// @brief The number of allocations
+    u_int64_t total;
+    /// @brief The number of phases
+    u_int8_t numPhases;
+    /// @brief The allocations per phase
+    PhaseAllocations phases[ALLOC_AUDIT_MAX_PHASES];
+
+    /// @brief Adds allocations to a phase
+    /// @param name The name of the phase
+    /// @param allocations The number of allocations
+    void add(const char* name, const u_int64_t allocations) noexcept {
+        for (u_int8_t i = 0; i < this->numPhases; i++) {
+            // the same name can be different literals
+            if (this->phases[i].name == name || std::strcmp(this->phases[i].name, name) == 0) {
+                this->phases[i].allocations += allocations;
+                return;
+            }
+        }
+        if (this->numPhases < ALLOC_AUDIT_MAX_PHASES) this->phases[this->numPhases++] = PhaseAllocations{name, allocations};
+    }
+
+    /// @brief Gets the allocations of a phase
+    /// @param name The name of the phase
+    /// @return The number of allocations or 0 if the phase is unknown
+    u_int64_t get(const char* name) const noexcept {
+        for (u_int8_t i = 0; i < this->numPhases; i++) {
+            if (std::strcmp(this->phases[i].name, name) == 0) return this->phases[i].allocations;
+        }
+        return 0;
+    }
+};
+
+/// @brief The counts of the calling thread (trivially destructible, so it can be used until the thread is gone)
+thread_local Allocations threadAllocations;
+/// @brief The open phases of the calling thread (innermost last)
+thread_local const char* threadPhases[ALLOC_AUDIT_MAX_DEPTH];
+/// @brief The number of open phases of the calling thread, phases deeper than ALLOC_AUDIT_MAX_DEPTH are not counted
+thread_local u_int8_t threadDepth = 0;
+
+/// @brief Protects finishedAllocations
+std::mutex finishedMutex;
+/// @brief The counts of the finished threads
+Allocations finishedAllocations;
+
+/// @brief Adds the counts of the thread to the counts of the finished threads when the thread is finished
+struct ThreadFinisher {
+    /// @brief Marks the thread as started
+    bool started = false;
+
+    ~ThreadFinisher() {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        finishedAllocations.total += threadAllocations.total;
+        for (u_int8_t i = 0; i < threadAllocations.numPhases; i++) finishedAllocations.add(threadAllocations.phases[i].name, threadAllocations.phases[i].allocations);
+        threadAllocations = Allocations{};
+    }
+};
+thread_local ThreadFinisher threadFinisher;
+}  // namespace
+
+void AllocAudit::countAllocation() noexcept {
+    // the first use registers the finisher of the thread
+    threadFinisher.started = true;
+    threadAllocations.total++;
+    for (u_int8_t i = 0; i < std::min<u_int8_t>(threadDepth, ALLOC_AUDIT_MAX_DEPTH); i++) threadAllocations.add(threadPhases[i], 1);
+}
+
+void AllocAudit::pushPhase(const char* phase) noexcept {
+    if (threadDepth < ALLOC_AUDIT_MAX_DEPTH) threadPhases[threadDepth] = phase;
+    threadDepth++;
+}
+
+void AllocAudit::popPhase() noexcept { threadDepth--; }
+
+u_int64_t AllocAudit::getAllocations() noexcept {
+    std::lock_guard<std::mutex> lock(finishedMutex);
+    return finishedAllocations.total + threadAllocations.total;
+}
+
+u_int64_t AllocAudit::getAllocations(const char* phase) noexcept {
+    std::lock_guard<std::mutex> lock(finishedMutex);
+    return finishedAllocations.get(phase) + threadAllocations.get(phase);
+}
+
+void AllocAudit::reset() noexcept {
+    std::lock_guard<std::mutex> lock(finishedMutex);
+    finishedAllocations = Allocations{};
+    threadAllocations = Allocations{};
+}
+
+void AllocAudit::logReport() noexcept {
+    if (!AllocAudit::isEnabled()) {
+        PLOG_WARNING << "The allocations are not counted, configure with -DPOKER_ALLOC_AUDIT=ON";
+        return;
+    }
+    // the report allocates, so the counts are copied first
+    Allocations allocations;
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        allocations = finishedAllocations;
+        allocations.total += threadAllocations.total;
+        for (u_int8_t i = 0; i < threadAllocations.numPhases; i++) allocations.add(threadAllocations.phases[i].name, threadAllocations.phases[i].allocations);
+    }
+    PLOG_INFO << "Allocations: " << allocations.total;
+    for (u_int8_t i = 0; i < allocations.numPhases; i++) {
+        PLOG_INFO << "Allocations in " << allocations.phases[i].name << ": " << allocations.phases[i].allocations;
+    }
+}
+
+#ifdef POKER_ALLOC_AUDIT
+// the replaced global allocation functions, the array and nothrow versions of the standard library call them
+
+void* operator new(std::size_t size) {
+    AllocAudit::countAllocation();
+    if (size == 0) size = 1;
+    while (true) {
+        void* ptr = std::malloc(size);
+        if (ptr != nullptr) return ptr;
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* operator new(std::size_t size, const std::align_val_t alignment) {
+    AllocAudit::countAllocation();
+    // aligned_alloc needs a multiple of the alignment
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    size = (size + align - 1) / align * align;
+    if (size == 0) size = align;
+    while (true) {
+        void* ptr = std::aligned_alloc(align, size);
+        if (ptr != nullptr) return ptr;
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+#endif
@@ -0,0 +1,240 @@
+#include "async_log.h"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+
+namespace {
+/// @brief Gets the ANSI color of a severity like plog::ColorConsoleAppender
+/// @param severity The severity of the record
+/// @return The escape sequence or an empty string for no color
+/// @exception Guarantee No-throw
+constexpr const char* getColor(const plog::Severity severity) noexcept {
+    switch (severity) {
+        case plog::fatal:
+            return "\x1B[97m\x1B[41m";
+        case plog::error:
+            return "\x1B[91m";
+        case plog::warning:
+            return "\x1B[93m";
+        case plog::debug:
+        case plog::verbose:
+            return "\x1B[96m";
+        default:
+            return "";
+    }
+}
+
+/// @brief Gets the path of a rolled log file like plog::RollingFileAppender (log_game.1.txt)
+/// @param filePath The path of the log file
+/// @param index The index of the rolled file
+/// @return The path of the rolled file
+std::filesystem::path getRolledPath(const std::filesystem::path& filePath, const u_int8_t index) {
+    std::filesystem::path rolledPath = filePath;
+    rolledPath.replace_filename(filePath.stem().string() + "." + std::to_string(index) + filePath.extension().string());
+    return rolledPath;
+}
+}  // namespace
+
+AsyncLogAppender::AsyncLogAppender(const LogOverflow overflow, const std::string& filePath, const u_int64_t maxFileSize, const u_int8_t maxFiles, const bool console)
+    : overflow(overflow),
+      filePath(filePath),
+      maxFileSize(maxFileSize),
+      maxFiles(maxFiles),
+      console(console),
+      consoleColors(console && isatty(fileno(stdout))),
+      slots(std::make_unique<Slot[]>(ASYNC_LOG_CAPACITY)) {
+    if (!this->filePath.empty()) {
+        this->file.open(this->filePath, std::ios::app);
+        if (!this->file) {
+            PLOG_FATAL << "Could not open the log file " << this->filePath;
+            throw std::invalid_argument("Could not open the log file");
+        }
+        std::error_code error;
+        const u_int64_t size = std::filesystem::file_size(this->filePath, error);
+        this->fileSize = error ? 0 : size;
+    }
+    // a slot is free for the position equal to its sequence
+    for (u_int64_t i = 0; i < ASYNC_LOG_CAPACITY; i++) this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    this->writer = std::thread(&AsyncLogAppender::writeRecords, this);
+}
+
+void AsyncLogAppender::write(const plog::Record& record) noexcept {
+    // the producer is announced before it checks closing, so the background thread does not stop while the record is on its way into the ring
+    this->producers.fetch_add(1, std::memory_order_seq_cst);
+    if (!this->enqueue(record)) this->dropped.fetch_add(1, std::memory_order_relaxed);
+    this->producers.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+bool AsyncLogAppender::enqueue(const plog::Record& record) noexcept {
+    if (this->closing.load(std::memory_order_seq_cst)) return false;
+    const bool important = record.getSeverity() <= plog::warning;
+    if (this->overflow == LogOverflow::SAMPLE && !important &&
+        this->enqueuePos.load(std::memory_order_relaxed) - this->dequeuePos.load(std::memory_order_relaxed) > ASYNC_LOG_CAPACITY / 2 &&
+        this->sampleCounter.fetch_add(1, std::memory_order_relaxed) % ASYNC_LOG_SAMPLE_RATE != 0) {
+        return false;
+    }
+    while (!this->tryPush(record)) {
+        // the ring is full: BLOCK and the warnings and errors of SAMPLE wait for the background thread
+        if (this->overflow == LogOverflow::DROP || (this->overflow == LogOverflow::SAMPLE && !important) || this->closing.load(std::memory_order_acquire)) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+bool AsyncLogAppender::tryPush(const plog::Record& record) noexcept {
+    u_int64_t pos = this->enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &this->slots[pos & (ASYNC_LOG_CAPACITY - 1)];
+        const int64_t diff = (int64_t)slot->sequence.load(std::memory_order_acquire) - (int64_t)pos;
+        if (diff == 0) {
+            // the slot is free, claim the position (pos is updated if another producer was faster)
+            if (this->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            // the slot still holds the record of the previous round
+            return false;
+        } else {
+            pos = this->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    slot->time = record.getTime();
+    slot->severity = record.getSeverity();
+    slot->tid = record.getTid();
+    slot->func = record.getFunc();
+    slot->line = record.getLine();
+    try {
+        slot->message.assign(record.getMessage());
+    } catch (const std::exception&) {
+        // the claimed slot has to be published anyway
+        slot->message.clear();
+    }
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogAppender::writeRecords() noexcept {
+    std::string fileLines;
+    std::string consoleLines;
+    std::string line;
+    u_int64_t pos = this->dequeuePos.load(std::memory_order_relaxed);
+    u_int64_t reportedDropped = 0;
+    while (true) {
+        u_int64_t batch = 0;
+        fileLines.clear();
+        consoleLines.clear();
+        while (batch < ASYNC_LOG_BATCH) {
+            Slot& slot = this->slots[pos & (ASYNC_LOG_CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+            line.clear();
+            AsyncLogAppender::format(slot, line);
+            const plog::Severity severity = slot.severity;
+            // the slot is free for the producers of the next round
+            slot.sequence.store(pos + ASYNC_LOG_CAPACITY, std::memory_order_release);
+            pos++;
+            batch++;
+            fileLines += line;
+            if (this->consoleColors && getColor(severity)[0] != '\0') {
+                consoleLines += getColor(severity);
+                consoleLines.append(line, 0, line.size() - 1);
+                consoleLines += "\x1B[0m\x1B[0K\n";
+            } else {
+                consoleLines += line;
+            }
+        }
+        const u_int64_t dropped = this->dropped.load(std::memory_order_relaxed);
+        if (dropped != reportedDropped) {
+            // the dropped records are reported by the background thread, so the report cannot be dropped
+            Slot report{};
+            plog::util::ftime(&report.time);
+            report.severity = plog::warning;
+            report.tid = plog::util::gettid();
+            report.func = __func__;
+            report.line = __LINE__;
+            report.message = "Dropped " + std::to_string(dropped - reportedDropped) + " log records (" + EnumToString::enumToString(this->overflow) + " policy)";
+            line.clear();
+            AsyncLogAppender::format(report, line);
+            fileLines += line;
+            consoleLines += this->consoleColors ? std::string(getColor(plog::warning)) + line.substr(0, line.size() - 1) + "\x1B[0m\x1B[0K\n" : line;
+            reportedDropped = dropped;
+        }
+        if (!fileLines.empty()) {
+            if (this->console) {
+                std::cout.write(consoleLines.data(), consoleLines.size());
+                std::cout.flush();
+            }
+            this->writeFile(fileLines);
+        }
+        if (batch != 0) {
+            this->written.fetch_add(batch, std::memory_order_release);
+            this->dequeuePos.store(pos, std::memory_order_release);
+        }
+        // a producer may have passed the closing check or claimed a slot that it has not published yet
+        if (batch == 0 && this->closing.load(std::memory_order_seq_cst) && this->producers.load(std::memory_order_seq_cst) == 0 && pos == this->enqueuePos.load(std::memory_order_acquire)) return;
+        if (batch == 0) std::this_thread::sleep_for(std::chrono::microseconds(ASYNC_LOG_IDLE_US));
+    }
+}
+
+void AsyncLogAppender::format(const Slot& slot, std::string& out) noexcept {
+    // the layout of plog::TxtFormatter
+    tm t;
+    plog::util::localtime_s(&t, &slot.time.time);
+    char prefix[64];
+    std::snprintf(prefix, sizeof(prefix), "%04d-%02d-%02d %02d:%02d:%02d.%03d %-5s [%u] [", t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec,
+                  (int)slot.time.millitm, plog::severityToString(slot.severity), slot.tid);
+    try {
+        out += prefix;
+        out += slot.func;
+        out += "@";
+        out += std::to_string(slot.line);
+        out += "] ";
+        out += slot.message;
+        out += "\n";
+    } catch (const std::exception&) {
+        out = "\n";
+    }
+}
+
+void AsyncLogAppender::writeFile(const std::string& lines) noexcept {
+    if (!this->file.is_open()) return;
+    if (this->fileSize != 0 && this->fileSize + lines.size() > this->maxFileSize) this->rollFile();
+    this->file.write(lines.data(), lines.size());
+    this->file.flush();
+    this->fileSize += lines.size();
+}
+
+void AsyncLogAppender::rollFile() noexcept {
+    this->file.close();
+    try {
+        // like plog::RollingFileAppender: the oldest file is removed and the others are moved up by one
+        const std::filesystem::path path{this->filePath};
+        std::error_code error;
+        if (this->maxFiles > 1) {
+            std::filesystem::remove(getRolledPath(path, this->maxFiles - 1), error);
+            for (u_int8_t i = this->maxFiles - 2; i >= 1; i--) std::filesystem::rename(getRolledPath(path, i), getRolledPath(path, i + 1), error);
+            std::filesystem::rename(path, getRolledPath(path, 1), error);
+        } else {
+            std::filesystem::remove(path, error);
+        }
+    } catch (const std::exception&) {
+        // the records are appended to the old file
+    }
+    this->file.open(this->filePath, std::ios::app);
+    std::error_code error;
+    const u_int64_t size = std::filesystem::file_size(this->filePath, error);
+    this->fileSize = error ? 0 : size;
+}
+
+void AsyncLogAppender::flush() noexcept {
+    const u_int64_t target = this->enqueuePos.load(std::memory_order_acquire);
+    while (this->dequeuePos.load(std::memory_order_acquire) < target && this->writer.joinable()) std::this_thread::sleep_for(std::chrono::microseconds(ASYNC_LOG_IDLE_US));
+}
+
+void AsyncLogAppender::close() noexcept {
+    if (this->closing.exchange(true, std::memory_order_acq_rel)) return;
+    if (this->writer.joinable()) this->writer.join();
+    if (this->file.is_open()) this->file.close();
+}
@@ -0,0 +1,131 @@
+#include "checkpoint.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+Checkpoint Checkpoint::load(const std::string& path) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file.is_open()) {
+        PLOG_FATAL << "Could not open the checkpoint " << path;
+        throw std::invalid_argument("Could not open the checkpoint " + path);
+    }
+    Checkpoint frame;
+    frame.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    // the frame of the file: magic, version, size of the state, the state and its checksum
+    char magic[sizeof(MAGIC)];
+    frame.read(magic, sizeof(MAGIC));
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || frame.read<u_int32_t>() != VERSION) {
+        PLOG_FATAL << path << " is not a checkpoint of version " << VERSION;
+        throw std::invalid_argument(path + " is not a checkpoint of this version");
+    }
+    const u_int64_t size = frame.read<u_int64_t>();
+    if (frame.bytes.size() - frame.position != size + sizeof(u_int64_t)) {
+        PLOG_FATAL << "The checkpoint " << path << " has the wrong size";
+        throw std::invalid_argument("The checkpoint " + path + " has the wrong size");
+    }
+    Checkpoint checkpoint;
+    checkpoint.bytes.assign(frame.bytes.begin() + frame.position, frame.bytes.begin() + frame.position + size);
+    frame.position += size;
+    if (frame.read<u_int64_t>() != checkpoint.getChecksum()) {
+        PLOG_FATAL << "The checksum of the checkpoint " << path << " does not match";
+        throw std::invalid_argument("The checksum of the checkpoint " + path + " does not match");
+    }
+    return checkpoint;
+}
+
+bool Checkpoint::save(const std::string& path) const noexcept {
+    const std::string temporaryPath = path + ".tmp";
+    const int fd = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        PLOG_WARNING << "Could not open the checkpoint " << temporaryPath;
+        return false;
+    }
+    const u_int64_t size = this->bytes.size();
+    const u_int64_t checksum = this->getChecksum();
+    const std::pair<const void*, size_t> parts[] = {{MAGIC, sizeof(MAGIC)}, {&VERSION, sizeof(VERSION)}, {&size, sizeof(size)}, {this->bytes.data(), size}, {&checksum, sizeof(checksum)}};
+    bool ok = true;
+    for (const std::pair<const void*, size_t>& part : parts) {
+        const char* data = static_cast<const char*>(part.first);
+        for (size_t left = part.second; ok && left != 0;) {
+            const ssize_t count = ::write(fd, data, left);
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) {
+                ok = false;
+                break;
+            }
+            data += count;
+            left -= count;
+        }
+    }
+    // the data has to be on the disk before the rename makes it the checkpoint
+    ok = ::fsync(fd) == 0 && ok;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        PLOG_WARNING << "Could not write the checkpoint " << path;
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+u_int64_t Checkpoint::getChecksum() const noexcept {
+    u_int64_t hash = 14695981039346656037ULL;
+    for (const char byte : this->bytes) hash = (hash ^ (u_int8_t)byte) * 1099511628211ULL;
+    return hash;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& path, const u_int64_t interval) : path(path), interval(interval) {
+    if (interval == 0) {
+        PLOG_FATAL << "The checkpoint interval has to be at least one game";
+        throw std::invalid_argument("The checkpoint interval has to be at least one game");
+    }
+    this->writer = std::thread(&CheckpointWriter::writeCheckpoints, this);
+    PLOG_INFO << "Writing a checkpoint every " << interval << " games to " << path;
+}
+
+void CheckpointWriter::submit(Checkpoint& checkpoint) noexcept {
+    if (this->closed) return;
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        // the writer is still busy with an older checkpoint, the pending one is outdated
+        if (this->hasPending) this->skipped++;
+        this->pending.swap(checkpoint);
+        this->hasPending = true;
+    }
+    this->writerCondition.notify_one();
+}
+
+void CheckpointWriter::close() noexcept {
+    if (this->closed) return;
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        this->closing = true;
+    }
+    this->writerCondition.notify_one();
+    this->writer.join();
+    this->closed = true;
+    if (this->skipped != 0) {
+        PLOG_INFO << "The checkpoint writer skipped " << this->skipped << " outdated checkpoints";
+    }
+}
+
+void CheckpointWriter::writeCheckpoints() noexcept {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->writerCondition.wait(lock, [this]() { return this->hasPending || this->closing; });
+            // the pending checkpoint is written before the thread stops
+            if (!this->hasPending) break;
+            this->writing.swap(this->pending);
+            this->hasPending = false;
+        }
+        const bool saved = this->writing.save(this->path);
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        if (saved) this->written++;
+    }
+}
@@ -0,0 +1,51 @@
+#include "deal_generator.h"
+
+namespace {
+/// @brief Creates the deck that every deal starts with
+/// @return The 52 cards in the order of Deck()
+constexpr std::array<Card, CARD_NUM> getFreshDeck() noexcept {
+    std::array<Card, CARD_NUM> cards{};
+    for (u_int8_t suit = 0; suit < 4; suit++) {
+        for (u_int8_t rank = 2; rank < 15; rank++) cards[suit * 13 + rank - 2] = Card{rank, suit};
+    }
+    return cards;
+}
+
+/// @brief The deck that every deal starts with
+constexpr std::array<Card, CARD_NUM> FRESH_DECK = getFreshDeck();
+}  // namespace
+
+DealGenerator::DealGenerator(const u_int64_t seed, const u_int8_t players)
+    : seed(seed), numCards(5 + 2 * players), random(new u_int32_t[MAX_DRAWN_CARDS * DEAL_BLOCK_SIZE]) {
+    if (players == 0 || players > MAX_PLAYERS) {
+        PLOG_FATAL << "Invalid number of players for the deal generator: " << +players << " (1 to " << +MAX_PLAYERS << ")";
+        throw std::invalid_argument("Invalid number of players for the deal generator");
+    }
+}
+
+void DealGenerator::generate(DealBlock& block, const u_int32_t size) noexcept {
+    // every slot of every deal gets its own number, also the unused deals of a smaller block, so a deal does not depend on the size of its block
+    DealGenerator::fillRandom(this->seed, this->nextBlock++, this->random.get(), this->numCards * DEAL_BLOCK_SIZE);
+    block.size = size;
+    block.players = (this->numCards - 5) / 2;
+    std::array<Card, CARD_NUM> cards;
+    for (u_int32_t deal = 0; deal < size; deal++) {
+        cards = FRESH_DECK;
+        // partial Fisher-Yates shuffle, the multiply-shift bias of the at most 52 choices is below 2^-26
+        for (u_int8_t slot = 0; slot < this->numCards; slot++) {
+            const u_int8_t pick = slot + (((u_int64_t)this->random[slot * DEAL_BLOCK_SIZE + deal] * (CARD_NUM - slot)) >> 32);
+            std::swap(cards[slot], cards[pick]);
+            block.cards[slot][deal] = cards[slot];
+        }
+    }
+}
+
+void DealGenerator::fillRandom(const u_int64_t seed, const u_int64_t block, u_int32_t random[], const u_int32_t count) noexcept {
+    const Philox::Key key{(u_int32_t)seed, (u_int32_t)(seed >> 32)};
+    const u_int32_t streamWord = (u_int32_t)RandomStream::DEAL_BLOCK << 24;
+    // the blocks of the counter are independent, so the rounds of several counters run in the lanes of the vector registers
+    for (u_int32_t i = 0; i < count / 4; i++) {
+        const Philox::Block numbers = Philox::generate(Philox::Block{i, streamWord, (u_int32_t)block, (u_int32_t)(block >> 32)}, key);
+        for (u_int8_t j = 0; j < 4; j++) random[4 * i + j] = numbers[j];
+    }
+}
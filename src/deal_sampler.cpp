@@ -0,0 +1,245 @@
+#include "deal_sampler.h"
+
+namespace {
+/// @brief Checks if a card is dead
+/// @param dead The dead cards (bit i for card index i)
+/// @param index The index of the card
+/// @return True if the card is dead
+constexpr bool isDead(const u_int64_t dead, const u_int8_t index) noexcept { return (dead >> index) & 1; }
+
+/// @brief Draws distinct cards from a list of card indices
+/// @param rng The generator
+/// @param cards The card indices, the drawn cards are moved to the front
+/// @param len The number of card indices
+/// @param count The number of drawn cards (at most len)
+/// @param dead The dead cards, the drawn cards are added
+/// @param out The drawn cards
+constexpr void drawCards(Philox& rng, u_int8_t cards[], const u_int8_t len, const u_int8_t count, u_int64_t& dead, Card out[]) noexcept {
+    // partial Fisher-Yates shuffle
+    for (u_int8_t i = 0; i < count; i++) {
+        std::swap(cards[i], cards[i + rng.uniform(len - i)]);
+        dead |= (u_int64_t)1 << cards[i];
+        out[i] = HandRange::getCard(cards[i]);
+    }
+}
+
+/// @brief Gets the number of subsets of a size
+/// @param n The number of elements
+/// @param k The size of the subsets (at most 3)
+/// @return n choose k
+constexpr u_int32_t choose(const u_int32_t n, const u_int8_t k) noexcept {
+    if (n < k) return 0;
+    if (k == 1) return n;
+    if (k == 2) return n * (n - 1) / 2;
+    return n * (n - 1) * (n - 2) / 6;
+}
+
+/// @brief Draws an index of a weight proportional to the weight
+/// @param rng The generator
+/// @param weights The weights, the sum is below 2^32
+/// @param len The number of weights
+/// @return The index or len if every weight is 0
+constexpr u_int8_t drawWeighted(Philox& rng, const u_int32_t weights[], const u_int8_t len) noexcept {
+    u_int32_t total = 0;
+    for (u_int8_t i = 0; i < len; i++) total += weights[i];
+    if (total == 0) return len;
+    u_int32_t r = rng.uniform(total);
+    u_int8_t i = 0;
+    while (r >= weights[i]) r -= weights[i++];
+    return i;
+}
+}  // namespace
+
+HandRange& HandRange::add(const Card first, const Card second, const u_int16_t weight) {
+    if (first.rank < 2 || first.rank > 14 || first.suit > 3 || second.rank < 2 || second.rank > 14 || second.suit > 3 || first == second) {
+        PLOG_FATAL << "Invalid hand for the range: " << +first.rank << "/" << +first.suit << " and " << +second.rank << "/" << +second.suit;
+        throw std::invalid_argument("Invalid hand for the range");
+    }
+    u_int16_t& combo = this->weights[HandRange::getComboIndex(HandRange::getCardIndex(first), HandRange::getCardIndex(second))];
+    combo = std::min<u_int32_t>(combo + weight, UINT16_MAX);
+    return *this;
+}
+
+DealSampler::DealSampler(const u_int8_t numPlayers) : numPlayers(numPlayers) {
+    if (numPlayers == 0 || numPlayers > MAX_PLAYERS) {
+        PLOG_FATAL << "Invalid number of players for the deal sampler: " << +numPlayers << " (1 to " << +MAX_PLAYERS << ")";
+        throw std::invalid_argument("Invalid number of players for the deal sampler");
+    }
+    const HandRange any = HandRange::any();
+    for (u_int8_t i = 0; i < numPlayers; i++) this->setRange(i, any);
+}
+
+DealSampler& DealSampler::setRange(const u_int8_t seat, const HandRange& range) {
+    if (seat >= this->numPlayers) {
+        PLOG_FATAL << "Invalid seat for the deal sampler: " << +seat << " (" << +this->numPlayers << " seats)";
+        throw std::invalid_argument("Invalid seat for the deal sampler");
+    }
+    AliasTable table;
+    for (u_int8_t first = 0; first < CARD_NUM; first++) {
+        for (u_int8_t second = first + 1; second < CARD_NUM; second++) {
+            const u_int16_t weight = range.getWeight(HandRange::getComboIndex(first, second));
+            if (weight == 0) continue;
+            table.combos.push_back(first << 8 | second);
+            table.weights.push_back(weight);
+            table.totalWeight += weight;
+        }
+    }
+    if (table.combos.empty()) {
+        PLOG_FATAL << "The range of seat " << +seat << " is empty";
+        throw std::invalid_argument("The range of a seat is empty");
+    }
+    // Vose's alias method in integers: a column is full at totalWeight, the weights are scaled by the number of columns
+    const u_int32_t n = table.combos.size();
+    table.thresholds.resize(n);
+    table.aliases.resize(n);
+    std::vector<u_int16_t> small, large;
+    for (u_int16_t i = 0; i < n; i++) {
+        table.thresholds[i] = table.weights[i] * n;
+        (table.thresholds[i] < table.totalWeight ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        const u_int16_t s = small.back();
+        const u_int16_t l = large.back();
+        small.pop_back();
+        large.pop_back();
+        // the rest of the column of s is filled by l
+        table.aliases[s] = l;
+        table.thresholds[l] -= table.totalWeight - table.thresholds[s];
+        (table.thresholds[l] < table.totalWeight ? small : large).push_back(l);
+    }
+    for (const u_int16_t i : small) table.thresholds[i] = table.totalWeight;
+    for (const u_int16_t i : large) table.thresholds[i] = table.totalWeight;
+    this->tables[seat] = std::move(table);
+    return *this;
+}
+
+bool DealSampler::sample(Philox& rng, Deal& deal) const noexcept {
+    u_int64_t dead = 0;
+    for (u_int8_t i = 0; i < this->numPlayers; i++) {
+        if (!DealSampler::sampleHand(rng, this->tables[i], dead, deal.hands[i])) return false;
+        dead |= (u_int64_t)1 << HandRange::getCardIndex(deal.hands[i].first) | (u_int64_t)1 << HandRange::getCardIndex(deal.hands[i].second);
+    }
+    return this->sampleBoard(rng, dead, deal.board);
+}
+
+bool DealSampler::sample(Philox& rng, DealBlock& block, const u_int32_t size) const noexcept {
+    block.size = size;
+    block.players = this->numPlayers;
+    Deal deal;
+    for (u_int32_t i = 0; i < size; i++) {
+        if (!this->sample(rng, deal)) return false;
+        for (u_int8_t j = 0; j < 5; j++) block.cards[j][i] = deal.board[j];
+        for (u_int8_t p = 0; p < this->numPlayers; p++) {
+            block.cards[5 + 2 * p][i] = deal.hands[p].first;
+            block.cards[6 + 2 * p][i] = deal.hands[p].second;
+        }
+    }
+    return true;
+}
+
+bool DealSampler::sampleHand(Philox& rng, const AliasTable& table, const u_int64_t dead, std::pair<Card, Card>& hand) noexcept {
+    const u_int16_t n = table.combos.size();
+    u_int16_t combo = 0;
+    bool found = false;
+    for (u_int8_t i = 0; i < DEAL_SAMPLER_ALIAS_TRIES && !found; i++) {
+        const u_int16_t column = rng.uniform(n);
+        combo = table.combos[rng.uniform(table.totalWeight) < table.thresholds[column] ? column : table.aliases[column]];
+        found = !isDead(dead, combo >> 8) && !isDead(dead, combo & 0xFF);
+    }
+    if (!found) {
+        // the dead cards block too much of the range: draw from the weights of the remaining combinations
+        u_int32_t remaining = 0;
+        for (u_int16_t i = 0; i < n; i++) {
+            if (!isDead(dead, table.combos[i] >> 8) && !isDead(dead, table.combos[i] & 0xFF)) remaining += table.weights[i];
+        }
+        if (remaining == 0) return false;
+        u_int32_t r = rng.uniform(remaining);
+        for (u_int16_t i = 0; i < n; i++) {
+            if (isDead(dead, table.combos[i] >> 8) || isDead(dead, table.combos[i] & 0xFF)) continue;
+            if (r < table.weights[i]) {
+                combo = table.combos[i];
+                break;
+            }
+            r -= table.weights[i];
+        }
+    }
+    hand = {HandRange::getCard(combo >> 8), HandRange::getCard(combo & 0xFF)};
+    return true;
+}
+
+bool DealSampler::sampleBoard(Philox& rng, u_int64_t dead, Card board[]) const noexcept {
+    // the live cards of every suit and every rank
+    u_int8_t suits[4][13], ranks[13][4], live[CARD_NUM];
+    u_int8_t suitLen[4]{}, rankLen[13]{}, liveLen = 0;
+    for (u_int8_t i = 0; i < CARD_NUM; i++) {
+        if (isDead(dead, i)) continue;
+        suits[i / 13][suitLen[i / 13]++] = i;
+        ranks[i % 13][rankLen[i % 13]++] = i;
+        live[liveLen++] = i;
+    }
+    // draw the flop from a group of the texture, the group is weighted by its number of flops
+    switch (this->texture) {
+        case BoardTexture::ANY:
+            if (liveLen < 3) return false;
+            drawCards(rng, live, liveLen, 3, dead, board);
+            break;
+        case BoardTexture::MONOTONE: {
+            u_int32_t weights[4];
+            for (u_int8_t s = 0; s < 4; s++) weights[s] = choose(suitLen[s], 3);
+            const u_int8_t s = drawWeighted(rng, weights, 4);
+            if (s == 4) return false;
+            drawCards(rng, suits[s], suitLen[s], 3, dead, board);
+            break;
+        }
+        case BoardTexture::TWO_TONE: {
+            // two cards of suit pair / 4, one card of suit pair % 4
+            u_int32_t weights[16];
+            for (u_int8_t pair = 0; pair < 16; pair++) weights[pair] = pair / 4 == pair % 4 ? 0 : choose(suitLen[pair / 4], 2) * suitLen[pair % 4];
+            const u_int8_t pair = drawWeighted(rng, weights, 16);
+            if (pair == 16) return false;
+            drawCards(rng, suits[pair / 4], suitLen[pair / 4], 2, dead, board);
+            drawCards(rng, suits[pair % 4], suitLen[pair % 4], 1, dead, board + 2);
+            break;
+        }
+        case BoardTexture::RAINBOW: {
+            // one card of every suit except the suit missing
+            u_int32_t weights[4];
+            for (u_int8_t missing = 0; missing < 4; missing++) {
+                weights[missing] = 1;
+                for (u_int8_t s = 0; s < 4; s++) {
+                    if (s != missing) weights[missing] *= suitLen[s];
+                }
+            }
+            const u_int8_t missing = drawWeighted(rng, weights, 4);
+            if (missing == 4) return false;
+            u_int8_t card = 0;
+            for (u_int8_t s = 0; s < 4; s++) {
+                if (s != missing) drawCards(rng, suits[s], suitLen[s], 1, dead, board + card++);
+            }
+            break;
+        }
+        case BoardTexture::PAIRED: {
+            // two cards of a rank and one card of another rank
+            u_int32_t weights[13];
+            for (u_int8_t r = 0; r < 13; r++) weights[r] = choose(rankLen[r], 2) * (liveLen - rankLen[r]);
+            const u_int8_t r = drawWeighted(rng, weights, 13);
+            if (r == 13) return false;
+            drawCards(rng, ranks[r], rankLen[r], 2, dead, board);
+            u_int8_t others[CARD_NUM];
+            u_int8_t othersLen = 0;
+            for (u_int8_t i = 0; i < liveLen; i++) {
+                if (live[i] % 13 != r) others[othersLen++] = live[i];
+            }
+            drawCards(rng, others, othersLen, 1, dead, board + 2);
+            break;
+        }
+    }
+    // the turn and the river are not constrained
+    liveLen = 0;
+    for (u_int8_t i = 0; i < CARD_NUM; i++) {
+        if (!isDead(dead, i)) live[liveLen++] = i;
+    }
+    if (liveLen < 2) return false;
+    drawCards(rng, live, liveLen, 2, dead, board + 3);
+    return true;
+}
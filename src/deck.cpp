@@ -2,7 +2,7 @@
 
 const char* Card::toString() const {
     // Size should accommodate null terminator and Unicode symbol
-    static char str[CARD_STR_LEN];
+    static thread_local char str[CARD_STR_LEN];
 
     // Invalid suit
     if (this->suit > 3) {
@@ -40,7 +40,7 @@ Card Deck::draw() {
 
 const char* Deck::toString(const char sep) const {
     // print deck by concatenating all cards in deck with separator
-    static char str[CARD_NUM * (CARD_STR_LEN + 1)];
+    static thread_local char str[CARD_NUM * (CARD_STR_LEN + 1)];
     for (u_int8_t i = 0; i < this->len; i++) {
         std::strncat(str, this->cards[i].toString(), CARD_STR_LEN);
         std::strncat(str, &sep, 1);
@@ -92,6 +92,10 @@ Card Deck::getRandomCardExceptCardsWith(const Card exceptionCards[], const u_int
     return card;
 }
 
+void Deck::arrange(const Card order[], const u_int8_t numCards) {
+    for (u_int8_t i = 0; i < numCards; i++) this->putCard(order[i], i);
+}
+
 void Deck::putCard(const Card card, const u_int8_t cardPos) {
     // find card in deck and swap it with the card at cardPos
     int8_t pos = this->len - cardPos - 1;
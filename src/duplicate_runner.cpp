@@ -0,0 +1,150 @@
+#include "duplicate_runner.h"
+
+#include <algorithm>
+#include <thread>
+
+template <u_int8_t N, typename Chips>
+BasicDuplicateRunner<N, Chips>::BasicDuplicateRunner(const BasicConfig<N, Chips>& config, const DuplicateConfig& duplicateConfig, const PlayerFactory& playerFactory)
+    : config(config), duplicateConfig(duplicateConfig), playerFactory(playerFactory) {
+    if (duplicateConfig.numDeals == 0 || duplicateConfig.threads == 0) {
+        PLOG_FATAL << "Invalid duplicate config: " << duplicateConfig.numDeals << " deals with " << +duplicateConfig.threads << " threads";
+        throw std::invalid_argument("Invalid duplicate config");
+    }
+    if (duplicateConfig.seating == DuplicateSeating::PERMUTATIONS && config.numPlayers > MAX_DUPLICATE_PERMUTATION_PLAYERS) {
+        PLOG_FATAL << "Too many players for every permutation: " << +config.numPlayers << " (max: " << +MAX_DUPLICATE_PERMUTATION_PLAYERS << ")";
+        throw std::invalid_argument("Too many players for every permutation");
+    }
+    // the initial seating is ordered by the player ids
+    std::array<u_int8_t, N> seating{};
+    for (u_int8_t i = 0; i < config.numPlayers; i++) seating[i] = i;
+    if (duplicateConfig.seating == DuplicateSeating::ROTATIONS) {
+        for (u_int8_t k = 0; k < config.numPlayers; k++) {
+            this->seatings.push_back(seating);
+            std::rotate(seating.begin(), seating.begin() + 1, seating.begin() + config.numPlayers);
+        }
+    } else {
+        do {
+            this->seatings.push_back(seating);
+        } while (std::next_permutation(seating.begin(), seating.begin() + config.numPlayers));
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicDuplicateRunner<N, Chips>::run() {
+    this->results = Results{};
+    // every thread plays a contiguous range of deal sequences, the calling thread plays the last range
+    const u_int8_t threads = std::min<u_int32_t>(this->duplicateConfig.threads, this->duplicateConfig.numDeals);
+    const u_int32_t dealsPerThread = this->duplicateConfig.numDeals / threads;
+    std::vector<Results> threadResults(threads - 1);
+    std::vector<std::exception_ptr> threadErrors(threads - 1);
+    std::vector<std::thread> workers;
+    u_int8_t started = 0;
+    try {
+        for (; started < threads - 1; started++) {
+            workers.emplace_back([this, started, dealsPerThread, &threadResults, &threadErrors]() {
+                try {
+                    this->runDeals(started * dealsPerThread, (started + 1) * dealsPerThread, threadResults[started]);
+                } catch (...) {
+                    threadErrors[started] = std::current_exception();
+                }
+            });
+        }
+    } catch (const std::system_error& e) {
+        PLOG_WARNING << "DuplicateRunner could only start " << +started << " threads: " << e.what();
+    }
+    // the calling thread also plays the deal sequences of the threads that could not be started
+    std::exception_ptr error;
+    try {
+        this->runDeals(started * dealsPerThread, this->duplicateConfig.numDeals, this->results);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    for (u_int8_t i = 0; i < started; i++) {
+        workers[i].join();
+        if (threadErrors[i] && !error) error = threadErrors[i];
+        this->results.merge(threadResults[i]);
+    }
+    if (error) std::rethrow_exception(error);
+    this->logResults();
+}
+
+template <u_int8_t N, typename Chips>
+void BasicDuplicateRunner<N, Chips>::runDeals(const u_int32_t firstDeal, const u_int32_t lastDeal, Results& results) const {
+    BasicGame<N, Chips> game{this->config};
+    if (this->progressReporter != nullptr) game.setProgressCounters(this->progressReporter->createCounters());
+    // every thread stops its own deal sequences as soon as its results are significant, a deal sequence is one sample
+    u_int64_t tableChips = 0;
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) tableChips += this->config.startingChips[i];
+    BasicEarlyStop<N> earlyStop{this->config.earlyStop, this->config.numPlayers, (double)tableChips * this->config.numGames};
+    for (u_int32_t deal = firstDeal; deal < lastDeal; deal++) {
+        const u_int64_t seed = this->getDealSeed(deal);
+        // the games and chips won by every player over all seatings of the deal sequence
+        double dealGameWins[N]{};
+        double dealChipWins[N]{};
+        for (const std::array<u_int8_t, N>& seating : this->seatings) {
+            if (this->playerFactory) {
+                for (u_int8_t i = 0; i < this->config.numPlayers; i++) game.players[i] = this->playerFactory(i);
+            }
+            game.runDuplicate(seed, seating.data(), !this->playerFactory);
+            const BasicData<N, Chips>& data = game.getData();
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+                results.gameWins[i] += data.gameData.gameWins[i];
+                dealGameWins[i] += data.gameData.gameWins[i];
+                dealChipWins[i] += data.getChipWinsEV(i);
+            }
+        }
+        results.deals++;
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+            results.chipWins[i] += dealChipWins[i];
+            for (u_int8_t j = i + 1; j < this->config.numPlayers; j++) results.pairs[i][j].add((dealChipWins[i] - dealChipWins[j]) / this->seatings.size());
+            // the share of the games won and the chips won per seating
+            dealGameWins[i] /= this->seatings.size() * this->config.numGames;
+            dealChipWins[i] /= this->seatings.size();
+        }
+        earlyStop.addSample(dealGameWins, dealChipWins);
+        if (earlyStop.isDecided()) {
+            PLOG_DEBUG << "DuplicateRunner stopped the deal sequences " << firstDeal << " to " << lastDeal - 1 << " after " << earlyStop.getSamples();
+            break;
+        }
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicDuplicateRunner<N, Chips>::Results::merge(const Results& other) noexcept {
+    this->deals += other.deals;
+    for (u_int8_t i = 0; i < N; i++) {
+        this->gameWins[i] += other.gameWins[i];
+        this->chipWins[i] += other.chipWins[i];
+        for (u_int8_t j = i + 1; j < N; j++) this->pairs[i][j].merge(other.pairs[i][j]);
+    }
+}
+
+template <u_int8_t N, typename Chips>
+u_int64_t BasicDuplicateRunner<N, Chips>::getDealSeed(const u_int32_t deal) const noexcept {
+    u_int64_t z = this->duplicateConfig.seed + (deal + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+template <u_int8_t N, typename Chips>
+void BasicDuplicateRunner<N, Chips>::logResults() const noexcept {
+    PLOG_INFO << "Duplicate statistics (" << this->results.deals << " deal sequences, " << this->seatings.size() << " " << EnumToString::enumToString(this->duplicateConfig.seating)
+              << " per sequence): \n";
+    if (this->results.deals < this->duplicateConfig.numDeals) {
+        PLOG_INFO << EnumToString::enumToString(this->config.earlyStop.rule) << " stopped after " << this->results.deals << " of " << this->duplicateConfig.numDeals << " deal sequences ("
+                  << this->duplicateConfig.numDeals - this->results.deals << " deal sequences saved)";
+    }
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        PLOG_INFO << "Player " << +i << " won " << this->results.gameWins[i] << " games and " << this->results.chipWins[i] << " chips";
+    }
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        for (u_int8_t j = i + 1; j < this->config.numPlayers; j++) {
+            const DuplicatePairResult& pair = this->results.pairs[i][j];
+            PLOG_INFO << "Player " << +i << " vs player " << +j << ": " << pair.mean << " chips per deal sequence (standard error: " << pair.getStandardError() << ")";
+        }
+    }
+}
+
+#define INSTANTIATE_DUPLICATE_RUNNER(N, CHIPS) template class BasicDuplicateRunner<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_DUPLICATE_RUNNER)
@@ -0,0 +1,101 @@
+#include "early_stop.h"
+
+#include <cmath>
+
+template <u_int8_t N>
+BasicEarlyStop<N>::BasicEarlyStop(const EarlyStopConfig& config, const u_int8_t numPlayers, const double tableChips) noexcept
+    : config(config), numPlayers(numPlayers), tableChips(tableChips) {
+    // the standard normal quantile with erfc(z / sqrt(2)) = alpha, found by bisection
+    double low = 0;
+    double high = 40;
+    for (u_int8_t i = 0; i < 100; i++) {
+        const double mid = (low + high) / 2;
+        if (std::erfc(mid / std::sqrt(2.0)) > config.alpha)
+            low = mid;
+        else
+            high = mid;
+    }
+    this->z = (low + high) / 2;
+    this->upperBound = std::log((1 - config.beta) / config.alpha);
+    this->lowerBound = std::log(config.beta / (1 - config.alpha));
+}
+
+template <u_int8_t N>
+void BasicEarlyStop<N>::addSample(const double wins[], const double chips[]) noexcept {
+    this->samples++;
+    for (u_int8_t i = 0; i < this->numPlayers; i++) {
+        this->wins[i].add(wins[i], this->samples);
+        this->chips[i].add(chips[i], this->samples);
+        for (u_int8_t j = 0; j < this->numPlayers; j++) {
+            if (wins[i] > wins[j]) this->decisive[i][j] += wins[i] - wins[j];
+        }
+    }
+}
+
+template <u_int8_t N>
+bool BasicEarlyStop<N>::isDecided() const noexcept {
+    if (this->config.rule == StopRule::NONE || this->samples < this->config.minGames) return false;
+    for (u_int8_t i = 0; i < this->numPlayers; i++) {
+        if (this->config.rule == StopRule::SPRT) {
+            for (u_int8_t j = i + 1; j < this->numPlayers; j++) {
+                const double llr = this->getLLR(i, j);
+                const double otherLLR = this->getLLR(j, i);
+                // undecided as long as neither player is better and a gap is not ruled out in both directions
+                if (llr < this->upperBound && otherLLR < this->upperBound && (llr > this->lowerBound || otherLLR > this->lowerBound)) return false;
+            }
+        } else if (this->getWinRateHalfWidth(i) > this->config.delta || this->getChipRateHalfWidth(i) > this->config.delta * this->tableChips)
+            return false;
+    }
+    return true;
+}
+
+template <u_int8_t N>
+double BasicEarlyStop<N>::getLLR(const u_int8_t playerId, const u_int8_t otherId) const noexcept {
+    const double p = 0.5 + this->config.delta;
+    return this->decisive[playerId][otherId] * std::log(p / 0.5) + this->decisive[otherId][playerId] * std::log((1 - p) / 0.5);
+}
+
+template <u_int8_t N>
+void BasicEarlyStop<N>::save(Checkpoint& checkpoint) const {
+    checkpoint.write(&this->samples);
+    checkpoint.write(this->wins, N);
+    checkpoint.write(this->chips, N);
+    checkpoint.write(&this->decisive[0][0], N * N);
+}
+
+template <u_int8_t N>
+void BasicEarlyStop<N>::restore(Checkpoint& checkpoint) {
+    checkpoint.read(&this->samples);
+    checkpoint.read(this->wins, N);
+    checkpoint.read(this->chips, N);
+    checkpoint.read(&this->decisive[0][0], N * N);
+}
+
+template <u_int8_t N>
+void BasicEarlyStop<N>::logResults(const u_int64_t maxSamples, const char* sampleName) const noexcept {
+    if (this->config.rule == StopRule::NONE) return;
+    if (this->samples < maxSamples)
+        PLOG_INFO << EnumToString::enumToString(this->config.rule) << " stopped after " << this->samples << " of " << maxSamples << " " << sampleName << " (" << maxSamples - this->samples
+                  << " " << sampleName << " saved)";
+    else
+        PLOG_INFO << EnumToString::enumToString(this->config.rule) << " was not decided after " << this->samples << " " << sampleName;
+    for (u_int8_t i = 0; i < this->numPlayers; i++) {
+        PLOG_INFO << "Player " << +i << ": game-win rate " << this->getWinRate(i) << " +- " << this->getWinRateHalfWidth(i) << ", chip-win rate " << this->getChipRate(i) << " +- "
+                  << this->getChipRateHalfWidth(i);
+    }
+}
+
+template <u_int8_t N>
+void BasicEarlyStop<N>::Rate::add(const double value, const u_int64_t samples) noexcept {
+    const double delta = value - this->mean;
+    this->mean += delta / samples;
+    this->m2 += delta * (value - this->mean);
+}
+
+template <u_int8_t N>
+double BasicEarlyStop<N>::Rate::getStandardError(const u_int64_t samples) const noexcept {
+    return samples < 2 ? 0 : std::sqrt(this->m2 / (samples - 1) / samples);
+}
+
+#define INSTANTIATE_EARLY_STOP(N, CHIPS) template class BasicEarlyStop<N>;
+POKER_TABLE_CONFIGS(INSTANTIATE_EARLY_STOP)
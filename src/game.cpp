@@ -1,47 +1,125 @@
 #include "game.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cinttypes>
 
 #include "check_player/check_player.h"
+#include "combinations.h"
+#include "equity_player/equity_player.h"
+#include "hand_log.h"
 #include "hand_strengths.h"
 #include "human_player/human_player.h"
 #include "rand_player/rand_player.h"
+#include "trace.h"
 
-void Game::run(const bool initPlayers) {
-    // config players
-    // init players
-    if (initPlayers) {
-        this->players[0] = std::move(std::make_unique<CheckPlayer>(1));
-        this->players[1] = std::move(std::make_unique<RandPlayer>(2));
-        this->players[2] = std::move(std::make_unique<CheckPlayer>(3));
-        this->players[3] = std::move(std::make_unique<RandPlayer>(4));
-        this->players[4] = std::move(std::make_unique<RandPlayer>(5));
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::setDefaultPlayers() noexcept {
+    // cycle through the default lineup (check, rand, check, rand, equity) for every seat
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        if (i % 5 == 4)
+            this->players[i] = std::move(std::make_unique<BasicEquityPlayer<N, Chips>>(i + 1));
+        else if (i % 5 % 2 == 0)
+            this->players[i] = std::move(std::make_unique<BasicCheckPlayer<N, Chips>>(i + 1));
+        else
+            this->players[i] = std::move(std::make_unique<BasicRandPlayer<N, Chips>>(i + 1));
     }
+}
+
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::hasDeterministicPlayers() const noexcept {
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++)
+        if (!this->players[i]->isDeterministic()) return false;
+    return true;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::run(const bool initPlayers) {
+    this->tournament = false;
+    // init players
+    if (initPlayers) this->setDefaultPlayers();
 
     this->data.numPlayers = this->config.numPlayers;
+    // the ids are the positions at the start of the game set, the statistics are indexed by them
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) this->players[i]->setPlayerId(i);
+    if (this->duplicate) {
+        // seat the players by their ids for the whole game set
+        std::unique_ptr<BasicPlayer<N, Chips>> seated[N];
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) seated[i] = std::move(this->players[this->seatOrder[i]]);
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) this->players[i] = std::move(seated[i]);
+    }
     // reset winners
     std::memset(this->data.gameData.gameWins, 0, sizeof(this->data.gameData.gameWins));
     std::memset(this->data.gameData.chipWins, 0, sizeof(this->data.gameData.chipWins));
     std::memset(this->data.gameData.chipWinsAmount, 0, sizeof(this->data.gameData.chipWinsAmount));
+    std::fill(this->data.gameData.allInEVAdjustment, this->data.gameData.allInEVAdjustment + N, 0.0);
+    for (u_int8_t i = 0; i < N; i++) this->turnTimeStats[i].reset();
+    for (u_int8_t i = 0; i < N; i++) this->cashStats[i].reset();
+    std::memset(this->data.playerStats, 0, sizeof(this->data.playerStats));
 
     this->winnerString[0] = '\0';
 
+    // the stopping rule is not applied to duplicate games, every seating has to play the same games
+    const bool earlyStopEnabled = this->config.earlyStop.rule != StopRule::NONE && !this->duplicate;
+    u_int64_t tableChips = 0;
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) tableChips += this->config.startingChips[i];
+    BasicEarlyStop<N> earlyStop{this->config.earlyStop, this->config.numPlayers, (double)tableChips};
+    // a resumed run continues with the results and the next game of its checkpoint
+    u_int64_t startGame = 0;
+    u_int64_t endGame = this->config.numGames;
+    if (!this->resumeCheckpoint.isEmpty() && !this->duplicate) {
+        const bool finished = this->restoreCheckpoint(earlyStop);
+        startGame = this->game;
+        if (finished) {
+            // no game is played, the statistics are logged with the players seated by their ids
+            endGame = startGame;
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+                this->players[i]->setPlayerPosNum(i);
+                this->data.gameData.playerIds[i] = this->players[i]->getPlayerId();
+            }
+        } else if (!this->hasDeterministicPlayers()) {
+            PLOG_WARNING << "Resuming with players whose decisions are not reproducible, the results differ from a run without interruption";
+        }
+    }
+    const bool checkpoints = this->checkpointWriter != nullptr && !this->duplicate;
+    bool stopped = false;
+    // streaming results is also not done for duplicate games, the runner reports them
+    const bool streamResults = this->resultsSink != nullptr && !this->duplicate;
+    // the results before the current game, the differences are the samples of the stopping rule and the winners of the game records
+    u_int32_t gameWinsBefore[N];
+    double chipWinsBefore[N];
+
     // run for the number of games specified in the config
-    for (this->game = 0; this->game < this->config.numGames; this->game++) {
+    for (this->game = startGame; this->game < endGame; this->game++) {
+        if (this->stopRequested.exchange(false, std::memory_order_relaxed)) {
+            PLOG_INFO << "Stopped before game " << this->game;
+            stopped = true;
+            break;
+        }
         // ONE GAME
         // shuffle players
-        PLOG_DEBUG << "Starting game " << this->game;
+        POKER_HAND_LOG << "Starting game " << this->game;
+        if (earlyStopEnabled || streamResults || this->cash) {
+            std::copy(this->data.gameData.gameWins, this->data.gameData.gameWins + N, gameWinsBefore);
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) chipWinsBefore[i] = this->data.getChipWinsEV(i);
+        }
         this->initPlayerOrder();
-        this->data.gameData.numNonOutPlayers = this->config.numPlayers;
         // reset player out
-        std::memset(this->data.gameData.playerOut, 0, sizeof(this->data.gameData.playerOut));
+        this->data.gameData.playerOut.clear();
+        this->data.updateSeatCounters();
         for (u_int8_t i = 0; i < this->config.numPlayers; i++) this->data.gameData.playerChips[i] = this->config.startingChips[i];
         this->round = -1;
+        std::fill(this->cashSessionResult, this->cashSessionResult + N, 0);
 
-        while (this->data.gameData.numNonOutPlayers > 1) {
-            if (this->config.maxRounds >= 0 && this->round >= this->config.maxRounds - 1) {
+        // a cash game rebuys the players that are out, it only ends after its hands
+        while (this->cash || this->data.gameData.numNonOutPlayers > 1) {
+            if (this->cash) {
+                if (this->round >= 0) this->addCashHand();
+                if (this->round >= this->cashHands - 1) break;
+                this->rebuy();
+            } else if (this->config.maxRounds >= 0 && this->round >= this->config.maxRounds - 1) {
                 // find the player with the most chips
-                u_int8_t maxChipsPlayers[MAX_PLAYERS] = {0};
+                u_int8_t maxChipsPlayers[N] = {0};
                 u_int8_t maxChipsPlayersCount = 1;
                 for (u_int8_t i = 1; i < this->config.numPlayers; i++) {
                     if (this->data.gameData.playerChips[i] > this->data.gameData.playerChips[maxChipsPlayers[0]]) {
@@ -52,7 +130,7 @@ void Game::run(const bool initPlayers) {
                     }
                 }
                 // set the players with the most chips as the winner
-                for (u_int8_t i = 0; i < maxChipsPlayersCount; i++) this->data.gameData.gameWins[maxChipsPlayers[i]]++;
+                for (u_int8_t i = 0; i < maxChipsPlayersCount; i++) this->data.gameData.gameWins[this->data.getPlayerId(maxChipsPlayers[i])]++;
                 this->data.roundData.result = OutEnum::GAME_WON;
                 this->winnerString[0] = '\0';
                 for (u_int8_t i = 0; i < maxChipsPlayersCount; i++) {
@@ -60,73 +138,332 @@ void Game::run(const bool initPlayers) {
                     std::strncat(this->winnerString, this->getPlayerInfo(maxChipsPlayers[i]), MAX_GET_PLAYER_INFO_LENGTH);
                     if (i != maxChipsPlayersCount - 1) std::strcat(this->winnerString, ", ");
                 }
-                PLOG_INFO << "Game " << this->game << " ended in round " << this->round << "\nWINNER IS " << this->winnerString << "\n\n";
+                POKER_HAND_LOG << "Game " << this->game << " ended in round " << this->round << "\nWINNER IS " << this->winnerString << "\n\n";
                 break;
             }
             // ONE ROUND
-            this->round++;
-            if (this->config.shuffleDeck)
-                this->deck = Deck();
-            else
-                this->deck.reset();
-            this->data.roundData.betRoundState = BetRoundState::PREFLOP;
-            this->data.roundData.result = OutEnum::ROUND_CONTINUE;
-            this->data.roundData.numActivePlayers = this->data.gameData.numNonOutPlayers;
-            PLOG_DEBUG << "Starting round " << this->round;
-            this->startRound();
-            // PREFLOP
-            this->preflop();
-            // FLOP
-            this->flop();
-            // TURN
-            this->turn();
-            // RIVER
-            this->river();
-
-            if (this->data.roundData.result == OutEnum::ROUND_WON) {
-                // switch to the winner
-                this->data.nextActiveOrAllInPlayer();
-                PLOG_DEBUG << "Pot of " << this->data.roundData.pot << " won by " << this->getPlayerInfo(MAX_PLAYERS, this->data.roundData.pot) << ". Starting new round";
-                this->data.gameData.playerChips[this->data.betRoundData.playerPos] += this->data.roundData.pot;
-                this->data.gameData.chipWins[this->data.betRoundData.playerPos]++;
-                this->data.gameData.chipWinsAmount[this->data.betRoundData.playerPos] += this->data.roundData.pot;
-                continue;
-            } else if (this->data.roundData.result == OutEnum::GAME_WON) {
-                // switch to the winner
-                this->data.nextActiveOrAllInPlayer();
-                this->data.gameData.playerChips[this->data.betRoundData.playerPos] += this->data.roundData.pot;
-                this->data.gameData.gameWins[this->data.betRoundData.playerPos]++;
-                this->data.gameData.chipWins[this->data.betRoundData.playerPos]++;
-                this->data.gameData.chipWinsAmount[this->data.betRoundData.playerPos] += this->data.roundData.pot;
-                PLOG_INFO << "Game " << this->game << " ended in round " << this->round << "\nWINNER IS " << this->getPlayerInfo() << "\n\n";
+            if (this->playRound() && !this->cash) break;
+        }
+        if (this->cash) {
+            // the cash game is won by the best net result of the session, not by the last player with chips
+            std::copy(gameWinsBefore, gameWinsBefore + N, this->data.gameData.gameWins);
+            const int64_t best = *std::max_element(this->cashSessionResult, this->cashSessionResult + this->config.numPlayers);
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+                if (this->cashSessionResult[i] == best) this->data.gameData.gameWins[i]++;
+            }
+            POKER_HAND_LOG << "Cash game " << this->game << " ended after " << this->round + 1 << " hands\n\n";
+        }
+        this->progress->games.add();
+        if (streamResults) {
+            GameRecord record{this->game, (u_int32_t)(this->round + 1), 0, {}};
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+                const u_int8_t id = this->data.getPlayerId(i);
+                // the rebuys are not part of the result of a cash game
+                record.chipDeltas[id] = this->cash ? this->cashSessionResult[id] : (int64_t)this->data.gameData.playerChips[i] - (int64_t)this->config.startingChips[i];
+                if (this->data.gameData.gameWins[id] != gameWinsBefore[id]) record.winners |= 1u << id;
+            }
+            this->resultsSink->addGame(record);
+        }
+        if (earlyStopEnabled) {
+            double wins[N];
+            double chips[N];
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+                wins[i] = this->data.gameData.gameWins[i] - gameWinsBefore[i];
+                chips[i] = this->data.getChipWinsEV(i) - chipWinsBefore[i];
+            }
+            earlyStop.addSample(wins, chips);
+            if (earlyStop.isDecided()) {
+                // count the finished game
+                this->game++;
                 break;
             }
-
-            // SHOWDOWN
-            PLOG_DEBUG << "SHOWDOWN!!! Community cards: " << this->data.roundData.communityCards[0].toString() << " " << this->data.roundData.communityCards[1].toString() << " "
-                       << this->data.roundData.communityCards[2].toString() << " " << this->data.roundData.communityCards[3].toString() << " " << this->data.roundData.communityCards[4].toString();
-
-            // get winner
-            if (this->data.roundData.numAllInPlayers != 0) {
-                if (this->distributePotAllIn()) break;
-            } else
-                this->distributePotNoAllIn();
         }
+        // the checkpoint continues with the next game
+        if (checkpoints && (this->game + 1) % this->checkpointWriter->getInterval() == 0) this->saveCheckpoint(earlyStop, this->game + 1, false);
+    }
+    if (checkpoints) this->saveCheckpoint(earlyStop, this->game, !stopped);
+    // the duplicate runner reports the aggregated statistics of all seatings
+    if (this->duplicate) return;
+    if (streamResults) {
+        SummaryRecord summary{this->game, {}, {}, {}, {}};
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+            summary.gameWins[i] = this->data.gameData.gameWins[i];
+            summary.chipWins[i] = this->data.gameData.chipWins[i];
+            summary.chipWinsAmount[i] = this->data.gameData.chipWinsAmount[i];
+            summary.chipWinsEV[i] = this->data.getChipWinsEV(i);
+        }
+        this->resultsSink->addSummary(summary);
     }
     PLOG_INFO << "Statistics: \n";
     // sort players by wins
     std::pair<u_int8_t, u_int32_t> winners[this->data.numPlayers];
-    for (u_int8_t i = 0; i < this->config.numPlayers; i++) winners[i] = std::make_pair(i, this->data.gameData.gameWins[i]);
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) winners[i] = std::make_pair(i, this->data.gameData.gameWins[this->data.getPlayerId(i)]);
     std::sort(&winners[0], &winners[this->config.numPlayers], [](const std::pair<u_int8_t, u_int32_t>& a, const std::pair<u_int8_t, u_int32_t>& b) { return a.second > b.second; });
     for (u_int8_t i = 0; i < this->config.numPlayers; i++) PLOG_INFO << STR_PLAYER << this->players[winners[i].first]->getName() << " won " << winners[i].second << " games";
+    if (earlyStopEnabled) {
+        PLOG_INFO << "Early stop (player ids): \n";
+        earlyStop.logResults(this->config.numGames, "games");
+    }
+    if (this->config.allInEVSamples != 0) {
+        PLOG_INFO << "All-in EV: \n";
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+            const u_int8_t id = this->data.getPlayerId(i);
+            PLOG_INFO << STR_PLAYER << this->players[i]->getName() << " won " << this->data.gameData.chipWinsAmount[id] << " chips (all-in EV adjusted: " << this->data.getChipWinsEV(id) << ")";
+        }
+    }
+    if (this->cash) {
+        PLOG_INFO << "Cash games (bb/100, big blind " << 2 * this->config.smallBlind << "): \n";
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+            const CashStats& stats = this->cashStats[this->data.getPlayerId(i)];
+            PLOG_INFO << STR_PLAYER << this->players[i]->getName() << " won " << stats.getBbPer100(2.0 * this->config.smallBlind) << " bb/100 (standard error: "
+                      << stats.getStandardError(2.0 * this->config.smallBlind) << ", hands: " << stats.getHands() << ", rebuys: " << stats.getRebuys() << " with " << stats.getRebuyChips()
+                      << " chips)";
+        }
+    }
+    this->logTurnTimeStats();
     PLOG_INFO << "\n";
 }
 
-const char* Game::getPlayerInfo(u_int8_t playerPos, const int64_t chipsDiff, const int64_t baseChipsDiff) const noexcept {
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::playRound() {
+    this->round++;
+    this->progress->rounds.add();
+    POKER_TRACE_HAND();
+    POKER_TRACE_SCOPE("hand");
+    // writes the captured log of the hand if a trigger fired
+    const HandLogScope handLogScope;
+    if (this->duplicate) {
+        // every seating gets the same deal sequence
+        POKER_TRACE_SCOPE("shuffle");
+        this->deck.shuffle(this->dealSeed, this->game, this->round);
+    } else if (this->seeded && this->config.shuffleDeck) {
+        // the deck only depends on the coordinates of the round
+        POKER_TRACE_SCOPE("shuffle");
+        this->deck.shuffle(this->seed, this->firstGame + this->game, this->round);
+    } else if (this->config.shuffleDeck)
+        this->deck = Deck();
+    else
+        this->deck.reset();
+    this->data.roundData.betRoundState = BetRoundState::PREFLOP;
+    this->data.roundData.result = OutEnum::ROUND_CONTINUE;
+    POKER_HAND_LOG << "Starting round " << this->round;
+    this->startRound();
+    // PREFLOP
+    this->preflop();
+    // FLOP
+    this->flop();
+    // TURN
+    this->turn();
+    // RIVER
+    this->river();
+
+    if (this->data.roundData.result == OutEnum::ROUND_WON) {
+        // switch to the winner
+        this->data.nextActiveOrAllInPlayer();
+        POKER_HAND_LOG << "Pot of " << this->data.roundData.pot << " won by " << this->getPlayerInfo(N, this->data.roundData.pot) << ". Starting new round";
+        this->data.gameData.playerChips[this->data.betRoundData.playerPos] += this->data.roundData.pot;
+        this->data.gameData.chipWins[this->data.getPlayerId(this->data.betRoundData.playerPos)]++;
+        this->data.gameData.chipWinsAmount[this->data.getPlayerId(this->data.betRoundData.playerPos)] += this->data.roundData.pot;
+        return false;
+    } else if (this->data.roundData.result == OutEnum::GAME_WON) {
+        // switch to the winner
+        this->data.nextActiveOrAllInPlayer();
+        this->data.gameData.playerChips[this->data.betRoundData.playerPos] += this->data.roundData.pot;
+        const u_int8_t winnerId = this->data.getPlayerId(this->data.betRoundData.playerPos);
+        this->data.gameData.gameWins[winnerId]++;
+        this->data.gameData.chipWins[winnerId]++;
+        this->data.gameData.chipWinsAmount[winnerId] += this->data.roundData.pot;
+        POKER_HAND_LOG << "Game " << this->game << " ended in round " << this->round << "\nWINNER IS " << this->getPlayerInfo() << "\n\n";
+        return true;
+    }
+
+    // SHOWDOWN
+    POKER_HAND_LOG << "SHOWDOWN!!! Community cards: " << this->data.roundData.communityCards[0].toString() << " " << this->data.roundData.communityCards[1].toString() << " "
+                   << this->data.roundData.communityCards[2].toString() << " " << this->data.roundData.communityCards[3].toString() << " " << this->data.roundData.communityCards[4].toString();
+
+    this->progress->showdowns.add();
+    // count the showdown for every remaining player
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        if (!(this->data.roundData.playerFolded[i] || this->data.gameData.playerOut[i])) this->data.playerStats[this->data.getPlayerId(i)].showdowns++;
+    }
+    // get winner
+    if (this->data.roundData.numAllInPlayers != 0) return this->distributePotAllIn();
+    this->distributePotNoAllIn();
+    return false;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::runDuplicate(const u_int64_t dealSeed, const u_int8_t seatOrder[], const bool initPlayers) {
+    this->duplicate = true;
+    this->dealSeed = dealSeed;
+    std::copy(seatOrder, seatOrder + this->config.numPlayers, this->seatOrder);
+    try {
+        this->run(initPlayers);
+    } catch (...) {
+        this->duplicate = false;
+        throw;
+    }
+    this->duplicate = false;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::runCash(const u_int16_t hands, const bool initPlayers) {
+    if (hands == 0 || hands > INT16_MAX) {
+        PLOG_FATAL << "Invalid number of hands for a cash game: " << hands << " (1 to " << INT16_MAX << ")";
+        throw std::invalid_argument("Invalid number of hands for a cash game");
+    }
+    this->cash = true;
+    this->cashHands = hands;
+    try {
+        this->run(initPlayers);
+    } catch (...) {
+        this->cash = false;
+        throw;
+    }
+    this->cash = false;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::playTournamentHand(const Chips smallBlind, const Chips ante) {
+    this->tournamentSmallBlind = smallBlind;
+    this->ante = ante;
+    // the round numbers the decks, a long table starts over instead of overflowing
+    if (this->round == INT16_MAX) this->round = 0;
+    this->playRound();
+    // the seats without chips are out until an entrant is seated there
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        if (!this->data.gameData.playerOut[i] && this->data.gameData.playerChips[i] == 0) this->data.setPlayerOut(i);
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::initTournamentTable() noexcept {
+    this->data.numPlayers = this->config.numPlayers;
+    this->game = 0;
+    this->round = -1;
+    this->tournament = true;
+    std::memset(this->data.playerStats, 0, sizeof(this->data.playerStats));
+    std::memset(this->data.gameData.gameWins, 0, sizeof(this->data.gameData.gameWins));
+    std::memset(this->data.gameData.chipWins, 0, sizeof(this->data.gameData.chipWins));
+    std::memset(this->data.gameData.chipWinsAmount, 0, sizeof(this->data.gameData.chipWinsAmount));
+    std::fill(this->data.gameData.allInEVAdjustment, this->data.gameData.allInEVAdjustment + N, 0.0);
+    this->data.gameData.playerOut.clear();
+    this->data.updateSeatCounters();
+    // the first hand starts with the dealer on the first seat
+    this->data.roundData.bigBlindPos = N;
+    this->data.roundData.dealerPos = 0;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::seatPlayer(const u_int8_t seat, std::unique_ptr<BasicPlayer<N, Chips>>& player, const Chips chips) noexcept {
+    std::swap(this->players[seat], player);
+    this->players[seat]->setPlayerId(seat);
+    this->players[seat]->setPlayerPosNum(seat);
+    this->data.gameData.playerIds[seat] = seat;
+    this->data.gameData.playerChips[seat] = chips;
+    if (chips == 0)
+        this->data.gameData.playerOut.set(seat);
+    else
+        this->data.gameData.playerOut.reset(seat);
+    this->data.updateSeatCounters();
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::resume(const std::string& path) {
+    Checkpoint checkpoint = Checkpoint::load(path);
+    Checkpoint config;
+    this->writeCheckpointConfig(config);
+    // the settings of the checkpoint have to match the config byte by byte
+    std::vector<char> checkpointConfig(config.getSize());
+    checkpoint.read(checkpointConfig.data(), checkpointConfig.size());
+    if (std::memcmp(checkpointConfig.data(), config.getData(), checkpointConfig.size()) != 0) {
+        PLOG_FATAL << "The checkpoint " << path << " belongs to another config";
+        throw std::invalid_argument("The checkpoint " + path + " belongs to another config");
+    }
+    const bool seeded = checkpoint.read<bool>();
+    const u_int64_t seed = checkpoint.read<u_int64_t>();
+    const u_int64_t firstGame = checkpoint.read<u_int64_t>();
+    // the deals of the remaining games are derived from the seed of the checkpoint
+    this->seeded = seeded;
+    this->seed = seed;
+    this->firstGame = firstGame;
+    this->resumeCheckpoint = std::move(checkpoint);
+    PLOG_INFO << "Resuming from the checkpoint " << path << (seeded ? " with seed " + std::to_string(seed) : std::string(" without seed"));
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::writeCheckpointConfig(Checkpoint& checkpoint) const {
+    const u_int8_t tableSize[2] = {N, sizeof(Chips)};
+    checkpoint.write(tableSize, 2);
+    checkpoint.write(&this->config.numPlayers);
+    checkpoint.write(&this->config.numGames);
+    checkpoint.write(this->config.startingChips.data(), this->config.numPlayers);
+    checkpoint.write(&this->config.smallBlind);
+    checkpoint.write(&this->config.addBlindPerDealer0);
+    checkpoint.write(&this->config.maxRounds);
+    checkpoint.write(&this->config.allInEVSamples);
+    checkpoint.write(&this->config.earlyStop.rule);
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::saveCheckpoint(const BasicEarlyStop<N>& earlyStop, const u_int64_t nextGame, const bool finished) {
+    POKER_TRACE_SCOPE("checkpoint");
+    this->checkpoint.clear();
+    this->writeCheckpointConfig(this->checkpoint);
+    this->checkpoint.write(&this->seeded);
+    this->checkpoint.write(&this->seed);
+    this->checkpoint.write(&this->firstGame);
+    this->checkpoint.write(&this->cash);
+    this->checkpoint.write(&this->cashHands);
+    this->checkpoint.write(&nextGame);
+    this->checkpoint.write(&finished);
+    this->checkpoint.write(this->data.gameData.gameWins, N);
+    this->checkpoint.write(this->data.gameData.chipWins, N);
+    this->checkpoint.write(this->data.gameData.chipWinsAmount, N);
+    this->checkpoint.write(this->data.gameData.allInEVAdjustment, N);
+    this->checkpoint.write(this->data.playerStats, N);
+    this->checkpoint.write(this->turnTimeStats, N);
+    this->checkpoint.write(this->cashStats, N);
+    earlyStop.save(this->checkpoint);
+    // the writer thread writes the file, the checkpoint gets the memory of an older one
+    this->checkpointWriter->submit(this->checkpoint);
+}
+
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::restoreCheckpoint(BasicEarlyStop<N>& earlyStop) {
+    // the checkpoint is only resumed once
+    Checkpoint checkpoint = std::move(this->resumeCheckpoint);
+    this->resumeCheckpoint.clear();
+    const bool cash = checkpoint.read<bool>();
+    const int16_t cashHands = checkpoint.read<int16_t>();
+    if (cash != this->cash || (cash && cashHands != this->cashHands)) {
+        PLOG_FATAL << "The checkpoint is not of the mode of the run";
+        throw std::invalid_argument("The checkpoint is not of the mode of the run");
+    }
+    checkpoint.read(&this->game);
+    const bool finished = checkpoint.read<bool>();
+    checkpoint.read(this->data.gameData.gameWins, N);
+    checkpoint.read(this->data.gameData.chipWins, N);
+    checkpoint.read(this->data.gameData.chipWinsAmount, N);
+    checkpoint.read(this->data.gameData.allInEVAdjustment, N);
+    checkpoint.read(this->data.playerStats, N);
+    checkpoint.read(this->turnTimeStats, N);
+    checkpoint.read(this->cashStats, N);
+    earlyStop.restore(checkpoint);
+    if (!checkpoint.isRead()) {
+        PLOG_FATAL << "The checkpoint is too long";
+        throw std::invalid_argument("The checkpoint is too long");
+    }
+    PLOG_INFO << "Resumed " << (finished ? "the finished run after game " : "the run at game ") << this->game;
+    return finished;
+}
+
+template <u_int8_t N, typename Chips>
+const char* BasicGame<N, Chips>::getPlayerInfo(u_int8_t playerPos, const int64_t chipsDiff, const int64_t baseChipsDiff) const noexcept {
     // create player info string with MAX_GET_PLAYER_INFO_LENGTH
-    static char playerInfo[MAX_GET_PLAYER_INFO_LENGTH];
-    // if playerPos == MAX_PLAYERS, use the current player
-    if (playerPos == MAX_PLAYERS) playerPos = this->data.betRoundData.playerPos;
+    static thread_local char playerInfo[MAX_GET_PLAYER_INFO_LENGTH];
+    // if playerPos == N, use the current player
+    if (playerPos == N) playerPos = this->data.betRoundData.playerPos;
     // if chipsDiff == 0, do not add chipsDiff
     if (chipsDiff == 0)
         std::snprintf(playerInfo, sizeof(playerInfo), "%s%s[%lu]", STR_PLAYER, this->players[playerPos]->getName(), this->data.gameData.playerChips[playerPos] + baseChipsDiff);
@@ -136,30 +473,40 @@ const char* Game::getPlayerInfo(u_int8_t playerPos, const int64_t chipsDiff, con
     return playerInfo;
 }
 
-void Game::initPlayerOrder() noexcept {
-    // shuffle player order
-    if (this->config.shufflePlayers) std::random_shuffle(&this->players[0], &this->players[this->config.numPlayers]);
-    PLOG_INFO << "Shuffled players, new order:";
-    // rearrange the game stats according to the new player order
-    u_int32_t gameWinsCopy[MAX_PLAYERS];
-    u_int32_t chipWinsCopy[MAX_PLAYERS];
-    u_int64_t chipWinsAmountCopy[MAX_PLAYERS];
-    std::memcpy(gameWinsCopy, this->data.gameData.gameWins, sizeof(gameWinsCopy));
-    std::memcpy(chipWinsCopy, this->data.gameData.chipWins, sizeof(chipWinsCopy));
-    std::memcpy(chipWinsAmountCopy, this->data.gameData.chipWinsAmount, sizeof(chipWinsAmountCopy));
+template <u_int8_t N, typename Chips>
+Philox BasicGame<N, Chips>::getRandomStream(const RandomStream stream) const noexcept {
+    if (this->duplicate) return Philox{this->dealSeed, this->game, (u_int32_t)this->round, stream};
+    if (this->seeded) return Philox{this->seed, this->firstGame + this->game, (u_int32_t)this->round, stream};
+    return Philox{((u_int64_t)std::rand() << 32) | std::rand(), this->game, (u_int32_t)this->round, stream};
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::initPlayerOrder() noexcept {
+    // shuffle player order, the statistics are indexed by the player ids and do not have to be rearranged
+    if (this->config.shufflePlayers && !this->duplicate) {
+        if (this->seeded) {
+            // start from the order of the ids, so the order only depends on the coordinates of the game
+            std::sort(&this->players[0], &this->players[this->config.numPlayers],
+                      [](const std::unique_ptr<BasicPlayer<N, Chips>>& a, const std::unique_ptr<BasicPlayer<N, Chips>>& b) { return a->getPlayerId() < b->getPlayerId(); });
+            Philox rng{this->seed, this->firstGame + this->game, 0, RandomStream::PLAYER_ORDER};
+            for (u_int8_t i = this->config.numPlayers - 1; i > 0; i--) std::swap(this->players[i], this->players[rng.uniform(i + 1)]);
+        } else
+            std::random_shuffle(&this->players[0], &this->players[this->config.numPlayers]);
+    }
+    POKER_HAND_LOG << "Shuffled players, new order:";
     for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
-        // set playerPosNum for each player
-        this->data.gameData.gameWins[i] = gameWinsCopy[this->players[i]->getPlayerPosNum()];
-        this->data.gameData.chipWins[i] = chipWinsCopy[this->players[i]->getPlayerPosNum()];
-        this->data.gameData.chipWinsAmount[i] = chipWinsAmountCopy[this->players[i]->getPlayerPosNum()];
         this->players[i]->setPlayerPosNum(i);
-        PLOG_INFO << this->players[i]->getName();
+        this->data.gameData.playerIds[i] = this->players[i]->getPlayerId();
+        POKER_HAND_LOG << this->players[i]->getName();
     }
 }
 
-void Game::setBlinds() noexcept {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::setBlinds() noexcept {
+    POKER_TRACE_SCOPE("setBlinds");
     // blinds
-    if (this->data.gameData.numNonOutPlayers == 2) {
+    // the last big blind may have left the table of a tournament
+    if (this->data.gameData.numNonOutPlayers == 2 && this->data.roundData.bigBlindPos < this->config.numPlayers && !this->data.gameData.playerOut[this->data.roundData.bigBlindPos]) {
         // heads up rule (small blind is the dealer)
         // adjust button if the big blind would be the same player again
         this->data.roundData.dealerPos = this->data.roundData.bigBlindPos;
@@ -167,11 +514,11 @@ void Game::setBlinds() noexcept {
     }
     // if the player can not bet the small blind, he is all-in
     this->data.roundData.smallBlindPos = this->data.betRoundData.playerPos;
-    const u_int64_t smallBlindBet = this->betBlind(this->data.roundData.smallBlind);
+    const Chips smallBlindBet = this->betBlind(this->data.roundData.smallBlind);
     if (this->data.getChips() == 0)
-        PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -smallBlindBet, smallBlindBet) << " is all-in with small blind " << this->data.roundData.smallBlind;
+        POKER_HAND_LOG << this->getPlayerInfo(N, -(int64_t)smallBlindBet, smallBlindBet) << " is all-in with small blind " << this->data.roundData.smallBlind;
     else
-        PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -smallBlindBet, smallBlindBet) << " bets small blind " << this->data.roundData.smallBlind;
+        POKER_HAND_LOG << this->getPlayerInfo(N, -(int64_t)smallBlindBet, smallBlindBet) << " bets small blind " << this->data.roundData.smallBlind;
 
     this->data.nextActivePlayer();
 
@@ -179,9 +526,17 @@ void Game::setBlinds() noexcept {
     this->data.roundData.bigBlindPos = this->data.betRoundData.playerPos;
     this->data.roundData.bigBlindBet = this->betBlind(this->data.roundData.bigBlind);
     if (this->data.getChips() == 0)
-        PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -this->data.roundData.bigBlindBet, this->data.roundData.bigBlindBet) << " is all-in with big blind " << this->data.roundData.bigBlind;
+        POKER_HAND_LOG << this->getPlayerInfo(N, -(int64_t)this->data.roundData.bigBlindBet, this->data.roundData.bigBlindBet) << " is all-in with big blind " << this->data.roundData.bigBlind;
     else
-        PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -this->data.roundData.bigBlindBet, this->data.roundData.bigBlindBet) << " bets big blind " << this->data.roundData.bigBlind;
+        POKER_HAND_LOG << this->getPlayerInfo(N, -(int64_t)this->data.roundData.bigBlindBet, this->data.roundData.bigBlindBet) << " bets big blind " << this->data.roundData.bigBlind;
+
+    // the big blind ante is dead money in the main pot, it is only paid from the chips behind the big blind and is not part of its bets
+    if (this->ante != 0 && this->data.getChips() > 1) {
+        const Chips ante = std::min(this->ante, (Chips)(this->data.getChips() - 1));
+        this->data.removeChips(ante);
+        this->data.addDeadChips(ante);
+        POKER_HAND_LOG << this->getPlayerInfo(N, -(int64_t)ante, ante) << " posts ante " << ante;
+    }
 
     if (this->data.roundData.numActivePlayers == this->data.roundData.numAllInPlayers) {
         // all players are all-in, skip to showdown
@@ -193,7 +548,8 @@ void Game::setBlinds() noexcept {
     this->equalizeMove();
 }
 
-void Game::setupBetRound() noexcept {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::setupBetRound() noexcept {
     // resets the bet round data, first to act is the player after the dealer
     this->data.betRoundData.playerPos = this->data.roundData.dealerPos;
     this->data.nextActivePlayer();
@@ -202,42 +558,99 @@ void Game::setupBetRound() noexcept {
     this->data.betRoundData.currentBet = 0;
 }
 
-void Game::startRound() {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::rebuy() noexcept {
+    this->data.gameData.playerOut.clear();
+    this->data.updateSeatCounters();
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        const u_int8_t id = this->data.getPlayerId(i);
+        if (this->data.gameData.playerChips[i] < this->config.startingChips[i]) {
+            POKER_HAND_LOG << this->getPlayerInfo(i) << " rebuys " << this->config.startingChips[i] - this->data.gameData.playerChips[i] << " chips";
+            this->cashStats[id].addRebuy(this->config.startingChips[i] - this->data.gameData.playerChips[i]);
+            this->data.gameData.playerChips[i] = this->config.startingChips[i];
+        }
+        this->cashHandChips[i] = this->data.gameData.playerChips[i];
+        this->cashHandAdjustment[id] = this->data.gameData.allInEVAdjustment[id];
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::addCashHand() noexcept {
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        const u_int8_t id = this->data.getPlayerId(i);
+        const int64_t result = (int64_t)this->data.gameData.playerChips[i] - (int64_t)this->cashHandChips[i];
+        this->cashSessionResult[id] += result;
+        // the luck of the all-in runouts is removed from the samples like from the chip statistics
+        this->cashStats[id].addHand(result + this->data.gameData.allInEVAdjustment[id] - this->cashHandAdjustment[id]);
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::startRound() {
     const bool firstRound = this->round == 0;
     // reset deck and round data
-    if (this->config.shuffleDeck) this->deck.shuffle();
+    if (this->config.shuffleDeck && !this->duplicate && !this->seeded) {
+        POKER_TRACE_SCOPE("shuffle");
+        this->deck.shuffle();
+    }
     // select new dealer
     u_int8_t lastDealerPos = this->data.roundData.dealerPos;
     this->data.selectDealer(firstRound);
 
-    this->data.roundData.addBlind = this->config.addBlindPerDealer0;
-    if (firstRound) this->data.roundData.smallBlind = this->config.smallBlind;
+    // the blinds of a cash game are fixed, the blinds of a tournament table are set by the tournament clock
+    this->data.roundData.addBlind = this->cash || this->tournament ? 0 : this->config.addBlindPerDealer0;
+    if (this->tournament) this->data.roundData.smallBlind = this->tournamentSmallBlind;
+    else if (firstRound) this->data.roundData.smallBlind = this->config.smallBlind;
     // if the dealer is at position 0 again (or skipped 0), add the addBlind amount
     else if (this->data.roundData.dealerPos < lastDealerPos)
-        this->data.roundData.smallBlind += this->config.addBlindPerDealer0;
+        this->data.roundData.smallBlind += this->data.roundData.addBlind;
     // big blind is always double the small blind
     this->data.roundData.bigBlind = this->data.roundData.smallBlind * 2;
     this->data.roundData.pot = 0;
-    this->data.roundData.numAllInPlayers = 0;
-    // reset player folded
-    std::memset(this->data.roundData.playerFolded, 0, sizeof(this->data.roundData.playerFolded));
+    this->data.resetPots();
+    this->knownCommunityCards = 5;
+    // reset player folded and all-in
+    this->data.resetRoundSeats();
     std::memset(this->data.roundData.playerBetsTotal, 0, sizeof(this->data.roundData.playerBetsTotal));
     this->setupBetRound();
 
     // deal cards
-    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
-        if (this->data.gameData.playerOut[i]) continue;
-        this->players[i]->setHand(this->deck.draw(), this->deck.draw());
+    {
+        POKER_TRACE_SCOPE("deal");
+        if (this->dealSampler != nullptr) {
+            // the cards of the sampled deal are drawn from the top of the deck: the hands in the order of the positions, then the board
+            Philox rng = this->getRandomStream(RandomStream::DEAL_SAMPLER);
+            Deal deal;
+            if (!this->dealSampler->sample(rng, deal)) {
+                PLOG_FATAL << "The ranges of the deal sampler leave no deal";
+                throw std::logic_error("The ranges of the deal sampler leave no deal");
+            }
+            Card order[MAX_DRAWN_CARDS];
+            u_int8_t numCards = 0;
+            for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+                if (this->data.gameData.playerOut[i]) continue;
+                order[numCards++] = deal.hands[this->data.getPlayerId(i)].first;
+                order[numCards++] = deal.hands[this->data.getPlayerId(i)].second;
+            }
+            std::copy(deal.board, deal.board + 5, order + numCards);
+            this->deck.arrange(order, numCards + 5);
+        }
+        for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+            if (this->data.gameData.playerOut[i]) continue;
+            this->players[i]->setHand(this->deck.draw(), this->deck.draw());
+            this->data.playerStats[this->data.getPlayerId(i)].startHand();
+        }
     }
     // first action is setting the blinds
     if (firstRound) this->data.roundData.bigBlindPos = 0;  // fix first round heads up
     this->setBlinds();
 }
 
-OutEnum Game::betRound() {
-    // position of the first player that checked or MAX_PLAYERS if no player checked yet
-    u_int8_t firstChecker = MAX_PLAYERS;
-    this->lastRaiser = MAX_PLAYERS;
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::betRound() {
+    // position of the first player that checked or N if no player checked yet
+    u_int8_t firstChecker = N;
+    this->lastRaiser = N;
     this->data.betRoundData.minimumRaise = this->data.betRoundData.currentBet < this->data.roundData.bigBlind ? this->data.roundData.bigBlind : this->data.betRoundData.currentBet * 2;
     // this loop will run until all players have either folded, checked or called
     // we can only exit if it is a players turn and he is in the game, has the same bet as the current bet and all players have checked if the bet is 0
@@ -255,7 +668,7 @@ OutEnum Game::betRound() {
                 if (turnRes != OutEnum::ROUND_CONTINUE) return turnRes;
             } else {
                 // first player is used as the first raiser (to cover the case where no player raises)
-                if (this->lastRaiser == MAX_PLAYERS) this->lastRaiser = this->data.betRoundData.playerPos;
+                if (this->lastRaiser == N) this->lastRaiser = this->data.betRoundData.playerPos;
                 // player has to make a turn (fold, check, call, raise, bet)
                 const OutEnum turnRes = this->playerTurn(firstChecker);
                 if (turnRes != OutEnum::ROUND_CONTINUE) return turnRes;
@@ -264,11 +677,12 @@ OutEnum Game::betRound() {
             break;
     }
 
-    PLOG_DEBUG << "Bet round finished with bet " << this->data.betRoundData.currentBet << " and pot " << this->data.roundData.pot;
+    POKER_HAND_LOG << "Bet round finished with bet " << this->data.betRoundData.currentBet << " and pot " << this->data.roundData.pot;
     return OutEnum::ROUND_CONTINUE;
 }
 
-OutEnum Game::checkRoundSkip() const noexcept {
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::checkRoundSkip() const noexcept {
     // checks if one player is not all-in. That will cause a skip to the showdown
     if (this->data.roundData.numActivePlayers == this->data.roundData.numAllInPlayers + 1) {
         // all players, except one, are all-in, skip to showdown
@@ -277,15 +691,123 @@ OutEnum Game::checkRoundSkip() const noexcept {
     return OutEnum::ROUND_CONTINUE;
 }
 
-bool Game::currentPlayerBlindOption() const noexcept {
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::currentPlayerBlindOption() const noexcept {
     // current bet is the big blind and the current player is the big blind and it is the preflop round (the big blind can raise in the preflop round)
     return this->data.roundData.betRoundState == BetRoundState::PREFLOP && this->data.betRoundData.currentBet == this->data.roundData.bigBlind &&
            this->data.betRoundData.playerPos == this->data.roundData.bigBlindPos;
 }
 
-OutEnum Game::playerTurn(u_int8_t& firstChecker) {
+template <u_int8_t N, typename Chips>
+Action BasicGame<N, Chips>::getPlayerAction(const bool blindOption, const bool equalize) noexcept {
+    const u_int8_t playerPos = this->data.betRoundData.playerPos;
+    Action action;
+    if (!this->config.measureTurnTime && this->config.turnTimeBudget == 0) {
+        // fast path without any time measurement
+        POKER_TRACE_SCOPE("Player::turn");
+        action = this->players[playerPos]->turn(this->data, blindOption, equalize);
+    } else {
+        POKER_TRACE_SCOPE("Player::turn");
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        action = this->players[playerPos]->turn(this->data, blindOption, equalize);
+        const u_int64_t turnTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        TurnTimeStats& stats = this->turnTimeStats[this->data.getPlayerId(playerPos)];
+        stats.addTurnTime(turnTime);
+        if (this->config.turnTimeBudget != 0 && turnTime > this->config.turnTimeBudget) {
+            // the player took too long, the timeout action is played instead
+            stats.addOverrun();
+            POKER_HAND_LOG << this->getPlayerInfo() << " exceeded the turn time budget with " << turnTime << "ns (budget: " << this->config.turnTimeBudget << "ns)";
+            action = this->getTimeoutAction(blindOption, equalize);
+        }
+    }
+    this->progress->actions.add();
+    return action;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::countAction(const Action& action, const Chips callAdd, const Chips chips) noexcept {
+    PlayerStats& stats = this->data.playerStats[this->data.getPlayerId(this->data.betRoundData.playerPos)];
+    const bool preflop = this->data.roundData.betRoundState == BetRoundState::PREFLOP;
+    if (callAdd != 0) stats.facedBets++;
+    switch (action.action) {
+        case Actions::FOLD:
+            if (callAdd != 0) stats.foldsToBet++;
+            break;
+
+        case Actions::CALL:
+            // calling without adding chips (the blind option) is a check
+            if (callAdd == 0) break;
+            stats.calls++;
+            if (preflop) stats.addVPIP();
+            break;
+
+        case Actions::ALL_IN:
+            // an all-in up to the current bet is a call
+            if (chips <= callAdd) {
+                stats.calls++;
+                if (preflop) stats.addVPIP();
+                break;
+            }
+            [[fallthrough]];
+        case Actions::BET:
+        case Actions::RAISE:
+            stats.betsRaises++;
+            if (preflop) {
+                stats.addVPIP();
+                stats.addPFR();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+template <u_int8_t N, typename Chips>
+Action BasicGame<N, Chips>::getTimeoutAction(const bool blindOption, const bool equalize) const noexcept {
+    Action action;
+    // the blind option is free to call
+    if (blindOption) {
+        action.action = Actions::CALL;
+        return action;
+    }
+    // checking is always possible if there is no bet to equalize
+    if (!equalize && this->data.betRoundData.currentBet == 0) {
+        action.action = Actions::CHECK;
+        return action;
+    }
+    if (this->config.timeoutAction == Actions::FOLD) {
+        action.action = Actions::FOLD;
+        return action;
+    }
+    // call, a player who can not afford the call goes all-in (not higher than the bet)
+    action.action = this->data.getCallAdd() < this->data.getChips() ? Actions::CALL : Actions::ALL_IN;
+    return action;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::logTurnTimeStats() const noexcept {
+    if (!this->config.measureTurnTime && this->config.turnTimeBudget == 0) return;
+    PLOG_INFO << "Decision times: \n";
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        const TurnTimeStats& stats = this->turnTimeStats[this->data.getPlayerId(i)];
+        PLOG_INFO << STR_PLAYER << this->players[i]->getName() << " made " << stats.getDecisions() << " decisions in " << stats.getTotalTime() << "ns (mean: " << stats.getMeanTime()
+                  << "ns, p99: <" << stats.getPercentile(0.99) << "ns, max: " << stats.getMaxTime() << "ns, overruns: " << stats.getOverruns() << ")";
+        // only log the non empty buckets of the histogram
+        for (u_int8_t j = 0; j < TURN_TIME_HISTOGRAM_BUCKETS; j++) {
+            if (stats.getHistogram(j) == 0) continue;
+            PLOG_INFO << "\t<" << TurnTimeStats::getBucketUpperBound(j) << "ns: " << stats.getHistogram(j);
+        }
+    }
+}
+
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::playerTurn(u_int8_t& firstChecker) {
     // get action from player
-    Action action = this->players[this->data.betRoundData.playerPos]->turn(this->data);
+    Action action = this->getPlayerAction();
+    // the statistics need the state before the action, they are only counted for legal actions
+    const Chips turnCallAdd = this->data.getCallAdd();
+    const Chips turnChips = this->data.getChips();
     u_int64_t allInAmount;
     u_int64_t callAdd;
     u_int64_t raiseAdd;
@@ -294,7 +816,8 @@ OutEnum Game::playerTurn(u_int8_t& firstChecker) {
     switch (action.action) {
         case Actions::FOLD:
             // player folded
-            PLOG_DEBUG << this->getPlayerInfo() << " folded";
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo() << " folded";
             return playerFolded();
 
         case Actions::CHECK:
@@ -302,12 +825,13 @@ OutEnum Game::playerTurn(u_int8_t& firstChecker) {
             if (this->data.betRoundData.currentBet != 0) {
                 // illegal move leads to loss of the game
                 // set up error message
-                std::snprintf(str, sizeof(str), "%s%lu", STR_CHECK_ERROR, this->data.betRoundData.currentBet);
+                std::snprintf(str, sizeof(str), "%s%" PRIu64, STR_CHECK_ERROR, (u_int64_t)this->data.betRoundData.currentBet);
                 return playerOut(str);
             }
-            PLOG_DEBUG << this->getPlayerInfo() << " checked";
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo() << " checked";
             // if the player is the first checker, set firstChecker to the player position
-            if (firstChecker == MAX_PLAYERS) firstChecker = this->data.betRoundData.playerPos;
+            if (firstChecker == N) firstChecker = this->data.betRoundData.playerPos;
             this->data.nextActivePlayer();
             break;
 
@@ -317,10 +841,11 @@ OutEnum Game::playerTurn(u_int8_t& firstChecker) {
             if (!this->bet(this->data.betRoundData.currentBet)) {
                 // illegal move leads to loss of the game
                 // set up error message
-                std::snprintf(str, sizeof(str), "%s%lu", STR_CALL_ERROR, this->data.betRoundData.currentBet);
+                std::snprintf(str, sizeof(str), "%s%" PRIu64, STR_CALL_ERROR, (u_int64_t)this->data.betRoundData.currentBet);
                 return playerOut(str);
             }
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -callAdd, callAdd) << " called";
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo(N, -callAdd, callAdd) << " called";
             this->data.nextActivePlayer();
             break;
 
@@ -333,7 +858,8 @@ OutEnum Game::playerTurn(u_int8_t& firstChecker) {
                 std::snprintf(str, sizeof(str), "%s%lu", STR_RAISE_ERROR, action.bet);
                 return playerOut(str);
             }
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -raiseAdd, raiseAdd) << " raised to " << action.bet;
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo(N, -raiseAdd, raiseAdd) << " raised to " << action.bet;
             this->data.nextActivePlayer();
             break;
 
@@ -345,16 +871,19 @@ OutEnum Game::playerTurn(u_int8_t& firstChecker) {
                 std::snprintf(str, sizeof(str), "%s%lu", STR_BET_ERROR, action.bet);
                 return playerOut(str);
             }
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -action.bet, action.bet) << " bet " << action.bet;
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo(N, -action.bet, action.bet) << " bet " << action.bet;
             this->data.nextActivePlayer();
             break;
 
         case Actions::ALL_IN:
             // player is all-in
-            this->data.roundData.numAllInPlayers++;
+            this->countAction(action, turnCallAdd, turnChips);
+            this->data.setPlayerAllIn();
             allInAmount = this->data.getChips();
             this->data.addPlayerBet(allInAmount);
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -allInAmount) << " is all-in with " << this->data.betRoundData.playerBets[this->data.betRoundData.playerPos];
+            this->data.capPots();
+            POKER_HAND_LOG << this->getPlayerInfo(N, -allInAmount) << " is all-in with " << this->data.betRoundData.playerBets[this->data.betRoundData.playerPos];
             this->data.removeChipsAllIn();
             if (this->data.betRoundData.currentBet < this->data.betRoundData.playerBets[this->data.betRoundData.playerPos]) {
                 // set the current bet to the all-in amount, while also leaving the minimum raise unchanged if the all-in amount is not a raise
@@ -372,9 +901,12 @@ OutEnum Game::playerTurn(u_int8_t& firstChecker) {
     return OutEnum::ROUND_CONTINUE;
 }
 
-OutEnum Game::playerTurnBlindOption() {
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::playerTurnBlindOption() {
     // get action from player
-    Action action = this->players[this->data.betRoundData.playerPos]->turn(this->data, true);
+    Action action = this->getPlayerAction(true);
+    // the blind option does not require chips to stay in the hand
+    const Chips turnChips = this->data.getChips();
     u_int64_t raiseAdd;
     u_int64_t allInAmount;
     // store the error message if the action is illegal
@@ -382,7 +914,8 @@ OutEnum Game::playerTurnBlindOption() {
     switch (action.action) {
         case Actions::CALL:
             // player called, does not add chips to the pot
-            PLOG_DEBUG << this->getPlayerInfo() << " called";
+            this->countAction(action, 0, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo() << " called";
             if (!this->bet(this->data.betRoundData.currentBet)) {
                 // this move is not adding chips to the pot, so it can not be illegal
                 PLOG_FATAL << "Player " << this->data.betRoundData.playerPos << " called but could not bet";
@@ -401,16 +934,19 @@ OutEnum Game::playerTurnBlindOption() {
                 std::snprintf(str, sizeof(str), "%s%lu", STR_RAISE_ERROR, action.bet);
                 return playerOut(str);
             }
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -raiseAdd, raiseAdd) << " raised to " << action.bet;
+            this->countAction(action, 0, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo(N, -raiseAdd, raiseAdd) << " raised to " << action.bet;
             this->data.nextActivePlayer();
             return OutEnum::ROUND_CONTINUE;
 
         case Actions::ALL_IN:
             // player is all-in
-            this->data.roundData.numAllInPlayers++;
+            this->countAction(action, 0, turnChips);
+            this->data.setPlayerAllIn();
             allInAmount = this->data.getChips();
             this->data.addPlayerBet(allInAmount);
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -allInAmount) << " is all-in with " << this->data.betRoundData.playerBets[this->data.betRoundData.playerPos];
+            this->data.capPots();
+            POKER_HAND_LOG << this->getPlayerInfo(N, -allInAmount) << " is all-in with " << this->data.betRoundData.playerBets[this->data.betRoundData.playerPos];
             this->data.removeChipsAllIn();
             // set the current bet to the all-in amount, while also leaving the minimum raise unchanged if the all-in amount is not a raise
             this->adaptRaiseAttributes(this->data.betRoundData.playerBets[this->data.betRoundData.playerPos]);
@@ -427,9 +963,13 @@ OutEnum Game::playerTurnBlindOption() {
     }
 }
 
-OutEnum Game::playerTurnEqualize() noexcept {
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::playerTurnEqualize() noexcept {
     // get equalize action from player
-    Action action = this->players[this->data.betRoundData.playerPos]->turn(this->data, false, true);
+    Action action = this->getPlayerAction(false, true);
+    // the statistics need the state before the action, they are only counted for legal actions
+    const Chips turnCallAdd = this->data.getCallAdd();
+    const Chips turnChips = this->data.getChips();
     u_int64_t callAdd;
     u_int64_t allInAmount;
     // store the error message if the action is illegal
@@ -441,16 +981,18 @@ OutEnum Game::playerTurnEqualize() noexcept {
             if (!this->bet(this->data.betRoundData.currentBet)) {
                 // illegal move leads to loss of the game
                 // set up error message
-                std::snprintf(str, sizeof(str), "%s%lu", STR_CALL_ERROR, this->data.betRoundData.currentBet);
+                std::snprintf(str, sizeof(str), "%s%" PRIu64, STR_CALL_ERROR, (u_int64_t)this->data.betRoundData.currentBet);
                 return playerOut(str);
             }
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -callAdd, callAdd) << " called";
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo(N, -callAdd, callAdd) << " called";
             this->data.tryNextActivePlayer();
             return OutEnum::ROUND_CONTINUE;
 
         case Actions::FOLD:
             // player folded
-            PLOG_DEBUG << this->getPlayerInfo() << " folded";
+            this->countAction(action, turnCallAdd, turnChips);
+            POKER_HAND_LOG << this->getPlayerInfo() << " folded";
             return playerFolded();
 
         case Actions::ALL_IN:
@@ -462,10 +1004,12 @@ OutEnum Game::playerTurnEqualize() noexcept {
                 std::snprintf(str, sizeof(str), "%s%lu", STR_ALL_IN_ERROR, this->data.betRoundData.playerBets[this->data.betRoundData.playerPos] + allInAmount);
                 return playerOut(str);
             }
+            this->countAction(action, turnCallAdd, turnChips);
             this->data.addPlayerBet(allInAmount);
-            PLOG_DEBUG << this->getPlayerInfo(MAX_PLAYERS, -allInAmount) << " is all-in with " << this->data.betRoundData.playerBets[this->data.betRoundData.playerPos];
+            this->data.capPots();
+            POKER_HAND_LOG << this->getPlayerInfo(N, -allInAmount) << " is all-in with " << this->data.betRoundData.playerBets[this->data.betRoundData.playerPos];
             this->data.removeChipsAllIn();
-            this->data.roundData.numAllInPlayers++;
+            this->data.setPlayerAllIn();
             this->data.tryNextActivePlayer();
             return this->checkRoundSkip();
 
@@ -477,22 +1021,25 @@ OutEnum Game::playerTurnEqualize() noexcept {
     }
 }
 
-u_int64_t Game::betBlind(const u_int64_t blind) noexcept {
+template <u_int8_t N, typename Chips>
+Chips BasicGame<N, Chips>::betBlind(const Chips blind) noexcept {
     // bet the blind, if the player can not bet the blind, he is all-in
     const bool success = this->data.removeChips(blind);
     this->data.betRoundData.currentBet = blind;
     if (!success) {
-        this->data.roundData.numAllInPlayers++;
-        const u_int64_t allInAmount = this->data.getChips();
+        this->data.setPlayerAllIn();
+        const Chips allInAmount = this->data.getChips();
         this->data.removeChipsAllIn();
         this->data.addPlayerBet(allInAmount);
+        this->data.capPots();
         return allInAmount;
     }
     this->data.addPlayerBet(blind);
     return blind;
 }
 
-bool Game::bet(const u_int64_t amount) noexcept {
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::bet(const u_int64_t amount) noexcept {
     // amount is the whole bet, not the amount that is added to the pot
     if (((amount == this->data.betRoundData.currentBet && this->data.betRoundData.currentBet == 0) || (amount < this->data.betRoundData.currentBet) ||  // call condition
          ((amount > this->data.betRoundData.currentBet) && (amount < this->data.betRoundData.minimumRaise)) ||                                          // raise condition
@@ -508,27 +1055,28 @@ bool Game::bet(const u_int64_t amount) noexcept {
     return true;
 }
 
-OutEnum Game::playerOut(const char* reason) noexcept {
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::playerOut(const char* reason) noexcept {
     // player is out of the game, log the reason and set the player out
     PLOG_WARNING << this->getPlayerInfo() << " " << reason << " and is out";
-    this->data.gameData.numNonOutPlayers--;
-    this->data.roundData.numActivePlayers--;
-    this->data.gameData.playerOut[this->data.betRoundData.playerPos] = true;
+    HandLog::fire(HandLogTrigger::ILLEGAL_MOVE);
+    this->data.setPlayerOut(this->data.betRoundData.playerPos);
     this->data.gameData.playerChips[this->data.betRoundData.playerPos] = 0;
     this->data.tryNextActivePlayer();
 
     return this->getOutEnum();
 }
 
-OutEnum Game::playerFolded() noexcept {
-    this->data.roundData.numActivePlayers--;
-    this->data.roundData.playerFolded[this->data.betRoundData.playerPos] = true;
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::playerFolded() noexcept {
+    this->data.setPlayerFolded();
     this->data.tryNextActivePlayer();
     // if only one player is left, he wins the pot
     return this->getOutEnum();
 }
 
-OutEnum Game::getOutEnum() const noexcept {
+template <u_int8_t N, typename Chips>
+OutEnum BasicGame<N, Chips>::getOutEnum() const noexcept {
     if (this->data.gameData.numNonOutPlayers == 1) {
         // only one player is left in the game, he wins the game
         return OutEnum::GAME_WON;
@@ -540,7 +1088,9 @@ OutEnum Game::getOutEnum() const noexcept {
     }
 }
 
-void Game::equalizeMove() noexcept {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::equalizeMove() noexcept {
+    POKER_TRACE_SCOPE("equalizeMove");
     if (this->data.roundData.result == OutEnum::ROUND_SHOWDOWN) {
         // check if the current bet is equalized by the last player
         this->data.nextActivePlayer();
@@ -549,8 +1099,8 @@ void Game::equalizeMove() noexcept {
                 this->data.roundData.bigBlind == this->data.betRoundData.currentBet) {
                 // attention for the edge cases where the big blind is all-in with less chips than the big blind, therefore currentBet is not actually the current bet
                 // look for the highest bet in the preflop round
-                u_int64_t highestBet = 0;
-                u_int8_t highestBetPlayer = MAX_PLAYERS;
+                Chips highestBet = 0;
+                u_int8_t highestBetPlayer = N;
                 for (u_int8_t i = 0; i < this->data.numPlayers; i++) {
                     if (this->data.betRoundData.playerBets[i] > highestBet) {
                         highestBet = this->data.betRoundData.playerBets[i];
@@ -572,68 +1122,90 @@ void Game::equalizeMove() noexcept {
     }
 }
 
-void Game::preflop() {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::preflop() {
     if (this->data.roundData.result != OutEnum::ROUND_CONTINUE) return;
+    POKER_TRACE_SCOPE("preflop");
     this->data.roundData.betRoundState = BetRoundState::PREFLOP;
-    PLOG_DEBUG << "Starting PREFLOP bet round";
+    POKER_HAND_LOG << "Starting PREFLOP bet round";
     this->data.roundData.result = this->betRound();
     this->equalizeMove();
 }
 
-void Game::flop() {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::flop() {
     if (this->data.roundData.result != OutEnum::ROUND_CONTINUE) {
         if (this->data.roundData.result == OutEnum::ROUND_SHOWDOWN) {
+            // the betting stopped preflop
+            this->knownCommunityCards = 0;
             for (u_int8_t i = 0; i < 3; i++) {
                 this->data.roundData.communityCards[i] = this->deck.draw();  // draw flop cards
             }
+            this->countSawFlop();
         }
         return;
     }
+    POKER_TRACE_SCOPE("flop");
     for (u_int8_t i = 0; i < 3; i++) {
         this->data.roundData.communityCards[i] = this->deck.draw();  // draw flop cards
     }
+    this->countSawFlop();
     this->data.roundData.betRoundState = BetRoundState::FLOP;
     this->setupBetRound();
-    PLOG_DEBUG << "Starting FLOP bet round";
+    POKER_HAND_LOG << "Starting FLOP bet round";
     this->data.roundData.result = this->betRound();
     this->equalizeMove();
 }
 
-void Game::turn() {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::turn() {
     if (this->data.roundData.result != OutEnum::ROUND_CONTINUE) {
         if (this->data.roundData.result == OutEnum::ROUND_SHOWDOWN) {
+            // the betting stopped on the flop if it did not stop before
+            if (this->knownCommunityCards == 5) this->knownCommunityCards = 3;
             this->data.roundData.communityCards[3] = this->deck.draw();  // draw turn card
         }
         return;
     }
+    POKER_TRACE_SCOPE("turn");
     this->data.roundData.communityCards[3] = this->deck.draw();  // draw turn card
     this->data.roundData.betRoundState = BetRoundState::TURN;
     this->setupBetRound();
-    PLOG_DEBUG << "Starting TURN bet round";
+    POKER_HAND_LOG << "Starting TURN bet round";
     this->data.roundData.result = this->betRound();
     this->equalizeMove();
 }
 
-void Game::river() {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::river() {
     if (this->data.roundData.result != OutEnum::ROUND_CONTINUE) {
         if (this->data.roundData.result == OutEnum::ROUND_SHOWDOWN) {
+            // the betting stopped on the turn if it did not stop before
+            if (this->knownCommunityCards == 5) this->knownCommunityCards = 4;
             this->data.roundData.communityCards[4] = this->deck.draw();  // draw river card
             this->data.roundData.betRoundState = BetRoundState::RIVER;
         }
         return;
     }
+    POKER_TRACE_SCOPE("river");
     this->data.roundData.communityCards[4] = this->deck.draw();  // draw river card
     this->data.roundData.betRoundState = BetRoundState::RIVER;
     this->setupBetRound();
-    PLOG_DEBUG << "Starting RIVER bet round";
+    POKER_HAND_LOG << "Starting RIVER bet round";
     this->data.roundData.result = this->betRound();
     this->equalizeMove();
 }
 
-void Game::distributePotNoAllIn() noexcept {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::distributePotNoAllIn() noexcept {
+    POKER_TRACE_SCOPE("distributePotNoAllIn");
     // get hand strength for each player
     HandStrengths handStrengths[data.numPlayers];
-    HandStrengths::getHandStrengths(this->players, this->data, handStrengths);
+    {
+        POKER_TRACE_SCOPE("evaluate");
+        HandStrengths::getHandStrengths(this->players, this->data, handStrengths);
+    }
+    this->progress->evaluations.add(this->data.roundData.numActivePlayers);
     u_int8_t winners[this->data.numPlayers];
     HandStrengths strongestHand = HandStrengths(HandKinds::NO_HAND, 0);
     u_int8_t numWinners = 0;
@@ -641,8 +1213,8 @@ void Game::distributePotNoAllIn() noexcept {
     // find the strongest hand players and log their hands
     for (u_int8_t i = 0; i < this->data.numPlayers; i++) {
         if (this->data.roundData.playerFolded[i] || this->data.gameData.playerOut[i]) continue;
-        PLOG_DEBUG << this->getPlayerInfo(i) << " has hand " << this->players[i]->getHand().first.toString() << " " << this->players[i]->getHand().second.toString() << " and hand strength "
-                   << EnumToString::enumToString(handStrengths[i].handkind) << " " << handStrengths[i].rankStrength;
+        POKER_HAND_LOG << this->getPlayerInfo(i) << " has hand " << this->players[i]->getHand().first.toString() << " " << this->players[i]->getHand().second.toString() << " and hand strength "
+                       << EnumToString::enumToString(handStrengths[i].handkind) << " " << handStrengths[i].rankStrength;
         if (handStrengths[i] > strongestHand) {
             strongestHand = handStrengths[i];
             numWinners = 1;
@@ -652,157 +1224,229 @@ void Game::distributePotNoAllIn() noexcept {
         }
     }
 
+    if (numWinners > 1) HandLog::fire(HandLogTrigger::SPLIT_POT);
     // distribute pot, round down on integer division ("bank win")
-    const u_int64_t potPerWinner = this->data.roundData.pot / numWinners;
+    const Chips potPerWinner = this->data.roundData.pot / numWinners;
     this->winnerString[0] = '\0';  // reset winner string
     for (u_int8_t i = 0; i < numWinners; i++) {
         // depending MAX_POT_DIST_STRING_LENGTH
         std::strncat(this->winnerString, this->getPlayerInfo(winners[i], potPerWinner), MAX_GET_PLAYER_INFO_LENGTH);
         // add the win stats
+        const u_int8_t winnerId = this->data.getPlayerId(winners[i]);
         this->data.gameData.playerChips[winners[i]] += potPerWinner;
-        this->data.gameData.chipWins[winners[i]]++;
-        this->data.gameData.chipWinsAmount[winners[i]] += potPerWinner;
+        this->data.gameData.chipWins[winnerId]++;
+        this->data.gameData.chipWinsAmount[winnerId] += potPerWinner;
+        this->data.playerStats[winnerId].showdownsWon++;
         if (i != numWinners - 1) std::strcat(this->winnerString, ", ");
     }
-    PLOG_DEBUG << "Pot of " << this->data.roundData.pot << " won by " << this->winnerString << ". Starting new round";
+    POKER_HAND_LOG << "Pot of " << this->data.roundData.pot << " won by " << this->winnerString << ". Starting new round";
 }
 
-bool Game::distributePotAllIn() noexcept {
-    // The algorithm searches the players with the strongest hand and iterates over them
-    // The algorithm finds the minimum betting player and calculates the pot that results from the minimum bet
-    // Then the pot is split between the players and all players with minimum bet are removed from the winners list
-    // The algorithm continues until all players have been removed from the winners list
-    // Then it searches for the second strongest hand and repeats the process if the minimum bet there is higher than the previous minimum bet
-    // It continues until the player with the maximum bet is reached and processed
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::distributePotAllIn() noexcept {
+    // The pots are capped with every all-in (see BasicData::capPots()), therefore every pot already knows its contenders
+    // The remaining players are sorted once by their hand strength and every pot goes to its strongest contenders
+    // Consecutive pots with the same winners are merged before they are split, so the chips are only rounded down once ("bank win")
+    POKER_TRACE_SCOPE("distributePotAllIn");
+    HandLog::fire(HandLogTrigger::ALL_IN_SHOWDOWN);
     // get hand strength for each player
-    HandStrengths handStrengths[data.numPlayers];
-    HandStrengths::getHandStrengths(this->players, this->data, handStrengths);
-    u_int8_t winners[this->data.numPlayers];
-    HandStrengths strongestHand;
+    HandStrengths handStrengths[N];
+    {
+        POKER_TRACE_SCOPE("evaluate");
+        HandStrengths::getHandStrengths(this->players, this->data, handStrengths);
+    }
+    this->progress->allInSettlements.add();
+    this->progress->evaluations.add(this->data.roundData.numActivePlayers);
+    // the remaining players sorted by hand strength (strongest first, ties by position)
+    u_int8_t contenders[N];
+    u_int8_t numContenders = 0;
+    for (u_int8_t i = 0; i < this->data.numPlayers; i++) {
+        if (this->data.roundData.playerFolded[i] || this->data.gameData.playerOut[i]) continue;
+        POKER_HAND_LOG << this->getPlayerInfo(i) << " has hand " << this->players[i]->getHand().first.toString() << " " << this->players[i]->getHand().second.toString() << " and hand strength "
+                       << EnumToString::enumToString(handStrengths[i].handkind) << " " << handStrengths[i].rankStrength;
+        contenders[numContenders++] = i;
+    }
+    std::sort(contenders, contenders + numContenders,
+              [&handStrengths](const u_int8_t a, const u_int8_t b) { return handStrengths[a] > handStrengths[b] || (handStrengths[a] == handStrengths[b] && a < b); });
+    // the winners of the pending pots
+    u_int8_t winners[N];
     u_int8_t numWinners = 0;
-    // stores the minimum bet of the last winner list (same hands)
-    u_int64_t lastMinBet = 0;
-    // stores the minimum bet of the current winner list
-    u_int64_t minBet;
-    // stores the maximum bet of the round
-    const u_int64_t maxBet = *std::max_element(this->data.roundData.playerBetsTotal + 0, this->data.roundData.playerBetsTotal + MAX_PLAYERS);
-    // stores the amount of chips that are processed from the pot
-    u_int64_t usedPot = 0;
-    // stores the size of the current distribution pot
-    u_int64_t usingPot;
-    bool active = true;
-    // flag for the first iteration over all players (to log the hands of the players only once)
-    bool first = true;
-    // flag for the first pot distribution per winner list (to process the multiple pot wins as one win)
-    bool firstWinner = true;
+    // the chips of the pending pots that are not distributed yet
+    Chips pendingPot = 0;
+    // flag per player to process multiple pot wins as one win
+    bool wonPot[N]{};
     this->winnerString[0] = '\0';
     // store the chips of the players before the pot distribution
-    u_int64_t playerChipsBefore[MAX_PLAYERS];
+    Chips playerChipsBefore[N];
     std::memcpy(playerChipsBefore, this->data.gameData.playerChips, sizeof(playerChipsBefore));
-    // outer loop
-    while (active) {
-        // find the strongest hand players and log their hands
-        strongestHand = HandStrengths(HandKinds::NO_HAND, 0);
-        for (u_int8_t i = 0; i < this->data.numPlayers; i++) {
-            if (this->data.roundData.playerFolded[i] || this->data.gameData.playerOut[i]) continue;
-            if (first) {
-                PLOG_DEBUG << this->getPlayerInfo(i) << " has hand " << this->players[i]->getHand().first.toString() << " " << this->players[i]->getHand().second.toString() << " and hand strength "
-                           << EnumToString::enumToString(handStrengths[i].handkind) << " " << handStrengths[i].rankStrength;
-            }
-            if (handStrengths[i] > strongestHand) {
-                strongestHand = handStrengths[i];
-                numWinners = 1;
-                winners[0] = i;
-            } else if (handStrengths[i] == strongestHand) {
-                winners[numWinners++] = i;
+    // distributes the pending pots to the winners
+    auto distributePending = [&]() noexcept {
+        if (numWinners > 1) HandLog::fire(HandLogTrigger::SPLIT_POT);
+        const Chips potPerWinner = pendingPot / numWinners;
+        for (u_int8_t i = 0; i < numWinners; i++) {
+            const u_int8_t winnerId = this->data.getPlayerId(winners[i]);
+            this->data.gameData.playerChips[winners[i]] += potPerWinner;
+            this->data.gameData.chipWinsAmount[winnerId] += potPerWinner;
+            if (!wonPot[winners[i]]) {
+                wonPot[winners[i]] = true;
+                this->data.gameData.chipWins[winnerId]++;
+                this->data.playerStats[winnerId].showdownsWon++;
             }
         }
-        first = false;
-        firstWinner = true;
-        // inner loop
-        while (active) {
-            // find the minimum bet of the current winner list
-            minBet = -1;
-            for (u_int8_t i = 0; i < numWinners; i++) {
-                handStrengths[winners[i]] = HandStrengths(HandKinds::NO_HAND, 0);
-                if (this->data.roundData.playerBetsTotal[winners[i]] < minBet) {
-                    minBet = this->data.roundData.playerBetsTotal[winners[i]];
-                }
-            }
-            // only consider if the new minimum bet is higher than the last minimum bet (the last minimum bet is already processed)
-            if (minBet >= lastMinBet) {
-                // calculate the distribution pot that results from the minimum bet
-                if (minBet == maxBet)
-                    usingPot = this->data.roundData.pot - usedPot;
-                else {
-                    usingPot = 0;
-                    for (u_int8_t i = 0; i < this->data.numPlayers; i++) usingPot += std::max<int64_t>(0, std::min(this->data.roundData.playerBetsTotal[i], minBet) - (int64_t)lastMinBet);
-                }
-                // distribute the pot to the winners
-                usedPot += usingPot;
-                lastMinBet = minBet;
-                const u_int64_t potPerWinner = usingPot / numWinners;
-                for (u_int8_t i = 0; i < numWinners; i++) {
-                    this->data.gameData.playerChips[winners[i]] += potPerWinner;
-                    if (firstWinner) this->data.gameData.chipWins[winners[i]]++;
-                    this->data.gameData.chipWinsAmount[winners[i]] += potPerWinner;
-                }
-                firstWinner = false;
-                // stop the algorithm if the maximum bet is reached
-                if (lastMinBet == maxBet) {
-                    active = false;
-                    break;
-                }
+        pendingPot = 0;
+    };
+    // index of the strongest contender of the current pot, the non-contenders of the pots only grow with the pot index
+    u_int8_t strongest = 0;
+    for (u_int8_t i = 0; i < this->data.roundData.numPots; i++) {
+        const BasicPot<N, Chips>& pot = this->data.roundData.pots[i];
+        if (pot.getPotValue() == 0) continue;
+        while (strongest < numContenders && !pot.isContender(contenders[strongest])) strongest++;
+        if (strongest != numContenders) {
+            // all contenders of the pot with the strongest hand win the pot
+            u_int8_t potWinners[N];
+            u_int8_t numPotWinners = 0;
+            for (u_int8_t j = strongest; j < numContenders && handStrengths[contenders[j]] == handStrengths[contenders[strongest]]; j++) {
+                if (pot.isContender(contenders[j])) potWinners[numPotWinners++] = contenders[j];
             }
-            // remove the players with the minimum bet from the winners list
-            u_int8_t i = 0;
-            while (i < numWinners) {
-                if (this->data.roundData.playerBetsTotal[winners[i]] == minBet) {
-                    for (int j = i; j < numWinners - 1; ++j) winners[j] = winners[j + 1];
-                    numWinners--;
-                } else
-                    i++;
+            // the pot winners are a subset of the previous winners or completely different players
+            if (numPotWinners != numWinners || potWinners[0] != winners[0]) {
+                if (numWinners != 0) distributePending();
+                std::copy(potWinners, potWinners + numPotWinners, winners);
+                numWinners = numPotWinners;
             }
-            // go to outer loop if no winners are left
-            if (numWinners == 0) break;
         }
+        // a pot without contenders goes to the winners of the previous pot
+        pendingPot += pot.getPotValue();
     }
+    if (numWinners != 0) distributePending();
+    // the all-in EV is only required if there were cards left to deal when the betting stopped
+    if (this->config.allInEVSamples != 0 && this->knownCommunityCards < 5) this->creditAllInEV(contenders, numContenders, playerChipsBefore);
     // construct the winner string and log it
     bool commaReq = false;
     for (u_int8_t i = 0; i < this->data.numPlayers; i++) {
         // depending MAX_POT_DIST_STRING_LENGTH
-        const u_int64_t chipsDiff = this->data.gameData.playerChips[i] - playerChipsBefore[i];
+        // the difference is signed, a loss of a narrow chip type must not wrap before it is widened
+        const int64_t chipsDiff = (int64_t)this->data.gameData.playerChips[i] - (int64_t)playerChipsBefore[i];
         if (chipsDiff == 0) continue;
         if (commaReq) std::strcat(this->winnerString, ", ");
         commaReq = true;
         std::strncat(this->winnerString, this->getPlayerInfo(i, chipsDiff, -chipsDiff), MAX_GET_PLAYER_INFO_LENGTH);
     }
-    PLOG_DEBUG << "Pot of " << this->data.roundData.pot << " won by " << this->winnerString << ". Starting new round" << std::endl;
+    POKER_HAND_LOG << "Pot of " << this->data.roundData.pot << " won by " << this->winnerString << ". Starting new round" << std::endl;
     // remove players with 0 chips from the game
     return this->handleZeroChipPlayers(winners);
 }
 
-bool Game::handleZeroChipPlayers(const u_int8_t winners[]) noexcept {
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::creditAllInEV(const u_int8_t contenders[], const u_int8_t numContenders, const Chips playerChipsBefore[]) noexcept {
+    // the runouts are not traced one by one, they would fill the ring buffer
+    POKER_TRACE_SCOPE("creditAllInEV");
+    // the runouts are the subsets of the cards that are not known to the contenders (the hands of folded players are unknown)
+    const Card* communityCards = this->data.roundData.communityCards;
+    u_int64_t known = 0;
+    for (u_int8_t i = 0; i < this->knownCommunityCards; i++) known |= CardCombinations::getCardMask(communityCards[i]);
+    for (u_int8_t i = 0; i < numContenders; i++) {
+        known |= CardCombinations::getCardMask(this->players[contenders[i]]->getHand().first) | CardCombinations::getCardMask(this->players[contenders[i]]->getHand().second);
+    }
+    const u_int8_t missing = 5 - this->knownCommunityCards;
+    const CardCombinations runouts{~known & (((u_int64_t)1 << CARD_NUM) - 1), missing};
+    Card board[5];
+    std::copy(communityCards, communityCards + this->knownCommunityCards, board);
+    // the summed pot shares of all evaluated runouts per position
+    double shares[N]{};
+    // splits the pots on the current board like distributePotAllIn(), a pot without contenders goes to the winners of the previous (or next) pot
+    // consecutive pots with the same winners are merged and rounded down like the dealt pots, so the shares add up to the distributed chips
+    auto addRunout = [&]() noexcept {
+        HandStrengths handStrengths[N];
+        for (u_int8_t i = 0; i < numContenders; i++) handStrengths[contenders[i]] = HandStrengths::getHandStrength(this->players[contenders[i]]->getHand(), board);
+        this->progress->evaluations.add(numContenders);
+        u_int8_t winners[N];
+        u_int8_t numWinners = 0;
+        Chips pendingPot = 0;
+        for (u_int8_t i = 0; i < this->data.roundData.numPots; i++) {
+            const BasicPot<N, Chips>& pot = this->data.roundData.pots[i];
+            if (pot.getPotValue() == 0) continue;
+            u_int8_t potWinners[N];
+            u_int8_t numPotWinners = 0;
+            for (u_int8_t j = 0; j < numContenders; j++) {
+                if (!pot.isContender(contenders[j])) continue;
+                if (numPotWinners != 0 && handStrengths[potWinners[0]] > handStrengths[contenders[j]]) continue;
+                // a stronger hand replaces the previous winners
+                if (numPotWinners != 0 && handStrengths[contenders[j]] > handStrengths[potWinners[0]]) numPotWinners = 0;
+                potWinners[numPotWinners++] = contenders[j];
+            }
+            if (numPotWinners != 0 && (numPotWinners != numWinners || potWinners[0] != winners[0])) {
+                if (numWinners != 0) {
+                    for (u_int8_t j = 0; j < numWinners; j++) shares[winners[j]] += pendingPot / numWinners;
+                    pendingPot = 0;
+                }
+                std::copy(potWinners, potWinners + numPotWinners, winners);
+                numWinners = numPotWinners;
+            }
+            pendingPot += pot.getPotValue();
+        }
+        for (u_int8_t j = 0; j < numWinners; j++) shares[winners[j]] += pendingPot / numWinners;
+    };
+    u_int64_t evaluated = 0;
+    if (runouts.getCount() <= this->config.allInEVSamples) {
+        // enumerate every runout
+        runouts.forEach([&](const Card runout[], const u_int64_t) noexcept {
+            std::copy(runout, runout + missing, board + this->knownCommunityCards);
+            addRunout();
+            evaluated++;
+        });
+    } else {
+        // sample the runouts by drawing from the end of the unknown cards (partial Fisher-Yates shuffle)
+        Card unknownCards[CARD_NUM];
+        const u_int8_t unknownNum = runouts.getNumCards();
+        for (u_int8_t i = 0; i < unknownNum; i++) unknownCards[i] = runouts.getLiveCard(i);
+        Philox rng = this->getRandomStream(RandomStream::ALL_IN_EV);
+        for (; evaluated < this->config.allInEVSamples; evaluated++) {
+            u_int8_t left = unknownNum;
+            for (u_int8_t i = 0; i < missing; i++) {
+                const u_int8_t ind = rng.uniform(left);
+                left--;
+                std::swap(unknownCards[ind], unknownCards[left]);
+                board[this->knownCommunityCards + i] = unknownCards[left];
+            }
+            addRunout();
+        }
+    }
+    // credit the difference between the expected share and the chips that were actually won
+    for (u_int8_t i = 0; i < numContenders; i++) {
+        const u_int8_t pos = contenders[i];
+        this->data.gameData.allInEVAdjustment[this->data.getPlayerId(pos)] += shares[pos] / evaluated - (double)(this->data.gameData.playerChips[pos] - playerChipsBefore[pos]);
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicGame<N, Chips>::countSawFlop() noexcept {
+    for (u_int8_t i = 0; i < this->config.numPlayers; i++) {
+        if (!(this->data.roundData.playerFolded[i] || this->data.gameData.playerOut[i])) this->data.playerStats[this->data.getPlayerId(i)].sawFlop++;
+    }
+}
+
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::handleZeroChipPlayers(const u_int8_t winners[]) noexcept {
     // check if one player has 0 chips and is out of the game
     for (u_int8_t i = 0; i < this->data.numPlayers; i++) {
         if (this->data.gameData.playerChips[i] == 0 && !this->data.gameData.playerOut[i]) {
-            this->data.gameData.numNonOutPlayers--;
-            this->data.roundData.numActivePlayers--;
-            this->data.gameData.playerOut[i] = true;
+            this->data.setPlayerOut(i);
             PLOG_WARNING << this->getPlayerInfo(i) << " is out of chips and is out";
         }
     }
     if (this->data.gameData.numNonOutPlayers == 1) {
         // only one player is left in the game, he wins the game
-        this->data.gameData.gameWins[winners[0]]++;
+        this->data.gameData.gameWins[this->data.getPlayerId(winners[0])]++;
         this->data.roundData.result = OutEnum::GAME_WON;
-        PLOG_INFO << "Game " << this->game << " ended in round " << this->round << "\nWINNER IS " << this->getPlayerInfo(winners[0]) << "\n\n";
+        POKER_HAND_LOG << "Game " << this->game << " ended in round " << this->round << "\nWINNER IS " << this->getPlayerInfo(winners[0]) << "\n\n";
         return true;
     }
     return false;
 }
 
-bool Game::adaptRaiseAttributes(const u_int64_t amount) noexcept {
+template <u_int8_t N, typename Chips>
+bool BasicGame<N, Chips>::adaptRaiseAttributes(const u_int64_t amount) noexcept {
     // returns whether the raise was a full bet
     // minimum raise is the difference between the current bet and the new bet but at least the big blind plus the new bet
     const u_int64_t maxNextRaise = std::max(2 * amount - this->data.betRoundData.currentBet, amount + this->data.roundData.bigBlind);
@@ -812,6 +1456,9 @@ bool Game::adaptRaiseAttributes(const u_int64_t amount) noexcept {
         return true;
     }
     // adjust the minimum raise if necessary
-    this->data.betRoundData.minimumRaise = std::max(this->data.betRoundData.minimumRaise, maxNextRaise);
+    this->data.betRoundData.minimumRaise = std::max<u_int64_t>(this->data.betRoundData.minimumRaise, maxNextRaise);
     return false;
 }
+
+#define INSTANTIATE_GAME(N, CHIPS) template class BasicGame<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_GAME)
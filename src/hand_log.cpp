@@ -0,0 +1,146 @@
+#include "hand_log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+namespace {
+/// @brief A record of a captured hand
+struct CapturedRecord {
+    /// @brief The severity of the record
+    plog::Severity severity;
+    /// @brief The function that logged the record
+    const char* func;
+    /// @brief The line that logged the record
+    size_t line;
+    /// @brief The file that logged the record
+    const char* file;
+    /// @brief The message of the record (keeps its memory for the next hands)
+    std::string message;
+};
+
+/// @brief One of sampleRate hands is logged, 0 for none
+std::atomic<u_int32_t> sampleRate{0};
+/// @brief The triggers that keep the log of a hand (bit i for HandLogTrigger i)
+std::atomic<u_int8_t> triggers{0};
+/// @brief The number of kept hands of all threads
+std::atomic<u_int64_t> loggedHands{0};
+/// @brief The number of hands that the thread started
+thread_local u_int64_t threadHands = 0;
+/// @brief The triggers that fired in the current hand of the thread
+thread_local u_int8_t threadFired = 0;
+/// @brief The captured records of the thread, the first threadNumCaptured are used
+thread_local std::vector<CapturedRecord> threadCaptured;
+/// @brief The number of captured records of the current hand
+thread_local size_t threadNumCaptured = 0;
+
+/// @brief Gets the bit of a trigger
+/// @param trigger The trigger
+/// @return The bit in triggers
+constexpr u_int8_t getTriggerBit(const HandLogTrigger trigger) noexcept { return 1 << static_cast<u_int8_t>(trigger); }
+}  // namespace
+
+bool HandLog::active = false;
+thread_local bool HandLog::detailed = false;
+thread_local bool HandLog::capturing = false;
+
+void HandLog::setSampleRate(const u_int32_t rate) noexcept {
+    sampleRate.store(rate, std::memory_order_relaxed);
+    HandLog::active = rate != 0 || triggers.load(std::memory_order_relaxed) != 0;
+}
+
+void HandLog::addTrigger(const HandLogTrigger trigger) noexcept {
+    triggers.fetch_or(getTriggerBit(trigger), std::memory_order_relaxed);
+    HandLog::active = true;
+}
+
+void HandLog::configure(const std::string& spec) {
+    u_int32_t rate = 0;
+    u_int8_t newTriggers = 0;
+    size_t start = 0;
+    while (start <= spec.size()) {
+        const size_t end = std::min(spec.find(',', start), spec.size());
+        const std::string part = spec.substr(start, end - start);
+        if (part == "allin")
+            newTriggers |= getTriggerBit(HandLogTrigger::ALL_IN_SHOWDOWN);
+        else if (part == "split")
+            newTriggers |= getTriggerBit(HandLogTrigger::SPLIT_POT);
+        else if (part == "illegal")
+            newTriggers |= getTriggerBit(HandLogTrigger::ILLEGAL_MOVE);
+        else if (!part.empty() && rate == 0 && part.find_first_not_of("0123456789") == std::string::npos && part.size() <= 9 && std::stoul(part) != 0)
+            rate = std::stoul(part);
+        else {
+            PLOG_FATAL << "Invalid hand log spec: " << spec << " (comma separated: allin, split, illegal and one sample rate greater than 0)";
+            throw std::invalid_argument("Invalid hand log spec");
+        }
+        start = end + 1;
+    }
+    triggers.store(newTriggers, std::memory_order_relaxed);
+    HandLog::setSampleRate(rate);
+}
+
+void HandLog::reset() noexcept {
+    triggers.store(0, std::memory_order_relaxed);
+    HandLog::setSampleRate(0);
+    loggedHands.store(0, std::memory_order_relaxed);
+}
+
+void HandLog::beginHand() noexcept {
+    const u_int32_t rate = sampleRate.load(std::memory_order_relaxed);
+    const bool sampled = rate != 0 && threadHands % rate == 0;
+    threadHands++;
+    HandLog::capturing = !sampled && triggers.load(std::memory_order_relaxed) != 0;
+    HandLog::detailed = sampled || HandLog::capturing;
+    threadFired = 0;
+    threadNumCaptured = 0;
+    if (sampled) loggedHands.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HandLog::fire(const HandLogTrigger trigger) noexcept { threadFired |= getTriggerBit(trigger); }
+
+void HandLog::endHand() noexcept {
+    HandLog::detailed = false;
+    if (!HandLog::capturing) return;
+    HandLog::capturing = false;
+    const bool keep = (threadFired & triggers.load(std::memory_order_relaxed)) != 0;
+    if (keep) loggedHands.fetch_add(1, std::memory_order_relaxed);
+    if (threadNumCaptured == 0 || plog::get() == nullptr) return;
+    // the records pass the appender again, the thread is not capturing anymore, so detailed decides if the debug records are written
+    HandLog::detailed = keep;
+    for (size_t i = 0; i < threadNumCaptured; i++) {
+        const CapturedRecord& captured = threadCaptured[i];
+        if (!keep && captured.severity > plog::info) continue;
+        plog::Record record(captured.severity, captured.func, captured.line, captured.file, nullptr, 0);
+        record << captured.message;
+        (*plog::get()) += record;
+    }
+    HandLog::detailed = false;
+    threadNumCaptured = 0;
+}
+
+u_int64_t HandLog::getLoggedHands() noexcept { return loggedHands.load(std::memory_order_relaxed); }
+
+void HandLog::capture(const plog::Record& record) noexcept {
+    try {
+        if (threadNumCaptured == threadCaptured.size()) threadCaptured.emplace_back();
+        CapturedRecord& captured = threadCaptured[threadNumCaptured];
+        captured.severity = record.getSeverity();
+        captured.func = record.getFunc();
+        captured.line = record.getLine();
+        captured.file = record.getFile();
+        captured.message.assign(record.getMessage());
+        threadNumCaptured++;
+    } catch (const std::exception&) {
+        // the record is lost, the hand goes on
+    }
+}
+
+void HandLogAppender::write(const plog::Record& record) noexcept {
+    if (HandLog::isCapturing()) {
+        HandLog::capture(record);
+        return;
+    }
+    // the debug records outside of the logged hands (e.g. between the games)
+    if (record.getSeverity() > plog::info && !HandLog::isDetailed()) return;
+    for (plog::IAppender* appender : this->appenders) appender->write(record);
+}
@@ -0,0 +1,124 @@
+#include "icm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+IcmCalculator::IcmCalculator(const std::vector<double>& payouts, const u_int32_t samples, const u_int64_t seed, const u_int32_t cacheSize)
+    : payouts(payouts), samples(samples), seed(seed), cacheSize(cacheSize) {
+    for (const double payout : payouts) {
+        if (!std::isfinite(payout) || payout < 0) {
+            PLOG_FATAL << "Invalid ICM payout: " << payout;
+            throw std::invalid_argument("Invalid ICM payout");
+        }
+    }
+    if (samples == 0) {
+        PLOG_FATAL << "The ICM estimation needs at least one sample";
+        throw std::invalid_argument("The ICM estimation needs at least one sample");
+    }
+}
+
+const std::vector<double>& IcmCalculator::getEquities(const std::vector<u_int64_t>& stacks) {
+    if (this->cacheSize != 0) {
+        const auto cached = this->cache.find(stacks);
+        if (cached != this->cache.end()) {
+            this->cacheHits++;
+            return cached->second;
+        }
+    }
+    this->cacheMisses++;
+    std::vector<double> equities(stacks.size(), 0.0);
+    // the busted players are not part of the field, the exact model only needs the players with chips
+    u_int64_t fieldStacks[MAX_PLAYERS];
+    u_int32_t fieldPlayers[MAX_PLAYERS];
+    u_int32_t fieldSize = 0;
+    for (u_int32_t i = 0; i < stacks.size() && fieldSize <= MAX_PLAYERS; i++) {
+        if (stacks[i] == 0) continue;
+        if (fieldSize < MAX_PLAYERS) {
+            fieldStacks[fieldSize] = stacks[i];
+            fieldPlayers[fieldSize] = i;
+        }
+        fieldSize++;
+    }
+    if (fieldSize <= MAX_PLAYERS) {
+        double fieldEquities[MAX_PLAYERS];
+        IcmCalculator::computeExact(fieldStacks, fieldSize, this->payouts, fieldEquities);
+        for (u_int8_t i = 0; i < fieldSize; i++) equities[fieldPlayers[i]] = fieldEquities[i];
+    } else
+        IcmCalculator::computeMonteCarlo(stacks.data(), stacks.size(), this->payouts, this->samples, this->seed, equities.data());
+
+    if (this->cacheSize == 0) {
+        this->equities = std::move(equities);
+        return this->equities;
+    }
+    if (this->cache.size() >= this->cacheSize) this->cache.clear();
+    return this->cache.emplace(stacks, std::move(equities)).first->second;
+}
+
+void IcmCalculator::computeExact(const u_int64_t stacks[], const u_int8_t numPlayers, const std::vector<double>& payouts, double equities[]) noexcept {
+    std::fill(equities, equities + numPlayers, 0.0);
+    // the subsets are masks of the players with chips
+    double chips[MAX_PLAYERS];
+    u_int8_t players[MAX_PLAYERS];
+    u_int8_t fieldSize = 0;
+    double totalChips = 0;
+    for (u_int8_t i = 0; i < numPlayers; i++) {
+        if (stacks[i] == 0) continue;
+        chips[fieldSize] = stacks[i];
+        players[fieldSize++] = i;
+        totalChips += stacks[i];
+    }
+    const u_int8_t places = std::min<size_t>(payouts.size(), fieldSize);
+    if (places == 0) return;
+
+    const u_int16_t numSubsets = 1 << fieldSize;
+    double prob[1 << MAX_PLAYERS];
+    double placedChips[1 << MAX_PLAYERS];
+    double fieldEquities[MAX_PLAYERS] = {0};
+    std::fill(prob, prob + numSubsets, 0.0);
+    prob[0] = 1;
+    placedChips[0] = 0;
+    // a subset is only reached from smaller masks, so it is complete when it is visited
+    for (u_int16_t placed = 0; placed < numSubsets; placed++) {
+        if (placed != 0) placedChips[placed] = placedChips[placed & (placed - 1)] + chips[__builtin_ctz(placed)];
+        const u_int8_t place = __builtin_popcount(placed);
+        if (place >= places || prob[placed] == 0) continue;
+        // every player that is left takes the next place with the share of its stack in the chips that are left
+        const double factor = prob[placed] / (totalChips - placedChips[placed]);
+        const double payout = payouts[place];
+        for (u_int16_t left = (numSubsets - 1) & ~placed; left != 0; left &= left - 1) {
+            const u_int8_t player = __builtin_ctz(left);
+            const double next = factor * chips[player];
+            prob[placed | (1 << player)] += next;
+            fieldEquities[player] += next * payout;
+        }
+    }
+    for (u_int8_t i = 0; i < fieldSize; i++) equities[players[i]] = fieldEquities[i];
+}
+
+void IcmCalculator::computeMonteCarlo(const u_int64_t stacks[], const u_int32_t numPlayers, const std::vector<double>& payouts, const u_int32_t samples, const u_int64_t seed,
+                                      double equities[]) {
+    std::fill(equities, equities + numPlayers, 0.0);
+    std::vector<u_int32_t> players;
+    std::vector<double> rates;
+    for (u_int32_t i = 0; i < numPlayers; i++) {
+        if (stacks[i] == 0) continue;
+        players.push_back(i);
+        rates.push_back(stacks[i]);
+    }
+    const u_int32_t places = std::min<size_t>(payouts.size(), players.size());
+    if (places == 0) return;
+
+    // the player with the shortest exponential time of rate stack wins with the share of its stack, the others race on for the next places (Malmuth-Harville)
+    Philox rng{seed, 0, 0, RandomStream::ICM};
+    std::vector<double> times(players.size());
+    std::vector<u_int32_t> order(players.size());
+    std::vector<double> prizes(players.size(), 0.0);
+    for (u_int32_t sample = 0; sample < samples; sample++) {
+        for (u_int32_t i = 0; i < players.size(); i++) times[i] = -std::log((rng.next() + 0.5) * 0x1p-32) / rates[i];
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + places, order.end(), [&times](const u_int32_t a, const u_int32_t b) { return times[a] < times[b]; });
+        for (u_int32_t place = 0; place < places; place++) prizes[order[place]] += payouts[place];
+    }
+    for (u_int32_t i = 0; i < players.size(); i++) equities[players[i]] = prizes[i] / samples;
+}
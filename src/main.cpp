@@ -1,7 +1,22 @@
+#include <csignal>
+#include <thread>
+
+#include "alloc_audit.h"
+#include "async_log.h"
+#include "duplicate_runner.h"
 #include "game.h"
+#include "hand_log.h"
 #include "mainargs.h"
+#include "perf_counters.h"
+#include "tournament_runner.h"
+#include "trace.h"
 #include "working_dir.h"
 
+namespace {
+/// @brief The game that is stopped by SIGINT and SIGTERM, so the checkpoint of its run can be resumed
+Game* stoppableGame = nullptr;
+}  // namespace
+
 int main(const int argc, const char** argv) {
     srand(time(NULL));  // init random seed
 
@@ -11,32 +26,220 @@ int main(const int argc, const char** argv) {
     mainArgs.appendDescriptionLine("At default there is no logging, use -v for verbose logging and -i for info logging");
     mainArgs.setFlag('v', "verbose", "Enable verbose logging");
     mainArgs.setFlag('i', "info", "Enable info logging");
+    mainArgs.setFlag('t', "turntime", "Measure the decision time of every player (reported with the statistics)");
+    mainArgs.setNumericArg('b', "budget", 1, INT64_MAX, "The maximum decision time of a player in nanoseconds (the timeout action is played if exceeded)");
+    mainArgs.setFlag('c', "timeoutcall", "Check or call instead of check or fold if a player exceeds the decision time budget");
+    mainArgs.setNumericArg('e', "allinev", 1, UINT32_MAX, "The number of runouts that are evaluated for the all-in EV statistics (all runouts are enumerated if there are not more)");
+    mainArgs.setNumericArg('d', "duplicate", 1, UINT32_MAX, "Compare the players with the given number of duplicate deal sequences (played once per seat rotation)");
+    mainArgs.setFlag('s', "sprt", "Stop as soon as the SPRT decided every pair of players (a gap of 5% in the games won by only one of them, alpha = beta = 0.05)");
+    mainArgs.setStringArg('o', "output", "Stream a record of every game and the summary to a file (format by extension: .csv, .jsonl or .bin)");
+    mainArgs.setNumericArg('p', "progress", 1, 86400, "Print the progress every given number of seconds (also written to progress_game.prom next to the log file)");
+    mainArgs.setNumericArg('r', "trace", 1, UINT32_MAX, "Trace the phases of one of every given number of hands to trace_game.json next to the log file (needs a POKER_TRACING build)");
+    mainArgs.setFlag('x', "perf", "Count instructions, cycles, branch misses and cache misses of the run with the hardware performance counters (Linux, reported per game and hand)");
+    mainArgs.setStringArg('a', "asynclog", "Format and write the log on a background thread, the value is the policy if it falls behind: block, drop or sample (needs -v, -i or -l)");
+    mainArgs.setStringArg('l', "handlog", "Info logging with the debug log of only some hands: comma separated triggers (allin, split, illegal) and a sample rate N for one of every N hands");
+    mainArgs.setNumericArg('n', "seed", 0, INT64_MAX, "The seed of the decks and the player order, a run with the same seed deals the same cards (default: the current time)");
+    mainArgs.setNumericArg('k', "cash", 1, INT16_MAX, "Play cash games of the given number of hands: fixed blinds, stacks topped up before every hand, win rates in bb/100");
+    mainArgs.setNumericArg('m', "tournament", 1, UINT32_MAX, "Play the given number of tournaments of 100 entrants at tables of 10 on all hardware threads and report the finish positions");
+    mainArgs.setNumericArg('w', "checkpoint", 1, INT64_MAX,
+                           "Write a checkpoint every given number of games to checkpoint_game.bin next to the log file \n\t\t(SIGINT and SIGTERM stop the run after the current game)");
+    mainArgs.setFlag('u', "resume", "Resume the run from checkpoint_game.bin next to the log file, with the seed of the checkpoint (not with -o)");
     if (!mainArgs.run()) return 1;
+#ifndef POKER_TRACING
+    if (mainArgs.isArgSet(10)) {
+        std::cerr << "Tracing is not compiled in, configure with -DPOKER_TRACING=ON" << std::endl;
+        return 1;
+    }
+#endif
 
     // init logger
     static plog::ColorConsoleAppender<plog::TxtFormatter> consoleAppender;
     // add file logger
     static plog::RollingFileAppender<plog::TxtFormatter> fileAppender(workingDir.getLogPath().c_str(), 1024 * 1024 * 10, 5);
 
+    // replaces both appenders, the simulation threads only copy the records into its ring
+    static std::unique_ptr<AsyncLogAppender> asyncAppender;
+    if (mainArgs.isArgSet(12)) {
+        if (!mainArgs.isArgSet(0) && !mainArgs.isArgSet(1) && !mainArgs.isArgSet(13)) {
+            std::cerr << "The asynchronous log needs verbose, info or hand logging" << std::endl;
+            return 1;
+        }
+        const std::string overflow = mainArgs.getArgValue(12);
+        if (overflow != "block" && overflow != "drop" && overflow != "sample") {
+            std::cerr << "Unknown asynchronous log policy: " << overflow << " (allowed: block, drop, sample)" << std::endl;
+            return 1;
+        }
+        asyncAppender = std::make_unique<AsyncLogAppender>(overflow == "block" ? LogOverflow::BLOCK : overflow == "drop" ? LogOverflow::DROP : LogOverflow::SAMPLE,
+                                                           workingDir.getLogPath().string(), 1024 * 1024 * 10, 5, true);
+    }
+
     // verbose logging
     if (mainArgs.isArgSet(0)) {
         if (mainArgs.isArgSet(1)) {
             std::cerr << "Cannot set both verbose and info logging arguments" << std::endl;
             return 1;
         }
-        plog::init(plog::verbose, &consoleAppender).addAppender(&fileAppender);
+        if (asyncAppender)
+            plog::init(plog::verbose, asyncAppender.get());
+        else
+            plog::init(plog::verbose, &consoleAppender).addAppender(&fileAppender);
+    }
+    // hand logging, the debug records of the hands that are not kept are dropped or not even formatted
+    static HandLogAppender handLogAppender;
+    if (mainArgs.isArgSet(13)) {
+        if (mainArgs.isArgSet(0)) {
+            std::cerr << "Cannot set both verbose and hand logging arguments" << std::endl;
+            return 1;
+        }
+        try {
+            HandLog::configure(mainArgs.getArgValue(13));
+        } catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << ": " << mainArgs.getArgValue(13) << " (comma separated: allin, split, illegal and one sample rate greater than 0)" << std::endl;
+            return 1;
+        }
+        if (asyncAppender)
+            handLogAppender.addAppender(asyncAppender.get());
+        else
+            handLogAppender.addAppender(&consoleAppender).addAppender(&fileAppender);
+        plog::init(plog::debug, &handLogAppender);
     }
     // info logging
-    if (mainArgs.isArgSet(1)) {
-        plog::init(plog::info, &consoleAppender).addAppender(&fileAppender);
+    if (mainArgs.isArgSet(1) && !mainArgs.isArgSet(13)) {
+        if (asyncAppender)
+            plog::init(plog::info, asyncAppender.get());
+        else
+            plog::init(plog::info, &consoleAppender).addAppender(&fileAppender);
     }
 
     PLOG_INFO << "Starting Application";
+    if (mainArgs.isArgSet(10)) Tracer::setSampleRate(mainArgs.getArgNumericValue(10));
+    // the counters include the threads of the duplicate runner, they are started after the counters are opened
+    std::unique_ptr<PerfCounters> perfCounters;
+    if (mainArgs.isArgSet(11)) perfCounters = std::make_unique<PerfCounters>(true);
 
-    Config config = BaseConfig();
-    Game game{config};
-
-    game.run();
+    // the decks are derived from the seed and the coordinates of the round, so a logged seed replays the run
+    const u_int64_t seed = mainArgs.isArgSet(14) ? mainArgs.getArgNumericValue(14) : time(NULL);
+    PLOG_INFO << "Seed " << seed;
+    Config config = BaseConfig(mainArgs.isArgSet(2), mainArgs.isArgSet(3) ? mainArgs.getArgNumericValue(3) : 0, mainArgs.isArgSet(4) ? Actions::CALL : Actions::FOLD,
+                               mainArgs.isArgSet(5) ? mainArgs.getArgNumericValue(5) : 0, EarlyStopConfig{mainArgs.isArgSet(7) ? StopRule::SPRT : StopRule::NONE});
+    if (mainArgs.isArgSet(6) + mainArgs.isArgSet(15) + mainArgs.isArgSet(16) > 1) {
+        std::cerr << "Cannot set more than one of the duplicate, cash game and tournament arguments" << std::endl;
+        return 1;
+    }
+    if ((mainArgs.isArgSet(17) || mainArgs.isArgSet(18)) && (mainArgs.isArgSet(6) || mainArgs.isArgSet(16))) {
+        std::cerr << "Checkpoints are only written by normal and cash game runs" << std::endl;
+        return 1;
+    }
+    if (mainArgs.isArgSet(18) && mainArgs.isArgSet(8)) {
+        // the records of the games before the checkpoint would be truncated, the games after the last checkpoint would be written twice
+        std::cerr << "A resumed run can not stream its results, the results file would only hold the games after the checkpoint" << std::endl;
+        return 1;
+    }
+    const std::string checkpointPath = (workingDir.getLogPath().parent_path() / "checkpoint_game.bin").string();
+    if (mainArgs.isArgSet(16)) {
+        // the blinds double every 50 hands after the first levels, the big blind ante starts with the second level
+        TournamentConfig tournamentConfig{(u_int32_t)mainArgs.getArgNumericValue(16), 100, config.startingChips[0], {{config.smallBlind, 0, 50}, {2 * config.smallBlind, config.smallBlind, 50}}};
+        tournamentConfig.seed = seed;
+        tournamentConfig.threads = (u_int8_t)std::clamp<unsigned int>(std::thread::hardware_concurrency(), 1, UINT8_MAX);
+        TournamentRunner runner{tournamentConfig};
+        {
+            const PerfScope perfScope{perfCounters.get()};
+            runner.run();
+        }
+        if (perfCounters) perfCounters->logReport("the tournaments", runner.getHandsPlayed(), "hand");
+    } else if (mainArgs.isArgSet(6)) {
+        // every deal sequence is one game, played once per seat rotation on all hardware threads
+        const Config duplicateGameConfig{1, config.numPlayers, config.startingChips[0], config.smallBlind, config.addBlindPerDealer0, false, false, config.maxRounds, config.measureTurnTime,
+                                         config.turnTimeBudget, config.timeoutAction, config.allInEVSamples, config.earlyStop};
+        DuplicateRunner runner{duplicateGameConfig, DuplicateConfig{(u_int32_t)mainArgs.getArgNumericValue(6), seed, DuplicateSeating::ROTATIONS,
+                                                                    (u_int8_t)std::clamp<unsigned int>(std::thread::hardware_concurrency(), 1, UINT8_MAX)}};
+        std::unique_ptr<ProgressReporter> progressReporter;
+        if (mainArgs.isArgSet(9)) {
+            progressReporter = std::make_unique<ProgressReporter>(std::chrono::seconds(mainArgs.getArgNumericValue(9)), (u_int64_t)mainArgs.getArgNumericValue(6) * config.numPlayers,
+                                                                  (workingDir.getLogPath().parent_path() / "progress_game.prom").string());
+            runner.setProgressReporter(progressReporter.get());
+            progressReporter->start();
+        }
+        {
+            const PerfScope perfScope{perfCounters.get()};
+            runner.run();
+        }
+        if (perfCounters) perfCounters->logReport("the duplicate run", (u_int64_t)runner.getDealsPlayed() * runner.getNumSeatings() * duplicateGameConfig.numGames, "game");
+    } else {
+        Game game{config};
+        game.setSeed(seed);
+        // the lineup is seated before the run, so a resume can check it
+        game.setDefaultPlayers();
+        if (mainArgs.isArgSet(18)) {
+            try {
+                game.resume(checkpointPath);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            if (!game.hasDeterministicPlayers())
+                std::cerr << "Warning: the rand and equity players do not draw from the seed, the resumed run will not have the same results as a run without interruption" << std::endl;
+        }
+        // the writer writes the last checkpoint when it is destroyed after the run
+        std::unique_ptr<CheckpointWriter> checkpointWriter;
+        if (mainArgs.isArgSet(17)) {
+            checkpointWriter = std::make_unique<CheckpointWriter>(checkpointPath, mainArgs.getArgNumericValue(17));
+            game.setCheckpointWriter(checkpointWriter.get());
+            stoppableGame = &game;
+            std::signal(SIGINT, [](const int) { stoppableGame->requestStop(); });
+            std::signal(SIGTERM, [](const int) { stoppableGame->requestStop(); });
+        }
+        // the sink writes the remaining records when it is destroyed after the run
+        std::unique_ptr<ResultsSink> resultsSink;
+        if (mainArgs.isArgSet(8)) {
+            try {
+                resultsSink = std::make_unique<ResultsSink>(mainArgs.getArgValue(8), ResultsSink::getFormat(mainArgs.getArgValue(8)), config.numPlayers);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            game.setResultsSink(resultsSink.get());
+        }
+        std::unique_ptr<ProgressReporter> progressReporter;
+        if (mainArgs.isArgSet(9)) {
+            progressReporter = std::make_unique<ProgressReporter>(std::chrono::seconds(mainArgs.getArgNumericValue(9)), config.numGames,
+                                                                  (workingDir.getLogPath().parent_path() / "progress_game.prom").string());
+            progressReporter->watch(game.getProgressCounters());
+            progressReporter->start();
+        }
+        {
+            const PerfScope perfScope{perfCounters.get()};
+            if (mainArgs.isArgSet(15))
+                game.runCash(mainArgs.getArgNumericValue(15), false);
+            else
+                game.run(false);
+        }
+        if (checkpointWriter) {
+            // the game is destroyed at the end of the scope
+            std::signal(SIGINT, SIG_DFL);
+            std::signal(SIGTERM, SIG_DFL);
+        }
+        if (perfCounters) {
+            perfCounters->logReport("the run", game.getGamesPlayed(), "game");
+            perfCounters->logReport("the run", game.getProgressCounters().rounds.get(), "hand");
+        }
+    }
+    if (mainArgs.isArgSet(10)) {
+        // the simulation threads are finished, the ring buffers can be read
+        Tracer::logSummary();
+        if (!Tracer::writeChromeTrace((workingDir.getLogPath().parent_path() / "trace_game.json").string())) return 1;
+    }
+    if (AllocAudit::isEnabled()) {
+        // the threads are finished, their allocations are in the totals
+        AllocAudit::logReport();
+        if (AllocAudit::getAllocations("hand") != 0) {
+            std::cerr << "The per-hand loop allocated " << AllocAudit::getAllocations("hand") << " times" << std::endl;
+            return 1;
+        }
+    }
+    if (HandLog::isActive()) {
+        PLOG_INFO << "Kept the debug log of " << HandLog::getLoggedHands() << " hands";
+    }
 
     PLOG_INFO << "Finished Application";
 
@@ -0,0 +1,133 @@
+#include "perf_counters.h"
+
+#include <cstdio>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/// @brief The names of the counters in the order of PerfValues
+const constexpr char* PERF_EVENT_NAMES[PerfCounters::NUM_EVENTS] = {"instructions", "cycles", "branches", "branch misses", "L1D misses", "LLC misses"};
+
+#ifdef __linux__
+/// @brief The perf event types and configs of the counters in the order of PerfValues
+const constexpr std::pair<u_int32_t, u_int64_t> PERF_EVENT_CONFIGS[PerfCounters::NUM_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+};
+#endif
+}  // namespace
+
+PerfCounters::PerfCounters(const bool inheritThreads) noexcept {
+    for (u_int8_t i = 0; i < NUM_EVENTS; i++) {
+        this->fds[i] = -1;
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_EVENT_CONFIGS[i].first;
+        attr.config = PERF_EVENT_CONFIGS[i].second;
+        attr.disabled = 1;
+        attr.inherit = inheritThreads;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        // the enabled and running times scale the value if the counter was multiplexed
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // the calling thread on any CPU
+        this->fds[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (this->fds[i] < 0) {
+            PLOG_DEBUG << "The perf counter for " << PERF_EVENT_NAMES[i] << " is not available";
+        }
+#else
+        static_cast<void>(inheritThreads);
+#endif
+    }
+    if (!this->isAvailable()) {
+        PLOG_WARNING << "No perf counters are available (Linux only, check /proc/sys/kernel/perf_event_paranoid)";
+    }
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (const int fd : this->fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const noexcept {
+    for (const int fd : this->fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() noexcept {
+#ifdef __linux__
+    for (const int fd : this->fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void PerfCounters::stop() noexcept {
+#ifdef __linux__
+    for (const int fd : this->fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+void PerfCounters::reset() noexcept {
+#ifdef __linux__
+    for (const int fd : this->fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    }
+#endif
+}
+
+PerfValues PerfCounters::read() const noexcept {
+    u_int64_t values[NUM_EVENTS]{};
+#ifdef __linux__
+    for (u_int8_t i = 0; i < NUM_EVENTS; i++) {
+        if (this->fds[i] < 0) continue;
+        // value, time enabled, time running
+        u_int64_t data[3];
+        if (::read(this->fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+        values[i] = data[2] == data[1] ? data[0] : (u_int64_t)((double)data[0] * data[1] / data[2]);
+    }
+#endif
+    return PerfValues{values[0], values[1], values[2], values[3], values[4], values[5]};
+}
+
+void PerfCounters::logReport(const char* phase, const u_int64_t units, const char* unitName) const noexcept {
+    if (!this->isAvailable()) {
+        PLOG_WARNING << "No perf counters for " << phase;
+        return;
+    }
+    const PerfValues values = this->read();
+    const u_int64_t counts[NUM_EVENTS] = {values.instructions, values.cycles, values.branches, values.branchMisses, values.l1dMisses, values.llcMisses};
+    PLOG_INFO << "Perf counters of " << phase << " (" << units << " " << unitName << "s):";
+    for (u_int8_t i = 0; i < NUM_EVENTS; i++) {
+        char line[128];
+        if (this->fds[i] < 0)
+            std::snprintf(line, sizeof(line), "%s: not available", PERF_EVENT_NAMES[i]);
+        else
+            std::snprintf(line, sizeof(line), "%s: %lu (%.2f per %s)", PERF_EVENT_NAMES[i], counts[i], units == 0 ? 0.0 : (double)counts[i] / units, unitName);
+        PLOG_INFO << line;
+    }
+    if (this->fds[0] >= 0 && this->fds[1] >= 0 && values.cycles != 0) {
+        PLOG_INFO << "IPC: " << (double)values.instructions / values.cycles;
+    }
+    if (this->fds[2] >= 0 && this->fds[3] >= 0 && values.branches != 0) {
+        PLOG_INFO << "Branch miss rate: " << 100.0 * values.branchMisses / values.branches << "%";
+    }
+}
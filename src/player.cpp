@@ -1,13 +1,15 @@
 #include "player.h"
 
-const char* Player::getName() const noexcept {
-    static char s[MAX_PLAYER_GET_NAME_LENGTH];
+template <u_int8_t N, typename Chips>
+const char* BasicPlayer<N, Chips>::getName() const noexcept {
+    static thread_local char s[MAX_PLAYER_GET_NAME_LENGTH];
     // format: "playerPosNum:name"
     std::snprintf(s, sizeof(s), "%d:%s", this->playerPosNum, this->name);
     return s;
 }
 
-Player::Player(const char* name) {
+template <u_int8_t N, typename Chips>
+BasicPlayer<N, Chips>::BasicPlayer(const char* name) {
     if (std::strlen(name) > MAX_PLAYER_NAME_LENGTH) {
         PLOG_FATAL << "Player name too long";
         throw std::invalid_argument("Player name too long");
@@ -16,11 +18,15 @@ Player::Player(const char* name) {
     std::strncpy(this->name, name, MAX_PLAYER_NAME_LENGTH);
 }
 
-const char* Player::createPlayerName(const char* name, const u_int8_t playerNum, const bool appendNum) noexcept {
+template <u_int8_t N, typename Chips>
+const char* BasicPlayer<N, Chips>::createPlayerName(const char* name, const u_int8_t playerNum, const bool appendNum) noexcept {
     if (!appendNum) return name;
 
-    static char playerName[MAX_PLAYER_NAME_LENGTH];
+    static thread_local char playerName[MAX_PLAYER_NAME_LENGTH];
     // format: "nameNum"
     std::snprintf(playerName, sizeof(playerName), "%s%d", name, playerNum);
     return playerName;
 };
+
+#define INSTANTIATE_PLAYER(N, CHIPS) template class BasicPlayer<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_PLAYER)
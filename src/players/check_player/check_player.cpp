@@ -1,6 +1,7 @@
 #include "check_player.h"
 
-Action CheckPlayer::turn(const Data& data, const bool blindOption, const bool equalize) const noexcept {
+template <u_int8_t N, typename Chips>
+Action BasicCheckPlayer<N, Chips>::turn(const BasicData<N, Chips>& data, const bool blindOption, const bool equalize) const noexcept {
     Action action;
     // calls the blind option
     if (blindOption) {
@@ -14,4 +15,7 @@ Action CheckPlayer::turn(const Data& data, const bool blindOption, const bool eq
     // checks if possible, otherwise calls if possible, otherwise folds
     action.action = data.betRoundData.currentBet == 0 ? Actions::CHECK : data.getCallAdd() < data.getChips() ? Actions::CALL : Actions::FOLD;
     return action;
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_CHECK_PLAYER(N, CHIPS) template class BasicCheckPlayer<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_CHECK_PLAYER)
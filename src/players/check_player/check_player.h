@@ -3,14 +3,18 @@
 
 /// @brief A player that will play really defensively
 /// @note This player will check if possible, otherwise call if possible, otherwise fold
-class CheckPlayer : public Player {
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+/// @see CheckPlayer for the default table
+template <u_int8_t N, typename Chips>
+class BasicCheckPlayer : public BasicPlayer<N, Chips> {
    public:
     /// @brief Constructor with custom name
     /// @param name The name of the player
     /// @exception Guarantee Strong
     /// @throw std::invalid_argument If the name is too long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the name
-    CheckPlayer(const char* name) : Player(name){};
+    BasicCheckPlayer(const char* name) : BasicPlayer<N, Chips>(name){};
 
     /// @brief Constructor with default name and custom playerNum
     /// @param playerNum The number of the player which will be appended to the default name
@@ -18,7 +22,7 @@ class CheckPlayer : public Player {
     /// @exception Guarantee No-throw
     /// @note Cuts of the name if it is too long, so that the returned string is at most MAX_PLAYER_NAME_LENGTH long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the saved name
-    CheckPlayer(const u_int8_t playerNum, const bool appendNum = true) noexcept : Player(createPlayerName("CheckPlayer", playerNum, appendNum)){};
+    BasicCheckPlayer(const u_int8_t playerNum, const bool appendNum = true) noexcept : BasicPlayer<N, Chips>(BasicPlayer<N, Chips>::createPlayerName("CheckPlayer", playerNum, appendNum)){};
 
     /// @brief Simulates one turn of the check player
     /// @param data The data of the game
@@ -31,5 +35,11 @@ class CheckPlayer : public Player {
     /// @see Player::turn()
     /// @see Data
     /// @see Action
-    Action turn(const Data& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
-};
\ No newline at end of file
+    Action turn(const BasicData<N, Chips>& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
+
+    /// @copydoc BasicPlayer::isDeterministic()
+    bool isDeterministic() const noexcept override { return true; }
+};
+
+/// @brief The CheckPlayer of the default table
+using CheckPlayer = BasicCheckPlayer<MAX_PLAYERS, u_int64_t>;
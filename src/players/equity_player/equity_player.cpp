@@ -0,0 +1,145 @@
+#include "equity_player.h"
+
+#include <chrono>
+#include <thread>
+
+#include "hand_strengths.h"
+
+template <u_int8_t N, typename Chips>
+Action BasicEquityPlayer<N, Chips>::turn(const BasicData<N, Chips>& data, const bool blindOption, const bool equalize) const noexcept {
+    Action action;
+    const u_int8_t communityNum = data.roundData.betRoundState == BetRoundState::PREFLOP ? 0
+                                  : data.roundData.betRoundState == BetRoundState::FLOP  ? 3
+                                  : data.roundData.betRoundState == BetRoundState::TURN  ? 4
+                                                                                         : 5;
+    // every active player (not folded, not out, all-in included) except this player is a live opponent
+    const double equity = estimateEquity(this->getHand(), data.roundData.communityCards, communityNum, data.roundData.numActivePlayers - 1, this->samples, this->timeBudget, this->threads,
+                                         ((u_int64_t)std::rand() << 32) | std::rand());
+    const u_int64_t callAdd = data.getCallAdd();
+    const u_int64_t chips = data.getChips();
+    // the share of the pot (after calling) that the player has to pay
+    const double potOdds = callAdd == 0 ? 0 : (double)callAdd / (data.roundData.pot + callAdd);
+    const double fairShare = 1.0 / data.roundData.numActivePlayers;
+
+    if (equalize) {
+        // only call, fold or all-in (not higher than the current bet) are allowed
+        action.action = equity < potOdds ? Actions::FOLD : callAdd < chips ? Actions::CALL : Actions::ALL_IN;
+        return action;
+    }
+    if (equity >= fairShare + (1 - fairShare) * EQUITY_PLAYER_RAISE_EDGE) {
+        // strong hand, bet or raise the equity share of the pot
+        const u_int64_t bet = std::max<u_int64_t>(data.betRoundData.minimumRaise, data.betRoundData.currentBet + (u_int64_t)(equity * data.roundData.pot));
+        if (data.getRaiseAdd(bet) < chips) {
+            action.action = data.betRoundData.currentBet == 0 ? Actions::BET : Actions::RAISE;
+            action.bet = bet;
+        } else
+            action.action = Actions::ALL_IN;
+        return action;
+    }
+    if (blindOption) {
+        // the blind option is free to call
+        action.action = Actions::CALL;
+    } else if (data.betRoundData.currentBet == 0) {
+        action.action = Actions::CHECK;
+    } else if (equity >= potOdds) {
+        // the equity covers the pot odds, call or all-in if the call is not affordable
+        action.action = callAdd < chips ? Actions::CALL : Actions::ALL_IN;
+    } else
+        action.action = Actions::FOLD;
+    return action;
+}
+
+template <u_int8_t N, typename Chips>
+double BasicEquityPlayer<N, Chips>::estimateEquity(const std::pair<Card, Card>& hand, const Card communityCards[], const u_int8_t communityNum, const u_int8_t opponents, const u_int32_t samples,
+                                                   const u_int64_t timeBudget, const u_int8_t threads, const u_int64_t seed) noexcept {
+    // without opponents the player wins the whole pot
+    if (opponents == 0) return 1;
+    // collect all cards that are not known to the player
+    Card unknownCards[CARD_NUM];
+    u_int8_t unknownNum = 0;
+    for (u_int8_t suit = 0; suit < 4; suit++) {
+        for (u_int8_t rank = 2; rank < 15; rank++) {
+            const Card card{rank, suit};
+            if (card == hand.first || card == hand.second || std::find(communityCards, communityCards + communityNum, card) != communityCards + communityNum) continue;
+            unknownCards[unknownNum++] = card;
+        }
+    }
+
+    double shareSum = 0;
+    u_int64_t sampleCount = 0;
+    if (threads <= 1 || samples < threads) {
+        sampleShares(hand, communityCards, communityNum, opponents, unknownCards, unknownNum, samples, timeBudget, seed, shareSum, sampleCount);
+    } else {
+        // every thread samples its own share of the runouts with its own seed, the calling thread takes the remainder
+        double shareSums[EQUITY_PLAYER_MAX_THREADS]{};
+        u_int64_t sampleCounts[EQUITY_PLAYER_MAX_THREADS]{};
+        std::thread workers[EQUITY_PLAYER_MAX_THREADS - 1];
+        u_int8_t started = 0;
+        try {
+            for (; started < threads - 1; started++) {
+                workers[started] = std::thread(sampleShares, std::cref(hand), communityCards, communityNum, opponents, unknownCards, unknownNum, samples / threads, timeBudget,
+                                               seed + (started + 1) * 0x9E3779B97F4A7C15ULL, std::ref(shareSums[started]), std::ref(sampleCounts[started]));
+            }
+        } catch (const std::system_error& e) {
+            PLOG_WARNING << "EquityPlayer could only start " << +started << " sampling threads: " << e.what();
+        }
+        // the calling thread also samples the runouts of the threads that could not be started
+        sampleShares(hand, communityCards, communityNum, opponents, unknownCards, unknownNum, samples - started * (samples / threads), timeBudget, seed, shareSum, sampleCount);
+        for (u_int8_t i = 0; i < started; i++) {
+            workers[i].join();
+            shareSum += shareSums[i];
+            sampleCount += sampleCounts[i];
+        }
+    }
+    return sampleCount == 0 ? 0 : shareSum / sampleCount;
+}
+
+template <u_int8_t N, typename Chips>
+void BasicEquityPlayer<N, Chips>::sampleShares(const std::pair<Card, Card>& hand, const Card communityCards[], const u_int8_t communityNum, const u_int8_t opponents, const Card unknownCards[],
+                                               const u_int8_t unknownNum, const u_int32_t samples, const u_int64_t timeBudget, u_int64_t seed, double& shareSum, u_int64_t& sampleCount) noexcept {
+    // local copies, the cards are partially shuffled in place for every sample
+    Card deck[CARD_NUM];
+    std::copy(unknownCards, unknownCards + unknownNum, deck);
+    Card board[5];
+    std::copy(communityCards, communityCards + communityNum, board);
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeBudget);
+    // xorshift64* generator, the seed must not be 0
+    if (seed == 0) seed = 0x9E3779B97F4A7C15ULL;
+    double shares = 0;
+    u_int32_t s = 0;
+    for (; s < samples; s++) {
+        // check the time budget every 64 samples (at least one sample is always taken)
+        if (timeBudget != 0 && s != 0 && (s & 63) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+        // draw cards from the end of the deck (partial Fisher-Yates shuffle)
+        u_int8_t left = unknownNum;
+        auto draw = [&]() noexcept {
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            const u_int8_t ind = ((seed * 0x2545F4914F6CDD1DULL) >> 32) % left;
+            left--;
+            std::swap(deck[ind], deck[left]);
+            return deck[left];
+        };
+        for (u_int8_t i = communityNum; i < 5; i++) board[i] = draw();
+        const HandStrengths ownStrength = HandStrengths::getHandStrength(hand, board);
+        u_int8_t splits = 1;
+        bool lost = false;
+        for (u_int8_t i = 0; i < opponents; i++) {
+            const Card first = draw();
+            const HandStrengths opponentStrength = HandStrengths::getHandStrength(std::pair<Card, Card>{first, draw()}, board);
+            if (opponentStrength > ownStrength) {
+                // the hands of the remaining opponents do not matter
+                lost = true;
+                break;
+            } else if (opponentStrength == ownStrength)
+                splits++;
+        }
+        if (!lost) shares += 1.0 / splits;
+    }
+    shareSum += shares;
+    sampleCount += s;
+}
+
+#define INSTANTIATE_EQUITY_PLAYER(N, CHIPS) template class BasicEquityPlayer<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_EQUITY_PLAYER)
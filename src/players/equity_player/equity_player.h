@@ -0,0 +1,120 @@
+#pragma once
+#include "player.h"
+
+/// @brief The default number of sampled runouts per decision of the equity player
+const constexpr u_int32_t EQUITY_PLAYER_DEFAULT_SAMPLES = 500;
+/// @brief The share of the equity above the fair share (1 / active players) that is required to bet or raise
+/// @note 0 means the player raises with every hand that is better than average, 1 means the player never raises
+const constexpr double EQUITY_PLAYER_RAISE_EDGE = 0.4;
+/// @brief The maximum number of threads the equity player uses to sample runouts
+const constexpr u_int8_t EQUITY_PLAYER_MAX_THREADS = 64;
+
+/// @brief A player that estimates its equity with Monte Carlo sampling and plays according to the pot odds
+/// @note For every decision the remaining community cards and the hands of the live opponents are sampled from the unknown cards
+/// @note Calls if the equity covers the pot odds, bets or raises if the equity is clearly above the fair share, otherwise checks or folds
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+/// @see EquityPlayer for the default table
+template <u_int8_t N, typename Chips>
+class BasicEquityPlayer : public BasicPlayer<N, Chips> {
+   public:
+    /// @brief Constructor with custom name
+    /// @param name The name of the player
+    /// @param samples The number of sampled runouts per decision (maximum if a time budget is set)
+    /// @param timeBudget The maximum sampling time in nanoseconds per decision. 0 means no limit (only samples are considered)
+    /// @param threads The number of threads that are used to sample the runouts
+    /// @exception Guarantee Strong
+    /// @throw std::invalid_argument If the name is too long
+    /// @throw std::invalid_argument If samples is 0 or threads is not in [1, EQUITY_PLAYER_MAX_THREADS]
+    /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the name
+    BasicEquityPlayer(const char* name, const u_int32_t samples = EQUITY_PLAYER_DEFAULT_SAMPLES, const u_int64_t timeBudget = 0, const u_int8_t threads = 1)
+        : BasicPlayer<N, Chips>(name), samples(samples), timeBudget(timeBudget), threads(threads) {
+        this->checkSettings();
+    };
+
+    /// @brief Constructor with default name and custom playerNum
+    /// @param playerNum The number of the player which will be appended to the default name
+    /// @param appendNum If true, the player number will be appended to the default name
+    /// @param samples The number of sampled runouts per decision (maximum if a time budget is set)
+    /// @param timeBudget The maximum sampling time in nanoseconds per decision. 0 means no limit (only samples are considered)
+    /// @param threads The number of threads that are used to sample the runouts
+    /// @exception Guarantee Strong
+    /// @throw std::invalid_argument If samples is 0 or threads is not in [1, EQUITY_PLAYER_MAX_THREADS]
+    /// @note Cuts of the name if it is too long, so that the returned string is at most MAX_PLAYER_NAME_LENGTH long
+    /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the saved name
+    BasicEquityPlayer(const u_int8_t playerNum, const bool appendNum = true, const u_int32_t samples = EQUITY_PLAYER_DEFAULT_SAMPLES, const u_int64_t timeBudget = 0, const u_int8_t threads = 1)
+        : BasicPlayer<N, Chips>(BasicPlayer<N, Chips>::createPlayerName("EquityPlayer", playerNum, appendNum)), samples(samples), timeBudget(timeBudget), threads(threads) {
+        this->checkSettings();
+    };
+
+    /// @brief Simulates one turn of the equity player
+    /// @param data The data of the game
+    /// @param blindOption If true, the player has the blind option (can only call, raise or all-in)
+    /// @param equalize If true, the player has to equalize the last bet (can only call (bet), fold or all-in (not higher than last bet))
+    /// @return The Action of the player
+    /// @exception Guarantee No-throw
+    /// @note The method is const because it should not change the state of the player
+    /// @note This method is overridden from the Player class
+    /// @see Player::turn()
+    /// @see Data
+    /// @see Action
+    Action turn(const BasicData<N, Chips>& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
+
+    /// @brief Estimates the equity of a hand against a number of opponents with random hands
+    /// @param hand The hand of the player
+    /// @param communityCards The known community cards
+    /// @param communityNum The number of known community cards (0, 3, 4 or 5)
+    /// @param opponents The number of live opponents
+    /// @param samples The number of sampled runouts (maximum if a time budget is set)
+    /// @param timeBudget The maximum sampling time in nanoseconds. 0 means no limit
+    /// @param threads The number of threads that are used to sample the runouts
+    /// @param seed The seed for the random number generator
+    /// @return The expected share of the pot (0-1), splits are counted as the fraction of the pot that is won
+    /// @exception Guarantee No-throw
+    /// @note Falls back to sampling on the calling thread if the threads could not be started
+    /// @note Undefined behavior if the cards are not distinct or opponents is too high for the remaining cards
+    /// @see HandStrengths::getHandStrength()
+    static double estimateEquity(const std::pair<Card, Card>& hand, const Card communityCards[], const u_int8_t communityNum, const u_int8_t opponents, const u_int32_t samples,
+                                 const u_int64_t timeBudget = 0, const u_int8_t threads = 1, const u_int64_t seed = 1) noexcept;
+
+   private:
+    /// @brief Checks the sampling settings
+    /// @exception Guarantee Strong
+    /// @throw std::invalid_argument If samples is 0 or threads is not in [1, EQUITY_PLAYER_MAX_THREADS]
+    void checkSettings() const {
+        if (this->samples == 0) {
+            PLOG_FATAL << "EquityPlayer needs at least one sample per decision";
+            throw std::invalid_argument("EquityPlayer needs at least one sample per decision");
+        }
+        if (this->threads == 0 || this->threads > EQUITY_PLAYER_MAX_THREADS) {
+            PLOG_FATAL << "Invalid number of EquityPlayer threads: " << +this->threads << " (min: 1, max: " << +EQUITY_PLAYER_MAX_THREADS << ")";
+            throw std::invalid_argument("Invalid number of EquityPlayer threads");
+        }
+    }
+
+    /// @brief Samples runouts on the calling thread and sums up the won pot shares
+    /// @param hand The hand of the player
+    /// @param communityCards The known community cards
+    /// @param communityNum The number of known community cards
+    /// @param opponents The number of live opponents
+    /// @param unknownCards The cards that are not known to the player
+    /// @param unknownNum The number of unknown cards
+    /// @param samples The number of sampled runouts (maximum if a time budget is set)
+    /// @param timeBudget The maximum sampling time in nanoseconds. 0 means no limit
+    /// @param seed The seed for the random number generator
+    /// @param shareSum Is increased by the won pot share of every sample
+    /// @param sampleCount Is increased by the number of samples
+    /// @exception Guarantee No-throw
+    static void sampleShares(const std::pair<Card, Card>& hand, const Card communityCards[], const u_int8_t communityNum, const u_int8_t opponents, const Card unknownCards[],
+                             const u_int8_t unknownNum, const u_int32_t samples, const u_int64_t timeBudget, u_int64_t seed, double& shareSum, u_int64_t& sampleCount) noexcept;
+
+    /// @brief The number of sampled runouts per decision
+    const u_int32_t samples;
+    /// @brief The maximum sampling time in nanoseconds per decision (0 means no limit)
+    const u_int64_t timeBudget;
+    /// @brief The number of threads that are used to sample the runouts
+    const u_int8_t threads;
+};
+
+/// @brief The EquityPlayer of the default table
+using EquityPlayer = BasicEquityPlayer<MAX_PLAYERS, u_int64_t>;
@@ -1,6 +1,7 @@
 #include "human_player.h"
 
-Action HumanPlayer::turn(const Data& data, const bool blindOption, const bool equalize) const noexcept {
+template <u_int8_t N, typename Chips>
+Action BasicHumanPlayer<N, Chips>::turn(const BasicData<N, Chips>& data, const bool blindOption, const bool equalize) const noexcept {
     // prints the current state of the game
     std::cout << "Your hand: " << this->getHand().first.toString() << " " << this->getHand().second.toString();
     // prints the community cards
@@ -61,4 +62,7 @@ Action HumanPlayer::turn(const Data& data, const bool blindOption, const bool eq
             std::cout << "Invalid input! Try again" << std::endl;
         }
     }
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_HUMAN_PLAYER(N, CHIPS) template class BasicHumanPlayer<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_HUMAN_PLAYER)
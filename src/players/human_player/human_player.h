@@ -4,14 +4,18 @@
 /// @brief A player that will be controlled by a human
 /// @note This player will ask the user every turn what to do
 /// @note Should not be used in a simulation, because it will wait for user input
-class HumanPlayer : public Player {
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+/// @see HumanPlayer for the default table
+template <u_int8_t N, typename Chips>
+class BasicHumanPlayer : public BasicPlayer<N, Chips> {
    public:
     /// @brief Constructor with custom name
     /// @param name The name of the player
     /// @exception Guarantee Strong
     /// @throw std::invalid_argument If the name is too long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the name
-    HumanPlayer(const char* name) : Player(name){};
+    BasicHumanPlayer(const char* name) : BasicPlayer<N, Chips>(name){};
 
     /// @brief Constructor with default name and custom playerNum
     /// @param playerNum The number of the player which will be appended to the default name
@@ -19,7 +23,7 @@ class HumanPlayer : public Player {
     /// @exception Guarantee No-throw
     /// @note Cuts of the name if it is too long, so that the returned string is at most MAX_PLAYER_NAME_LENGTH long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the saved name
-    HumanPlayer(const u_int8_t playerNum, const bool appendNum = true) noexcept : Player(createPlayerName("HumanPlayer", playerNum, appendNum)){};
+    BasicHumanPlayer(const u_int8_t playerNum, const bool appendNum = true) noexcept : BasicPlayer<N, Chips>(BasicPlayer<N, Chips>::createPlayerName("HumanPlayer", playerNum, appendNum)){};
 
     /// @brief Ask the user what to do
     /// @param data The data of the game
@@ -33,5 +37,8 @@ class HumanPlayer : public Player {
     /// @see Player::turn()
     /// @see Data
     /// @see Action
-    Action turn(const Data& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
-};
\ No newline at end of file
+    Action turn(const BasicData<N, Chips>& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
+};
+
+/// @brief The HumanPlayer of the default table
+using HumanPlayer = BasicHumanPlayer<MAX_PLAYERS, u_int64_t>;
@@ -1,6 +1,7 @@
 #include "rand_player.h"
 
-Action RandPlayer::turn(const Data& data, const bool blindOption, const bool equalize) const noexcept {
+template <u_int8_t N, typename Chips>
+Action BasicRandPlayer<N, Chips>::turn(const BasicData<N, Chips>& data, const bool blindOption, const bool equalize) const noexcept {
     Action action;
     // control the possible actions with randMod
     u_int8_t randMod = 100;
@@ -54,4 +55,7 @@ Action RandPlayer::turn(const Data& data, const bool blindOption, const bool equ
     }
 
     return action;
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_RAND_PLAYER(N, CHIPS) template class BasicRandPlayer<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_RAND_PLAYER)
@@ -1,9 +1,13 @@
 #include "test_player.h"
 
-Action TestPlayer::turn(const Data&, const bool, const bool) const noexcept {
+template <u_int8_t N, typename Chips>
+Action BasicTestPlayer<N, Chips>::turn(const BasicData<N, Chips>&, const bool, const bool) const noexcept {
     if (this->actionIndex == 0) {
         std::cout << "TestPlayer(" << this->name << ") took to many actions. GO AND FIX YOUR TEST" << std::endl;
         return Action{Actions::FOLD, 0};
     }
     return this->actions[--this->actionIndex];
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE_TEST_PLAYER(N, CHIPS) template class BasicTestPlayer<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_TEST_PLAYER)
@@ -6,14 +6,18 @@ const constexpr u_int16_t TEST_PLAYER_ACTION_SIZE = 10;
 
 /// @brief A player that will play a given sequence of actions
 /// @note This player is used for testing purposes only
-class TestPlayer : public Player {
+/// @tparam N The number of seats at the table
+/// @tparam Chips The unsigned integer type that stores chip amounts
+/// @see TestPlayer for the default table
+template <u_int8_t N, typename Chips>
+class BasicTestPlayer : public BasicPlayer<N, Chips> {
    public:
     /// @brief Constructor with custom name
     /// @param name The name of the player
     /// @exception Guarantee Strong
     /// @throw std::invalid_argument If the name is too long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the name
-    TestPlayer(const char* name) : Player(name){};
+    BasicTestPlayer(const char* name) : BasicPlayer<N, Chips>(name){};
 
     /// @brief Constructor with default name and custom playerNum
     /// @param playerNum The number of the player which will be appended to the default name
@@ -21,7 +25,7 @@ class TestPlayer : public Player {
     /// @exception Guarantee No-throw
     /// @note Cuts of the name if it is too long, so that the returned string is at most MAX_PLAYER_NAME_LENGTH long
     /// @see MAX_PLAYER_NAME_LENGTH for the maximum length of the saved name
-    TestPlayer(const u_int8_t playerNum, const bool appendNum = true) noexcept : Player(createPlayerName("TestPlayer", playerNum, appendNum)){};
+    BasicTestPlayer(const u_int8_t playerNum, const bool appendNum = true) noexcept : BasicPlayer<N, Chips>(BasicPlayer<N, Chips>::createPlayerName("TestPlayer", playerNum, appendNum)){};
 
     /// @brief Simulates one turn of the rand player
     /// @param data The data of the game
@@ -35,7 +39,7 @@ class TestPlayer : public Player {
     /// @see Player::turn()
     /// @see Data
     /// @see Action
-    Action turn(const Data& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
+    Action turn(const BasicData<N, Chips>& data, const bool blindOption = false, const bool equalize = false) const noexcept override;
 
     /// @brief Sets the sequence of actions that will be returned by the turn method
     /// @param actions sequence of actions
@@ -63,4 +67,7 @@ class TestPlayer : public Player {
     /// @note The index - 1 is the index of the next action that will be returned
     /// @note The index is equal to zero if the sequence is finished
     mutable u_int16_t actionIndex = 0;
-};
\ No newline at end of file
+};
+
+/// @brief The TestPlayer of the default table
+using TestPlayer = BasicTestPlayer<MAX_PLAYERS, u_int64_t>;
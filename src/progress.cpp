@@ -0,0 +1,106 @@
+#include "progress.h"
+
+#include <cstdio>
+#include <fstream>
+
+void ProgressReporter::watch(const ProgressCounters& counters) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->watched.push_back(&counters);
+}
+
+ProgressCounters& ProgressReporter::createCounters() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ProgressCounters& counters = this->owned.emplace_back();
+    this->watched.push_back(&counters);
+    return counters;
+}
+
+void ProgressReporter::start() {
+    this->lastTime = std::chrono::steady_clock::now();
+    this->reporter = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (!this->stopCondition.wait_for(lock, this->interval, [this]() { return this->stopping; })) {
+            lock.unlock();
+            this->report();
+            lock.lock();
+        }
+    });
+}
+
+void ProgressReporter::stop() noexcept {
+    if (!this->reporter.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->stopCondition.notify_one();
+    this->reporter.join();
+    this->report();
+}
+
+void ProgressReporter::report() noexcept {
+    const Totals totals = this->getTotals();
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(now - this->lastTime).count();
+    const double gamesPerSecond = seconds > 0 ? (totals.games - this->lastTotals.games) / seconds : 0;
+    const double roundsPerSecond = seconds > 0 ? (totals.rounds - this->lastTotals.rounds) / seconds : 0;
+    // the remaining games at the current rate
+    const double eta = this->totalGames == 0 || gamesPerSecond == 0 ? -1 : (this->totalGames - std::min(totals.games, this->totalGames)) / gamesPerSecond;
+    char line[256];
+    int length = std::snprintf(line, sizeof(line), "Progress: %lu", totals.games);
+    if (this->totalGames != 0) length += std::snprintf(line + length, sizeof(line) - length, "/%lu (%.1f%%)", this->totalGames, 100.0 * totals.games / this->totalGames);
+    length += std::snprintf(line + length, sizeof(line) - length, " games, %.1f games/s, %.1f hands/s, %lu actions, %lu showdowns, %lu all-in settlements, %lu evaluations", gamesPerSecond,
+                            roundsPerSecond, totals.actions, totals.showdowns, totals.allInSettlements, totals.evaluations);
+    if (eta >= 0) {
+        const u_int64_t etaSeconds = eta;
+        std::snprintf(line + length, sizeof(line) - length, ", ETA %luh %02lum %02lus", etaSeconds / 3600, etaSeconds / 60 % 60, etaSeconds % 60);
+    }
+    std::cerr << line << std::endl;
+    if (!this->metricsPath.empty()) this->writeMetrics(totals, gamesPerSecond, roundsPerSecond, eta);
+    this->lastTotals = totals;
+    this->lastTime = now;
+}
+
+ProgressReporter::Totals ProgressReporter::getTotals() noexcept {
+    Totals totals{};
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (const ProgressCounters* counters : this->watched) {
+        totals.games += counters->games.get();
+        totals.rounds += counters->rounds.get();
+        totals.actions += counters->actions.get();
+        totals.showdowns += counters->showdowns.get();
+        totals.allInSettlements += counters->allInSettlements.get();
+        totals.evaluations += counters->evaluations.get();
+    }
+    return totals;
+}
+
+void ProgressReporter::writeMetrics(const Totals& totals, const double gamesPerSecond, const double roundsPerSecond, const double eta) noexcept {
+    const std::string tmpPath = this->metricsPath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        if (!file.is_open()) {
+            PLOG_WARNING << "Could not write the progress metrics to " << tmpPath;
+            return;
+        }
+        auto counter = [&file](const char* name, const char* help, const u_int64_t value) {
+            file << "# HELP poker_" << name << "_total " << help << "\n# TYPE poker_" << name << "_total counter\npoker_" << name << "_total " << value << '\n';
+        };
+        auto gauge = [&file](const char* name, const char* help, const double value) {
+            file << "# HELP poker_" << name << ' ' << help << "\n# TYPE poker_" << name << " gauge\npoker_" << name << ' ' << value << '\n';
+        };
+        counter("games", "Finished games", totals.games);
+        counter("rounds", "Started rounds (hands)", totals.rounds);
+        counter("actions", "Player actions", totals.actions);
+        counter("showdowns", "Rounds that ended in a showdown", totals.showdowns);
+        counter("allin_settlements", "Showdowns settled with all-in players", totals.allInSettlements);
+        counter("evaluations", "Hand evaluations", totals.evaluations);
+        gauge("games_per_second", "Games per second since the previous report", gamesPerSecond);
+        gauge("hands_per_second", "Rounds per second since the previous report", roundsPerSecond);
+        if (this->totalGames != 0) gauge("games_target", "Games of the run", this->totalGames);
+        if (eta >= 0) gauge("eta_seconds", "Estimated remaining seconds", eta);
+    }
+    if (std::rename(tmpPath.c_str(), this->metricsPath.c_str()) != 0) {
+        PLOG_WARNING << "Could not write the progress metrics to " << this->metricsPath;
+    }
+}
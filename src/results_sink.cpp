@@ -0,0 +1,206 @@
+#include "results_sink.h"
+
+#include <limits>
+
+ResultsSink::ResultsSink(const std::string& path, const ResultsFormat format, const u_int8_t numPlayers)
+    : format(format), numPlayers(numPlayers), fileBuffer(new char[RESULTS_SINK_FILE_BUFFER]) {
+    if (numPlayers < 2 || numPlayers > MAX_SEATS) {
+        PLOG_FATAL << "Invalid number of players for the results sink: " << +numPlayers << " (min: 2, max: " << +MAX_SEATS << ")";
+        throw std::invalid_argument("Invalid number of players for the results sink");
+    }
+    // the buffer has to be set before the file is opened
+    this->file.rdbuf()->pubsetbuf(this->fileBuffer.get(), RESULTS_SINK_FILE_BUFFER);
+    this->file.open(path, format == ResultsFormat::BINARY ? std::ios::binary | std::ios::trunc : std::ios::trunc);
+    if (!this->file.is_open()) {
+        PLOG_FATAL << "Could not open the results file " << path;
+        throw std::invalid_argument("Could not open the results file " + path);
+    }
+    this->file.precision(std::numeric_limits<double>::max_digits10);
+    for (Batch& batch : this->batches) batch.games.reserve(RESULTS_SINK_BATCH_SIZE);
+    this->current = &this->batches[0];
+    for (u_int8_t i = RESULTS_SINK_BATCHES - 1; i > 0; i--) this->freeBatches.push_back(&this->batches[i]);
+    this->writeHeader();
+    this->writer = std::thread(&ResultsSink::writeBatches, this);
+    PLOG_INFO << "Writing " << EnumToString::enumToString(format) << " results to " << path;
+}
+
+void ResultsSink::addGame(const GameRecord& record) noexcept {
+    if (this->closed) return;
+    this->current->games.push_back(record);
+    if (this->current->games.size() == RESULTS_SINK_BATCH_SIZE) this->handOff();
+}
+
+void ResultsSink::addSummary(const SummaryRecord& summary) noexcept {
+    if (this->closed) return;
+    // the summary ends the batch, so it is written right after the games of the run
+    this->current->hasSummary = true;
+    this->current->summary = summary;
+    this->handOff();
+}
+
+void ResultsSink::close() noexcept {
+    if (this->closed) return;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (!this->current->games.empty() || this->current->hasSummary) this->fullBatches.push_back(this->current);
+        this->closing = true;
+    }
+    this->writerCondition.notify_one();
+    this->writer.join();
+    this->file.close();
+    this->closed = true;
+    if (this->stalls != 0) {
+        PLOG_WARNING << "The results writer was behind, the simulation waited " << this->stalls << " times";
+    }
+}
+
+void ResultsSink::handOff() noexcept {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->fullBatches.push_back(this->current);
+    this->writerCondition.notify_one();
+    if (this->freeBatches.empty()) {
+        // all batches wait for the writer thread, wait instead of growing the memory
+        this->stalls++;
+        this->freeCondition.wait(lock, [this]() { return !this->freeBatches.empty(); });
+    }
+    this->current = this->freeBatches.back();
+    this->freeBatches.pop_back();
+}
+
+void ResultsSink::writeBatches() noexcept {
+    while (true) {
+        Batch* batch;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->writerCondition.wait(lock, [this]() { return !this->fullBatches.empty() || this->closing; });
+            // the remaining batches are written before the thread stops
+            if (this->fullBatches.empty()) break;
+            batch = this->fullBatches.front();
+            this->fullBatches.pop_front();
+        }
+        for (const GameRecord& record : batch->games) this->writeGame(record);
+        if (batch->hasSummary) this->writeSummary(batch->summary);
+        batch->games.clear();
+        batch->hasSummary = false;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->freeBatches.push_back(batch);
+        }
+        this->freeCondition.notify_one();
+    }
+    this->file.flush();
+}
+
+void ResultsSink::writeHeader() noexcept {
+    switch (this->format) {
+        case ResultsFormat::CSV:
+            // the player columns contain the chip deltas of the games and the per player values of the summary rows
+            this->file << "type,game,rounds,winners";
+            for (u_int8_t i = 0; i < this->numPlayers; i++) this->file << ",player" << +i;
+            this->file << '\n';
+            break;
+        case ResultsFormat::JSONL:
+            break;
+        case ResultsFormat::BINARY:
+            this->file.write(RESULTS_SINK_BINARY_MAGIC, constexpr_strlen(RESULTS_SINK_BINARY_MAGIC));
+            this->writeBinary(RESULTS_SINK_BINARY_VERSION);
+            this->writeBinary(this->numPlayers);
+            break;
+    }
+}
+
+void ResultsSink::writeGame(const GameRecord& record) noexcept {
+    switch (this->format) {
+        case ResultsFormat::CSV: {
+            this->file << "game," << record.game << ',' << record.rounds << ',';
+            // the ids of the winners separated by spaces
+            bool first = true;
+            for (u_int8_t i = 0; i < this->numPlayers; i++) {
+                if (!(record.winners & (1u << i))) continue;
+                if (!first) this->file << ' ';
+                first = false;
+                this->file << +i;
+            }
+            this->writeValues(record.chipDeltas);
+            this->file << '\n';
+            break;
+        }
+        case ResultsFormat::JSONL: {
+            this->file << "{\"type\":\"game\",\"game\":" << record.game << ",\"rounds\":" << record.rounds << ",\"winners\":[";
+            bool first = true;
+            for (u_int8_t i = 0; i < this->numPlayers; i++) {
+                if (!(record.winners & (1u << i))) continue;
+                if (!first) this->file << ',';
+                first = false;
+                this->file << +i;
+            }
+            this->file << "],\"chipDeltas\":";
+            this->writeValues(record.chipDeltas);
+            this->file << "}\n";
+            break;
+        }
+        case ResultsFormat::BINARY:
+            this->writeBinary('G');
+            this->writeBinary(record.game);
+            this->writeBinary(record.rounds);
+            this->writeBinary(record.winners);
+            this->file.write(reinterpret_cast<const char*>(record.chipDeltas), sizeof(int64_t) * this->numPlayers);
+            break;
+    }
+}
+
+void ResultsSink::writeSummary(const SummaryRecord& summary) noexcept {
+    switch (this->format) {
+        case ResultsFormat::CSV:
+            // one row per statistic, the values of the players are in the player columns
+            this->file << "gameWins," << summary.games << ",,";
+            this->writeValues(summary.gameWins);
+            this->file << "\nchipWins," << summary.games << ",,";
+            this->writeValues(summary.chipWins);
+            this->file << "\nchipWinsAmount," << summary.games << ",,";
+            this->writeValues(summary.chipWinsAmount);
+            this->file << "\nchipWinsEV," << summary.games << ",,";
+            this->writeValues(summary.chipWinsEV);
+            this->file << '\n';
+            break;
+        case ResultsFormat::JSONL:
+            this->file << "{\"type\":\"summary\",\"games\":" << summary.games << ",\"gameWins\":";
+            this->writeValues(summary.gameWins);
+            this->file << ",\"chipWins\":";
+            this->writeValues(summary.chipWins);
+            this->file << ",\"chipWinsAmount\":";
+            this->writeValues(summary.chipWinsAmount);
+            this->file << ",\"chipWinsEV\":";
+            this->writeValues(summary.chipWinsEV);
+            this->file << "}\n";
+            break;
+        case ResultsFormat::BINARY:
+            this->writeBinary('S');
+            this->writeBinary(summary.games);
+            this->file.write(reinterpret_cast<const char*>(summary.gameWins), sizeof(u_int32_t) * this->numPlayers);
+            this->file.write(reinterpret_cast<const char*>(summary.chipWins), sizeof(u_int32_t) * this->numPlayers);
+            this->file.write(reinterpret_cast<const char*>(summary.chipWinsAmount), sizeof(u_int64_t) * this->numPlayers);
+            this->file.write(reinterpret_cast<const char*>(summary.chipWinsEV), sizeof(double) * this->numPlayers);
+            break;
+    }
+}
+
+template <typename T>
+void ResultsSink::writeValues(const T values[]) noexcept {
+    // CSV columns follow the previous column, JSON values are an array
+    if (this->format == ResultsFormat::JSONL) this->file << '[';
+    for (u_int8_t i = 0; i < this->numPlayers; i++) {
+        if (this->format == ResultsFormat::CSV || i != 0) this->file << ',';
+        this->file << values[i];
+    }
+    if (this->format == ResultsFormat::JSONL) this->file << ']';
+}
+
+ResultsFormat ResultsSink::getFormat(const std::string& path) {
+    auto hasExtension = [&path](const std::string& extension) { return path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0; };
+    if (hasExtension(".csv")) return ResultsFormat::CSV;
+    if (hasExtension(".jsonl")) return ResultsFormat::JSONL;
+    if (hasExtension(".bin")) return ResultsFormat::BINARY;
+    PLOG_FATAL << "Unknown results file extension: " << path << " (allowed: .csv, .jsonl, .bin)";
+    throw std::invalid_argument("Unknown results file extension: " + path);
+}
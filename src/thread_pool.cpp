@@ -0,0 +1,67 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(const u_int8_t threads) {
+    if (threads == 0) {
+        PLOG_FATAL << "A thread pool needs at least one thread";
+        throw std::invalid_argument("A thread pool needs at least one thread");
+    }
+    try {
+        for (u_int8_t i = 1; i < threads; i++) this->workers.emplace_back(&ThreadPool::work, this);
+    } catch (const std::system_error& e) {
+        PLOG_WARNING << "ThreadPool could only start " << this->workers.size() << " of " << threads - 1 << " threads: " << e.what();
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard<std::mutex> lock{this->mutex};
+        this->stopping = true;
+    }
+    this->start.notify_all();
+    for (std::thread& worker : this->workers) worker.join();
+}
+
+void ThreadPool::parallelFor(const u_int32_t count, const std::function<void(const u_int32_t)>& task) {
+    if (count == 0) return;
+    {
+        const std::lock_guard<std::mutex> lock{this->mutex};
+        this->task = &task;
+        this->count = count;
+        this->next.store(0, std::memory_order_relaxed);
+        this->error = nullptr;
+        this->busy = this->workers.size();
+        this->generation++;
+    }
+    this->start.notify_all();
+    this->runTasks();
+    std::unique_lock<std::mutex> lock{this->mutex};
+    this->done.wait(lock, [this]() { return this->busy == 0; });
+    this->task = nullptr;
+    if (this->error) std::rethrow_exception(this->error);
+}
+
+void ThreadPool::work() noexcept {
+    u_int64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock{this->mutex};
+            this->start.wait(lock, [this, generation]() { return this->stopping || this->generation != generation; });
+            if (this->stopping) return;
+            generation = this->generation;
+        }
+        this->runTasks();
+        const std::lock_guard<std::mutex> lock{this->mutex};
+        if (--this->busy == 0) this->done.notify_one();
+    }
+}
+
+void ThreadPool::runTasks() noexcept {
+    for (u_int32_t i = this->next.fetch_add(1, std::memory_order_relaxed); i < this->count; i = this->next.fetch_add(1, std::memory_order_relaxed)) {
+        try {
+            (*this->task)(i);
+        } catch (...) {
+            const std::lock_guard<std::mutex> lock{this->mutex};
+            if (!this->error) this->error = std::current_exception();
+        }
+    }
+}
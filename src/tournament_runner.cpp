@@ -0,0 +1,221 @@
+#include "tournament_runner.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+#include "check_player/check_player.h"
+#include "equity_player/equity_player.h"
+#include "rand_player/rand_player.h"
+
+template <u_int8_t N, typename Chips>
+BasicTournamentRunner<N, Chips>::BasicTournamentRunner(const TournamentConfig& config, const PlayerFactory& playerFactory)
+    : config(config), playerFactory(playerFactory), tableConfig(createTableConfig(config)) {}
+
+template <u_int8_t N, typename Chips>
+BasicConfig<N, Chips> BasicTournamentRunner<N, Chips>::createTableConfig(const TournamentConfig& config) {
+    if (config.numTournaments == 0 || config.numEntrants < 2 || config.numBots == 0 || config.syncHands == 0 || config.threads == 0 || config.startingChips == 0) {
+        PLOG_FATAL << "Invalid tournament config: " << config.numTournaments << " tournaments, " << config.numEntrants << " entrants, " << +config.numBots << " bots, " << config.syncHands
+                   << " hands between synchronizations, " << +config.threads << " threads, " << config.startingChips << " starting chips";
+        throw std::invalid_argument("Invalid tournament config");
+    }
+    if (config.levels.empty()) {
+        PLOG_FATAL << "The blind schedule of the tournament is empty";
+        throw std::invalid_argument("The blind schedule of the tournament is empty");
+    }
+    for (const BlindLevel& level : config.levels) {
+        if (level.smallBlind == 0 || level.hands == 0 || 2 * level.smallBlind + level.ante > BasicConfig<N, Chips>::getMaxChips()) {
+            PLOG_FATAL << "Invalid blind level: small blind " << level.smallBlind << ", ante " << level.ante << ", " << level.hands << " hands";
+            throw std::invalid_argument("Invalid blind level");
+        }
+    }
+    // all chips of the tournament can end up at one table
+    if (config.startingChips > BasicConfig<N, Chips>::getMaxChips() / config.numEntrants) {
+        PLOG_FATAL << "Too many chips in the tournament: " << config.numEntrants << " entrants with " << config.startingChips << " chips (max: " << BasicConfig<N, Chips>::getMaxChips() << ")";
+        throw std::invalid_argument("Too many chips in the tournament");
+    }
+    // the number of seats is checked by the config of the tables
+    return BasicConfig<N, Chips>{1, config.tableSize, (Chips)config.startingChips, (Chips)config.levels[0].smallBlind, 0, false, true};
+}
+
+template <u_int8_t N, typename Chips>
+void BasicTournamentRunner<N, Chips>::run() {
+    this->finishes.assign((u_int64_t)this->config.numBots * this->config.numEntrants, 0);
+    this->tournamentsPlayed = 0;
+    this->handsPlayed = 0;
+    // the threads are kept alive for all synchronization intervals of all tournaments
+    ThreadPool pool{this->config.threads};
+    for (u_int32_t tournament = 0; tournament < this->config.numTournaments; tournament++) {
+        this->runTournament(tournament, pool);
+        this->tournamentsPlayed++;
+    }
+    this->logResults();
+}
+
+template <u_int8_t N, typename Chips>
+void BasicTournamentRunner<N, Chips>::runTournament(const u_int32_t tournament, ThreadPool& pool) {
+    // draw the seats: the entrants are dealt to the tables in a random order, so the tables differ by at most one entrant
+    const u_int32_t numTables = (this->config.numEntrants + this->config.tableSize - 1) / this->config.tableSize;
+    std::vector<u_int32_t> order(this->config.numEntrants);
+    std::iota(order.begin(), order.end(), 0);
+    Philox rng{this->config.seed, tournament, 0, RandomStream::SEATING};
+    for (u_int32_t i = this->config.numEntrants - 1; i > 0; i--) std::swap(order[i], order[rng.uniform(i + 1)]);
+    std::vector<Table> tables(numTables);
+    for (u_int32_t t = 0; t < numTables; t++) {
+        Table& table = tables[t];
+        table.game = std::make_unique<BasicGame<N, Chips>>(this->tableConfig);
+        // the decks of every table are a function of the seed, the tournament and the table
+        table.game->setSeed(this->config.seed, (u_int64_t)tournament * numTables + t);
+        table.game->initTournamentTable();
+        table.seated = 0;
+        for (u_int8_t seat = 0; seat < this->config.tableSize; seat++) {
+            const u_int32_t i = seat * numTables + t;
+            table.entrants[seat] = i < this->config.numEntrants ? order[i] : NO_ENTRANT;
+            // the empty seats get a player that never plays, it is out of the game
+            std::unique_ptr<BasicPlayer<N, Chips>> player =
+                table.entrants[seat] == NO_ENTRANT ? std::make_unique<BasicCheckPlayer<N, Chips>>(0) : this->createPlayer(table.entrants[seat] % this->config.numBots);
+            table.game->seatPlayer(seat, player, table.entrants[seat] == NO_ENTRANT ? 0 : this->config.startingChips);
+            if (table.entrants[seat] != NO_ENTRANT) table.seated++;
+        }
+    }
+
+    u_int32_t remaining = this->config.numEntrants;
+    std::vector<Bust> busts;
+    for (u_int64_t clock = 0; remaining > 1; clock += this->config.syncHands) {
+        const BlindLevel level = this->getLevel(clock);
+        pool.parallelFor(tables.size(), [this, &tables, &level](const u_int32_t t) { this->playTable(tables[t], level); });
+        // the busted entrants of all tables finish in the order of their busts
+        busts.clear();
+        for (Table& table : tables) {
+            this->handsPlayed += table.hands;
+            busts.insert(busts.end(), table.busts.begin(), table.busts.end());
+        }
+        std::stable_sort(busts.begin(), busts.end(), [](const Bust& a, const Bust& b) { return a.hand != b.hand ? a.hand < b.hand : a.chips < b.chips; });
+        for (const Bust& bust : busts) {
+            this->finishes[(u_int64_t)(bust.entrant % this->config.numBots) * this->config.numEntrants + remaining - 1]++;
+            remaining--;
+        }
+        this->balance(tables, remaining);
+    }
+    // the last entrant wins
+    for (const Table& table : tables) {
+        for (u_int8_t seat = 0; seat < this->config.tableSize; seat++) {
+            if (table.entrants[seat] != NO_ENTRANT) this->finishes[(u_int64_t)(table.entrants[seat] % this->config.numBots) * this->config.numEntrants]++;
+        }
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicTournamentRunner<N, Chips>::playTable(Table& table, const BlindLevel& level) const {
+    table.busts.clear();
+    table.hands = 0;
+    BasicGame<N, Chips>& game = *table.game;
+    Chips chipsBefore[N];
+    for (; table.hands < this->config.syncHands && table.seated > 1; table.hands++) {
+        std::copy(game.data.gameData.playerChips, game.data.gameData.playerChips + N, chipsBefore);
+        game.playTournamentHand(level.smallBlind, level.ante);
+        for (u_int8_t seat = 0; seat < this->config.tableSize; seat++) {
+            if (table.entrants[seat] == NO_ENTRANT || game.data.gameData.playerChips[seat] != 0) continue;
+            table.busts.push_back(Bust{table.hands, chipsBefore[seat], table.entrants[seat]});
+            table.entrants[seat] = NO_ENTRANT;
+            table.seated--;
+        }
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicTournamentRunner<N, Chips>::balance(std::vector<Table>& tables, const u_int32_t remaining) const noexcept {
+    const auto fewest = [](const Table& a, const Table& b) { return a.seated < b.seated; };
+    // break the table with the fewest entrants while the others have enough seats
+    const u_int32_t needed = std::max<u_int32_t>(1, (remaining + this->config.tableSize - 1) / this->config.tableSize);
+    while (tables.size() > needed) {
+        const auto broken = std::min_element(tables.begin(), tables.end(), fewest);
+        for (u_int8_t seat = 0; seat < this->config.tableSize; seat++) {
+            if (broken->entrants[seat] == NO_ENTRANT) continue;
+            // the emptiest other table, every other table has an empty seat because the entrants fit on them
+            Table* target = nullptr;
+            for (Table& table : tables) {
+                if (&table != &*broken && (target == nullptr || table.seated < target->seated)) target = &table;
+            }
+            this->moveEntrant(*broken, seat, *target);
+        }
+        tables.erase(broken);
+    }
+    // move one entrant at a time from the fullest to the emptiest table
+    while (true) {
+        const auto [emptiest, fullest] = std::minmax_element(tables.begin(), tables.end(), fewest);
+        if (fullest->seated - emptiest->seated <= 1) return;
+        // the entrant that would be the next big blind
+        const BasicGame<N, Chips>& game = *fullest->game;
+        u_int8_t seat = game.data.roundData.bigBlindPos < N ? game.data.roundData.bigBlindPos : 0;
+        do seat = (seat + 1) % this->config.tableSize;
+        while (fullest->entrants[seat] == NO_ENTRANT);
+        this->moveEntrant(*fullest, seat, *emptiest);
+    }
+}
+
+template <u_int8_t N, typename Chips>
+void BasicTournamentRunner<N, Chips>::moveEntrant(Table& from, const u_int8_t seat, Table& to) const noexcept {
+    u_int8_t emptySeat = 0;
+    while (to.entrants[emptySeat] != NO_ENTRANT) emptySeat++;
+    // the entrant swaps places with the player of the empty seat, which is out of the game
+    std::unique_ptr<BasicPlayer<N, Chips>> player = std::move(from.game->players[seat]);
+    to.game->seatPlayer(emptySeat, player, from.game->data.gameData.playerChips[seat]);
+    from.game->seatPlayer(seat, player, 0);
+    to.entrants[emptySeat] = from.entrants[seat];
+    from.entrants[seat] = NO_ENTRANT;
+    to.seated++;
+    from.seated--;
+}
+
+template <u_int8_t N, typename Chips>
+BlindLevel BasicTournamentRunner<N, Chips>::getLevel(const u_int64_t hands) const noexcept {
+    u_int64_t start = 0;
+    for (const BlindLevel& level : this->config.levels) {
+        if (hands < start + level.hands) return level;
+        start += level.hands;
+    }
+    // the last level is doubled after every further hands of it, so every tournament ends
+    BlindLevel level = this->config.levels.back();
+    for (u_int64_t i = (hands - start) / level.hands + 1; i > 0 && 4 * level.smallBlind + 2 * level.ante <= BasicConfig<N, Chips>::getMaxChips(); i--) {
+        level.smallBlind *= 2;
+        level.ante *= 2;
+    }
+    return level;
+}
+
+template <u_int8_t N, typename Chips>
+double BasicTournamentRunner<N, Chips>::getMeanFinish(const u_int8_t bot) const noexcept {
+    u_int64_t count = 0;
+    double sum = 0;
+    for (u_int32_t position = 1; position <= this->config.numEntrants; position++) {
+        count += this->getFinishes(bot, position);
+        sum += (double)position * this->getFinishes(bot, position);
+    }
+    return count == 0 ? 0 : sum / count;
+}
+
+template <u_int8_t N, typename Chips>
+std::unique_ptr<BasicPlayer<N, Chips>> BasicTournamentRunner<N, Chips>::createPlayer(const u_int8_t bot) const {
+    if (this->playerFactory) return this->playerFactory(bot);
+    // the default lineup of the game (check, rand, check, rand, equity)
+    if (bot % 5 == 4) return std::make_unique<BasicEquityPlayer<N, Chips>>(bot + 1);
+    if (bot % 5 % 2 == 0) return std::make_unique<BasicCheckPlayer<N, Chips>>(bot + 1);
+    return std::make_unique<BasicRandPlayer<N, Chips>>(bot + 1);
+}
+
+template <u_int8_t N, typename Chips>
+void BasicTournamentRunner<N, Chips>::logResults() const noexcept {
+    PLOG_INFO << "Tournament statistics (" << this->tournamentsPlayed << " tournaments of " << this->config.numEntrants << " entrants, " << this->handsPlayed << " hands): \n";
+    for (u_int8_t bot = 0; bot < this->config.numBots; bot++) {
+        // the finishes in tenths of the field, the first tenth holds the best positions
+        u_int64_t tenths[10]{};
+        for (u_int32_t position = 1; position <= this->config.numEntrants; position++) tenths[(u_int64_t)(position - 1) * 10 / this->config.numEntrants] += this->getFinishes(bot, position);
+        std::string distribution;
+        for (u_int8_t i = 0; i < 10; i++) distribution += (i == 0 ? "" : " ") + std::to_string(tenths[i]);
+        PLOG_INFO << "Bot " << +bot << ": " << this->getFinishes(bot, 1) << " wins, mean finish " << this->getMeanFinish(bot) << ", finishes per tenth of the field: " << distribution;
+    }
+}
+
+#define INSTANTIATE_TOURNAMENT_RUNNER(N, CHIPS) template class BasicTournamentRunner<N, CHIPS>;
+POKER_TABLE_CONFIGS(INSTANTIATE_TOURNAMENT_RUNNER)
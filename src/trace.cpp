@@ -0,0 +1,145 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+/// @brief The ring buffer of one thread
+struct ThreadBuffer {
+    /// @brief The number of the thread in the trace
+    u_int32_t thread;
+    /// @brief The number of events that were recorded, the event i is at i % TRACE_BUFFER_EVENTS
+    u_int64_t recorded = 0;
+    /// @brief The events
+    Tracer::Event events[TRACE_BUFFER_EVENTS];
+
+    /// @brief Applies a function to the events that were not overwritten (in order)
+    /// @param function The function that is called with every event
+    template <typename F>
+    void forEach(F function) const noexcept {
+        const u_int64_t first = this->recorded > TRACE_BUFFER_EVENTS ? this->recorded - TRACE_BUFFER_EVENTS : 0;
+        for (u_int64_t i = first; i < this->recorded; i++) function(this->events[i % TRACE_BUFFER_EVENTS]);
+    }
+};
+
+/// @brief One of sampleRate hands is recorded
+std::atomic<u_int32_t> sampleRate{1};
+/// @brief Protects buffers
+std::mutex buffersMutex;
+/// @brief The ring buffers of all threads, they are kept after the threads are finished so they can be exported
+std::deque<std::unique_ptr<ThreadBuffer>> buffers;
+/// @brief The ring buffer of the thread (created with the first event)
+thread_local ThreadBuffer* threadBuffer = nullptr;
+/// @brief The number of hands that the thread started
+thread_local u_int64_t threadHands = 0;
+}  // namespace
+
+const std::chrono::steady_clock::time_point Tracer::epoch = std::chrono::steady_clock::now();
+thread_local bool Tracer::recording = false;
+
+void Tracer::setSampleRate(const u_int32_t rate) {
+    if (rate == 0) {
+        PLOG_FATAL << "Invalid trace sample rate: 0 (min: 1)";
+        throw std::invalid_argument("Invalid trace sample rate");
+    }
+    sampleRate.store(rate, std::memory_order_relaxed);
+}
+
+u_int32_t Tracer::getSampleRate() noexcept { return sampleRate.load(std::memory_order_relaxed); }
+
+void Tracer::beginHand() noexcept { Tracer::recording = threadHands++ % sampleRate.load(std::memory_order_relaxed) == 0; }
+
+void Tracer::record(const char* name, const u_int64_t start, const u_int64_t end) noexcept {
+    if (threadBuffer == nullptr) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        threadBuffer = buffers.back().get();
+        threadBuffer->thread = buffers.size() - 1;
+    }
+    threadBuffer->events[threadBuffer->recorded % TRACE_BUFFER_EVENTS] = Event{name, start, end - start};
+    threadBuffer->recorded++;
+}
+
+u_int64_t Tracer::getNumEvents() noexcept {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    u_int64_t numEvents = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) numEvents += std::min<u_int64_t>(buffer->recorded, TRACE_BUFFER_EVENTS);
+    return numEvents;
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) noexcept {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        PLOG_ERROR << "Could not open the trace file " << path;
+        return false;
+    }
+    // the trace format uses microseconds, the fractions keep the nanoseconds
+    file << std::fixed;
+    file.precision(3);
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        if (!first) file << ',';
+        first = false;
+        file << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread << ",\"args\":{\"name\":\"Simulation thread " << buffer->thread << "\"}}";
+        buffer->forEach([&file, &buffer](const Event& event) {
+            file << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"poker\",\"ph\":\"X\",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0
+                 << ",\"pid\":1,\"tid\":" << buffer->thread << '}';
+        });
+        if (buffer->recorded > TRACE_BUFFER_EVENTS) {
+            PLOG_WARNING << "The trace of thread " << buffer->thread << " only contains the last " << TRACE_BUFFER_EVENTS << " of " << buffer->recorded << " phases";
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+    if (file.fail()) {
+        PLOG_ERROR << "Could not write the trace file " << path;
+        return false;
+    }
+    PLOG_INFO << "Wrote the trace to " << path;
+    return true;
+}
+
+void Tracer::logSummary() noexcept {
+    // the total time and count per phase name (the same name can be different literals)
+    std::map<std::string, std::pair<u_int64_t, u_int64_t>> phases;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+            buffer->forEach([&phases](const Event& event) {
+                std::pair<u_int64_t, u_int64_t>& phase = phases[event.name];
+                phase.first += event.duration;
+                phase.second++;
+            });
+        }
+    }
+    if (phases.empty()) {
+        PLOG_INFO << "No traced phases (sample rate 1/" << Tracer::getSampleRate() << ")";
+        return;
+    }
+    std::vector<std::pair<std::string, std::pair<u_int64_t, u_int64_t>>> sorted(phases.begin(), phases.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.first > b.second.first; });
+    const std::map<std::string, std::pair<u_int64_t, u_int64_t>>::const_iterator hands = phases.find("hand");
+    const u_int64_t handTime = hands == phases.end() ? 0 : hands->second.first;
+    PLOG_INFO << "Traced phases (sample rate 1/" << Tracer::getSampleRate() << "):";
+    for (const auto& [name, phase] : sorted) {
+        if (handTime != 0) {
+            PLOG_INFO << name << ": " << phase.second << " times, " << phase.first << "ns total, " << phase.first / phase.second << "ns average, " << 100.0 * phase.first / handTime
+                      << "% of the hands";
+        } else {
+            PLOG_INFO << name << ": " << phase.second << " times, " << phase.first << "ns total, " << phase.first / phase.second << "ns average";
+        }
+    }
+}
+
+void Tracer::clear() noexcept {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) buffer->recorded = 0;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "check_player/check_player.h"
+#include "deal_sampler.h"
 #include "game.h"
 #include "rand_player/rand_player.h"
 
@@ -99,22 +100,43 @@ class GameTest : public Game {
     /// @note Undefined behavior if the length of playerHands is not equal to numPlayers
     /// @note The order will be: player 1 hand, player 2 hand, ..., player numPlayers hand, community cards
     /// @note REQUIRES: shufflePlayers and shuffleDeck to be false in Config
-    /// @see Deck::putCard()
+    /// @see Deck::arrange()
     void buildDeck(const std::pair<Card, Card> playerHands[], const u_int8_t numPlayers, const Card communityCards[5]) {
-        this->deck = Deck{};
+        Card order[MAX_DRAWN_CARDS];
         u_int8_t deckInd = 0;
         for (u_int8_t i = 0; i < numPlayers; i++) {
-            this->deck.putCard(playerHands[i].first, deckInd++);
-            this->deck.putCard(playerHands[i].second, deckInd++);
-        }
-        for (u_int8_t i = 0; i < 5; i++) {
-            this->deck.putCard(communityCards[i], deckInd++);
+            order[deckInd++] = playerHands[i].first;
+            order[deckInd++] = playerHands[i].second;
         }
+        for (u_int8_t i = 0; i < 5; i++) order[deckInd++] = communityCards[i];
+        this->deck = Deck{};
+        this->deck.arrange(order, deckInd);
+    }
+
+    /// @brief Sets up the deck for the game with a deal drawn from the ranges of a sampler (a random scenario instead of fixed cards)
+    /// @param sampler The sampler, its seats are the positions of the players
+    /// @param rng The generator
+    /// @return The deal that will be drawn
+    /// @exception Guarantee Basic
+    /// @throws std::logic_error if the sampler could not draw a deal
+    /// @note REQUIRES: shufflePlayers and shuffleDeck to be false in Config
+    /// @see DealSampler
+    Deal buildDeck(const DealSampler& sampler, Philox& rng) {
+        Deal deal;
+        if (!sampler.sample(rng, deal)) throw std::logic_error("The ranges of the sampler leave no deal");
+        this->buildDeck(deal.hands, sampler.getNumPlayers(), deal.board);
+        return deal;
     }
 
     /// @copydoc Game::initPlayerOrder()
     void initPlayerOrder() noexcept { Game::initPlayerOrder(); }
 
+    /// @copydoc Game::initTournamentTable()
+    void initTournamentTable() noexcept { Game::initTournamentTable(); }
+
+    /// @copydoc Game::seatPlayer()
+    void seatPlayer(const u_int8_t seat, std::unique_ptr<Player>& player, const u_int64_t chips) noexcept { Game::seatPlayer(seat, player, chips); }
+
     /// @copydoc Game::startRound()
     void startRound() noexcept { Game::startRound(); }
 
@@ -162,4 +184,11 @@ class GameTest : public Game {
 
     /// @copydoc Game::deck
     Deck& getDeck() noexcept { return this->deck; }
-};
\ No newline at end of file
+};
+
+/// @brief Creates deterministic players for the duplicate runs of the tests, so that the results only depend on the deals and the seating
+/// @param id The id of the seat
+/// @return The check player numbered by the seat
+/// @exception Guarantee Strong
+/// @see DuplicateRunner
+inline std::unique_ptr<Player> createCheckPlayer(const u_int8_t id) { return std::make_unique<CheckPlayer>(id + 1); }
@@ -202,8 +202,8 @@ void compileCmake(std::ofstream& cmakeLists, const std::vector<FileConfig>& file
     cmakeLists << "# tests" << std::endl;
     for (const FileConfig& fileConfig : fileConfigs) {
         cmakeLists << "add_executable(gtestc_" << fileConfig.cmakeTestName << " main_test.cpp " << fileConfig.fileName
-                   << " ${SRC_DIR}/game.cpp ${COMMON_SRC} ${TEST_PLAYER} ${RAND_PLAYER} ${CHECK_PLAYER})" << std::endl;
-        cmakeLists << "target_link_libraries(gtestc_" << fileConfig.cmakeTestName << " gtest_main)" << std::endl;
+                   << " ${SRC_DIR}/game.cpp ${COMMON_SRC} ${TEST_PLAYER} ${RAND_PLAYER} ${CHECK_PLAYER} ${EQUITY_PLAYER})" << std::endl;
+        cmakeLists << "target_link_libraries(gtestc_" << fileConfig.cmakeTestName << " gtest_main Threads::Threads)" << std::endl;
         cmakeLists << "target_include_directories(gtestc_" << fileConfig.cmakeTestName << " PUBLIC ${INCLUDE_DIR} ${PLAYER_DIR} ${TEST_DIR})" << std::endl;
         cmakeLists << std::endl;
     }
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "game_test.h"
+#include "test_player/test_player.h"
+
+namespace {
+/// @brief Plays one heads up round where both players go all-in on the turn
+/// @param allInEVSamples The number of runouts for the all-in EV statistics
+/// @return The game after the round
+std::unique_ptr<GameTest> playTurnAllIn(const u_int32_t allInEVSamples) {
+    std::unique_ptr<GameTest> game = std::make_unique<GameTest>(Config{1, 2, 1000, 10, 0, false, false, 1, false, 0, Actions::FOLD, allInEVSamples});
+    // aces against kings, the kings only win with one of the two remaining kings on the river
+    const std::pair<Card, Card> hands[2] = {{Card{14, 0}, Card{14, 1}}, {Card{13, 0}, Card{13, 1}}};
+    const Card community[5] = {Card{2, 0}, Card{7, 1}, Card{9, 2}, Card{11, 3}, Card{3, 0}};
+    game->buildDeck(hands, 2, community);
+    // call (blind option), check on the flop and all-in on the turn
+    static const std::vector<Action> actions = {Action{Actions::CALL}, Action{Actions::CHECK}, Action{Actions::ALL_IN}};
+    for (u_int8_t i = 0; i < 2; i++) {
+        std::unique_ptr<TestPlayer> testPlayer = std::make_unique<TestPlayer>(i);
+        testPlayer->setActions(&actions[0], actions.size());
+        game->getPlayers()[i] = std::move(testPlayer);
+    }
+    game->run(false);
+    return game;
+}
+}  // namespace
+
+TEST(AllInEVTest, TurnAllIn) {
+    std::unique_ptr<GameTest> game = playTurnAllIn(1000);
+    const Data& data = game->getData();
+    // the aces win the whole pot on the dealt board
+    EXPECT_EQ(2000, data.gameData.playerChips[0]);
+    EXPECT_EQ(0, data.gameData.playerChips[1]);
+    EXPECT_EQ(2000, data.gameData.chipWinsAmount[0]);
+    // all 44 rivers are enumerated, the kings win 2 of them
+    EXPECT_NEAR(2000.0 * 42 / 44 - 2000, data.gameData.allInEVAdjustment[0], 1e-9);
+    EXPECT_NEAR(2000.0 * 2 / 44, data.gameData.allInEVAdjustment[1], 1e-9);
+    EXPECT_NEAR(2000.0 * 42 / 44, data.getChipWinsEV(0), 1e-9);
+}
+
+TEST(AllInEVTest, Disabled) {
+    std::unique_ptr<GameTest> game = playTurnAllIn(0);
+    const Data& data = game->getData();
+    EXPECT_EQ(2000, data.gameData.playerChips[0]);
+    EXPECT_EQ(0, data.gameData.allInEVAdjustment[0]);
+    EXPECT_EQ(0, data.gameData.allInEVAdjustment[1]);
+    EXPECT_EQ(data.gameData.chipWinsAmount[0], data.getChipWinsEV(0));
+}
+
+TEST(AllInEVTest, ChipsConserved) {
+    // the expected shares of every all-in showdown (enumerated or sampled) add up to the distributed pots
+    GameTest game{Config{50, 5, 1000, 10, 1, true, true, 50, false, 0, Actions::FOLD, 100}};
+    game.setRealisticPlayers();
+    game.run(false);
+    const Data& data = game.getData();
+    double adjustment = 0;
+    double absAdjustment = 0;
+    u_int32_t showdowns = 0;
+    for (u_int8_t i = 0; i < 5; i++) {
+        adjustment += data.gameData.allInEVAdjustment[i];
+        absAdjustment += std::abs(data.gameData.allInEVAdjustment[i]);
+        showdowns += data.playerStats[i].showdowns;
+    }
+    // the random players go all-in in some rounds
+    EXPECT_GT(absAdjustment, 0);
+    // split pots are rounded down on every runout, only the odd chips (less than one per winner and showdown) may differ from the dealt board
+    EXPECT_LE(std::abs(adjustment), showdowns + 1e-6 * absAdjustment);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "game.h"
+#include "trace.h"
+
+// this test is compiled with POKER_ALLOC_AUDIT, so operator new is counted
+
+TEST(AllocTest, Phases) {
+    ASSERT_TRUE(AllocAudit::isEnabled());
+    AllocAudit::reset();
+    {
+        POKER_ALLOC_PHASE("outer");
+        std::unique_ptr<int> value = std::make_unique<int>(1);
+        {
+            POKER_ALLOC_PHASE("inner");
+            std::vector<int> values(10);
+        }
+    }
+    // the allocation of the inner phase is counted in the outer phase as well
+    EXPECT_EQ(2, AllocAudit::getAllocations("outer"));
+    EXPECT_EQ(1, AllocAudit::getAllocations("inner"));
+    EXPECT_EQ(0, AllocAudit::getAllocations("unknown"));
+    EXPECT_GE(AllocAudit::getAllocations(), 2);
+    AllocAudit::reset();
+    EXPECT_EQ(0, AllocAudit::getAllocations("outer"));
+}
+
+TEST(AllocTest, Threads) {
+    AllocAudit::reset();
+    std::thread([]() {
+        POKER_ALLOC_PHASE("thread");
+        for (u_int8_t i = 0; i < 3; i++) std::make_unique<int>(i);
+    }).join();
+    // the counts of the finished thread are added to the totals
+    EXPECT_EQ(3, AllocAudit::getAllocations("thread"));
+}
+
+TEST(AllocTest, HandLoop) {
+    // with the all-in EV runouts
+    Game game{Config{20, 4, 1000, 10, 1, true, true, 50, false, 0, Actions::FOLD, 100}};
+    // the first run allocates the players
+    game.run();
+    // the log records allocate, the hand loop has to be allocation free without logging
+    const plog::Severity severity = plog::get()->getMaxSeverity();
+    plog::get()->setMaxSeverity(plog::none);
+    AllocAudit::reset();
+    game.run(false);
+    plog::get()->setMaxSeverity(severity);
+    // the per-hand loop never allocates
+    EXPECT_EQ(0, AllocAudit::getAllocations("hand"));
+    EXPECT_EQ(0, AllocAudit::getAllocations("Player::turn"));
+    AllocAudit::logReport();
+}
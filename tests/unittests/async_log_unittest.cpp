@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "async_log.h"
+
+namespace {
+/// @brief Logs records with increasing numbers from several threads
+/// @param appender The appender
+/// @param numThreads The number of threads
+/// @param numRecords The number of records per thread
+/// @param errorEvery Every errorEvery-th record of a thread is an error, the others are verbose (0 for no errors)
+void logRecords(AsyncLogAppender& appender, const u_int8_t numThreads, const u_int32_t numRecords, const u_int32_t errorEvery) {
+    std::vector<std::thread> threads;
+    for (u_int8_t t = 0; t < numThreads; t++) {
+        threads.emplace_back([&appender, t, numRecords, errorEvery]() {
+            for (u_int32_t i = 0; i < numRecords; i++) {
+                plog::Record record(errorEvery != 0 && i % errorEvery == errorEvery - 1 ? plog::error : plog::verbose, "logRecords", 42, __FILE__, nullptr, 0);
+                record << "thread " << +t << " record " << i;
+                appender.write(record);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+}
+
+/// @brief Reads the lines of a file
+/// @param path The path of the file
+/// @return The lines
+std::vector<std::string> readLines(const std::filesystem::path& path) {
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) lines.push_back(line);
+    return lines;
+}
+}  // namespace
+
+TEST(AsyncLogTest, Block) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "poker_async_log_block.txt";
+    std::filesystem::remove(path);
+    AsyncLogAppender appender{LogOverflow::BLOCK, path.string(), 1024 * 1024 * 1024, 2, false};
+    // more records than slots, the producers have to wait for the background thread
+    logRecords(appender, 4, ASYNC_LOG_CAPACITY, 0);
+    appender.flush();
+    EXPECT_EQ(4 * (u_int64_t)ASYNC_LOG_CAPACITY, appender.getWritten());
+    appender.close();
+    EXPECT_EQ(0, appender.getDropped());
+
+    const std::vector<std::string> lines = readLines(path);
+    ASSERT_EQ(4 * (size_t)ASYNC_LOG_CAPACITY, lines.size());
+    // every thread keeps its order and the lines have the layout of plog::TxtFormatter
+    u_int32_t next[4] = {0, 0, 0, 0};
+    for (const std::string& line : lines) {
+        ASSERT_NE(std::string::npos, line.find(" VERB  [")) << line;
+        const size_t pos = line.find("[logRecords@42] thread ");
+        ASSERT_NE(std::string::npos, pos) << line;
+        u_int32_t thread, record;
+        ASSERT_EQ(2, std::sscanf(line.c_str() + pos, "[logRecords@42] thread %u record %u", &thread, &record)) << line;
+        ASSERT_LT(thread, 4);
+        EXPECT_EQ(next[thread]++, record);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(AsyncLogTest, DropAndSample) {
+    for (const LogOverflow overflow : {LogOverflow::DROP, LogOverflow::SAMPLE}) {
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "poker_async_log_drop.txt";
+        std::filesystem::remove(path);
+        AsyncLogAppender appender{overflow, path.string(), 1024 * 1024 * 1024, 2, false};
+        const u_int32_t numRecords = 4 * ASYNC_LOG_CAPACITY;
+        logRecords(appender, 4, numRecords, 100);
+        appender.close();
+        // every record is either written or dropped
+        EXPECT_EQ(4 * (u_int64_t)numRecords, appender.getWritten() + appender.getDropped()) << EnumToString::enumToString(overflow);
+
+        u_int64_t errors = 0, reports = 0;
+        for (const std::string& line : readLines(path)) {
+            if (line.find(" ERROR [") != std::string::npos) errors++;
+            if (line.find("log records (") != std::string::npos) reports++;
+        }
+        EXPECT_EQ(appender.getDropped() == 0, reports == 0) << EnumToString::enumToString(overflow);
+        // the errors are never sampled away
+        if (overflow == LogOverflow::SAMPLE) {
+            EXPECT_EQ(4 * (u_int64_t)(numRecords / 100), errors);
+        }
+        std::filesystem::remove(path);
+    }
+}
+
+TEST(AsyncLogTest, RollingFile) {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::filesystem::path path = dir / "poker_async_log_roll.txt";
+    for (const char* name : {"poker_async_log_roll.txt", "poker_async_log_roll.1.txt", "poker_async_log_roll.2.txt", "poker_async_log_roll.3.txt"}) std::filesystem::remove(dir / name);
+    {
+        AsyncLogAppender appender{LogOverflow::BLOCK, path.string(), 4096, 3, false};
+        for (u_int32_t i = 0; i < 10; i++) {
+            logRecords(appender, 1, 100, 0);
+            // one batch after another, so the file is rolled several times
+            appender.flush();
+        }
+    }
+    // the current file and two rolled files are kept
+    EXPECT_TRUE(std::filesystem::exists(path));
+    EXPECT_TRUE(std::filesystem::exists(dir / "poker_async_log_roll.1.txt"));
+    EXPECT_TRUE(std::filesystem::exists(dir / "poker_async_log_roll.2.txt"));
+    EXPECT_FALSE(std::filesystem::exists(dir / "poker_async_log_roll.3.txt"));
+    for (const char* name : {"poker_async_log_roll.txt", "poker_async_log_roll.1.txt", "poker_async_log_roll.2.txt"}) std::filesystem::remove(dir / name);
+}
+
+TEST(AsyncLogTest, Closed) {
+    AsyncLogAppender appender{LogOverflow::BLOCK, "", 0, 1, false};
+    appender.close();
+    // a closed appender does not block
+    plog::Record record(plog::info, "Closed", 1, __FILE__, nullptr, 0);
+    record << "too late";
+    appender.write(record);
+    EXPECT_EQ(1, appender.getDropped());
+    EXPECT_EQ(0, appender.getWritten());
+    appender.close();
+}
+
+TEST(AsyncLogTest, CloseWhileLogging) {
+    for (u_int8_t iter = 0; iter < 20; iter++) {
+        AsyncLogAppender appender{LogOverflow::BLOCK, "", 0, 1, false};
+        std::atomic<u_int64_t> logged{0};
+        std::vector<std::thread> threads;
+        for (u_int8_t t = 0; t < 4; t++) {
+            threads.emplace_back([&appender, &logged]() {
+                for (u_int32_t i = 0; i < 2000; i++) {
+                    plog::Record record(plog::info, "CloseWhileLogging", 1, __FILE__, nullptr, 0);
+                    record << "record " << i;
+                    appender.write(record);
+                    logged.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100 * iter));
+        appender.close();
+        for (std::thread& thread : threads) thread.join();
+        // every record that raced with close() is either written or counted as dropped
+        EXPECT_EQ(logged.load(), appender.getWritten() + appender.getDropped());
+    }
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "game_test.h"
+
+TEST(CashTest, Stats) {
+    CashStats stats;
+    EXPECT_EQ(0, stats.getHands());
+    EXPECT_EQ(0, stats.getStandardError(20));
+    stats.addHand(10);
+    stats.addHand(-10);
+    stats.addHand(30);
+    stats.addRebuy(100);
+    EXPECT_EQ(3, stats.getHands());
+    EXPECT_DOUBLE_EQ(10, stats.getMean());
+    // 10 chips per hand with a big blind of 20
+    EXPECT_DOUBLE_EQ(50, stats.getBbPer100(20));
+    // sample variance 400 over 3 hands
+    EXPECT_NEAR(std::sqrt(400.0 / 3) / 20 * 100, stats.getStandardError(20), 1e-9);
+    EXPECT_EQ(1, stats.getRebuys());
+    EXPECT_EQ(100, stats.getRebuyChips());
+    stats.reset();
+    EXPECT_EQ(0, stats.getHands());
+    EXPECT_EQ(0, stats.getRebuyChips());
+}
+
+TEST(CashTest, Run) {
+    // the added blind and the maximum number of rounds do not apply to cash games
+    GameTest game{Config{4, 5, 1000, 10, 5, true, true, 20}};
+    game.setRealisticPlayers();
+    EXPECT_THROW(game.runCash(0, false), std::invalid_argument);
+    game.runCash(150, false);
+    EXPECT_EQ(4, game.getGamesPlayed());
+    EXPECT_EQ(600, game.getProgressCounters().rounds.get());
+    EXPECT_EQ(10, game.getData().roundData.smallBlind);
+    double total = 0;
+    u_int64_t rebuys = 0;
+    u_int32_t gameWins = 0;
+    for (u_int8_t i = 0; i < 5; i++) {
+        const CashStats& stats = game.getCashStats(i);
+        EXPECT_EQ(600, stats.getHands());
+        total += stats.getMean() * stats.getHands();
+        rebuys += stats.getRebuys();
+        gameWins += game.getData().gameData.gameWins[i];
+    }
+    // the chips only move between the players (except the odd chips of split pots), the rebuys are not part of the results
+    EXPECT_LE(total, 1e-6);
+    EXPECT_GE(total, -100);
+    EXPECT_GT(rebuys, 0);
+    // every game has at least one winner
+    EXPECT_GE(gameWins, 4);
+    // a normal run does not collect cash statistics
+    game.run(false);
+    EXPECT_EQ(0, game.getCashStats(0).getHands());
+}
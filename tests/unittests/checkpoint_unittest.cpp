@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "checkpoint.h"
+#include "game_test.h"
+
+namespace {
+/// @brief A check player that requests the game to stop in its given turn, like a preemption of the run
+class StoppingPlayer : public CheckPlayer {
+   public:
+    /// @brief Creates the player
+    /// @param playerNum The number of the player
+    /// @param game The game that is stopped
+    /// @param stopTurn The turn of the player in which the stop is requested
+    /// @exception Guarantee No-throw
+    StoppingPlayer(const u_int8_t playerNum, Game& game, const u_int32_t stopTurn) noexcept : CheckPlayer(playerNum), game(game), stopTurn(stopTurn) {}
+
+    /// @copydoc CheckPlayer::turn()
+    Action turn(const Data& data, const bool blindOption = false, const bool equalize = false) const noexcept override {
+        if (++this->turns == this->stopTurn) this->game.requestStop();
+        return CheckPlayer::turn(data, blindOption, equalize);
+    }
+
+   private:
+    /// @brief The game that is stopped
+    Game& game;
+    /// @brief The turn in which the stop is requested
+    const u_int32_t stopTurn;
+    /// @brief The number of turns of the player
+    mutable u_int32_t turns = 0;
+};
+
+/// @brief Seats check players, the first one can stop the game
+/// @param game The game
+/// @param stopTurn The turn of the first player in which the stop is requested or 0
+void setCheckPlayers(GameTest& game, const u_int32_t stopTurn = 0) {
+    std::unique_ptr<Player> players[4];
+    players[0] = std::make_unique<StoppingPlayer>(1, game, stopTurn);
+    for (u_int8_t i = 1; i < 4; i++) players[i] = std::make_unique<CheckPlayer>(i + 1);
+    game.setPlayers(players);
+}
+
+/// @brief Expects the same results of two runs
+/// @param expected The results of the first run
+/// @param actual The results of the second run
+void expectSameResults(const Data& expected, const Data& actual) {
+    for (u_int8_t i = 0; i < 4; i++) {
+        EXPECT_EQ(expected.gameData.gameWins[i], actual.gameData.gameWins[i]);
+        EXPECT_EQ(expected.gameData.chipWins[i], actual.gameData.chipWins[i]);
+        EXPECT_EQ(expected.gameData.chipWinsAmount[i], actual.gameData.chipWinsAmount[i]);
+        EXPECT_EQ(expected.playerStats[i].hands, actual.playerStats[i].hands);
+        EXPECT_EQ(expected.playerStats[i].calls, actual.playerStats[i].calls);
+        EXPECT_EQ(expected.playerStats[i].showdownsWon, actual.playerStats[i].showdownsWon);
+    }
+}
+}  // namespace
+
+TEST(CheckpointTest, File) {
+    const std::string path = testing::TempDir() + "checkpoint_file.bin";
+    Checkpoint checkpoint;
+    const u_int64_t values[3] = {1, 2, UINT64_MAX};
+    checkpoint.write(values, 3);
+    const double value = 0.25;
+    checkpoint.write(&value);
+    ASSERT_TRUE(checkpoint.save(path));
+
+    Checkpoint loaded = Checkpoint::load(path);
+    u_int64_t loadedValues[3];
+    loaded.read(loadedValues, 3);
+    EXPECT_EQ(UINT64_MAX, loadedValues[2]);
+    EXPECT_EQ(0.25, loaded.read<double>());
+    EXPECT_TRUE(loaded.isRead());
+    EXPECT_THROW(loaded.read<u_int8_t>(), std::invalid_argument);
+
+    // a damaged file is detected by the checksum
+    {
+        std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(20);
+        file.put(7);
+    }
+    EXPECT_THROW(Checkpoint::load(path), std::invalid_argument);
+    // a torn file has the wrong size
+    checkpoint.save(path);
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::app};
+        file.put(0);
+    }
+    EXPECT_THROW(Checkpoint::load(path), std::invalid_argument);
+    std::remove(path.c_str());
+    EXPECT_THROW(Checkpoint::load(path), std::invalid_argument);
+}
+
+TEST(CheckpointTest, Writer) {
+    const std::string path = testing::TempDir() + "checkpoint_writer.bin";
+    EXPECT_THROW(CheckpointWriter(path, 0), std::invalid_argument);
+    CheckpointWriter writer{path, 10};
+    Checkpoint checkpoint;
+    for (u_int32_t i = 0; i < 100; i++) {
+        checkpoint.clear();
+        checkpoint.write(&i);
+        writer.submit(checkpoint);
+    }
+    writer.close();
+    // only outdated checkpoints are skipped, the last one is always written
+    EXPECT_EQ(100, writer.getWritten() + writer.getSkipped());
+    EXPECT_EQ(99, Checkpoint::load(path).read<u_int32_t>());
+    EXPECT_FALSE(std::ifstream{path + ".tmp"}.is_open());
+    std::remove(path.c_str());
+}
+
+TEST(CheckpointTest, Resume) {
+    const Config config{30, 4, 1000, 10, 5, true, true};
+    const std::string path = testing::TempDir() + "checkpoint_resume.bin";
+    // the run without interruption
+    GameTest full{config};
+    full.setSeed(11);
+    setCheckPlayers(full);
+    full.run(false);
+    ASSERT_EQ(30, full.getGamesPlayed());
+
+    // the run is stopped in the middle, the checkpoint holds the games up to the stop
+    {
+        GameTest stopped{config};
+        stopped.setSeed(11);
+        CheckpointWriter writer{path, 4};
+        stopped.setCheckpointWriter(&writer);
+        setCheckPlayers(stopped, full.getProgressCounters().actions.get() / 8);
+        stopped.run(false);
+        EXPECT_GT(stopped.getGamesPlayed(), 0);
+        EXPECT_LT(stopped.getGamesPlayed(), 30);
+    }
+    // the seed is restored from the checkpoint, the resumed run has the same results
+    GameTest resumed{config};
+    setCheckPlayers(resumed);
+    resumed.resume(path);
+    CheckpointWriter writer{path, 4};
+    resumed.setCheckpointWriter(&writer);
+    resumed.run(false);
+    writer.close();
+    EXPECT_EQ(30, resumed.getGamesPlayed());
+    expectSameResults(full.getData(), resumed.getData());
+
+    // the checkpoint of a finished run only restores the results
+    GameTest finished{config};
+    setCheckPlayers(finished);
+    finished.resume(path);
+    finished.run(false);
+    EXPECT_EQ(0, finished.getProgressCounters().rounds.get());
+    expectSameResults(full.getData(), finished.getData());
+    // the next run starts from the first game
+    finished.run(false);
+    EXPECT_EQ(30, finished.getGamesPlayed());
+
+    // a checkpoint of another config is not resumed
+    GameTest other{Config{31, 4, 1000, 10, 5, true, true}};
+    EXPECT_THROW(other.resume(path), std::invalid_argument);
+    // a checkpoint of a normal run is not resumed by a cash run
+    GameTest cash{config};
+    setCheckPlayers(cash);
+    cash.resume(path);
+    EXPECT_THROW(cash.runCash(10, false), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(CheckpointTest, DeterministicPlayers) {
+    GameTest game{Config{1, 4, 1000, 10, 5, true, true}};
+    setCheckPlayers(game);
+    EXPECT_TRUE(game.hasDeterministicPlayers());
+    // the default lineup has random and equity players, a resumed run is not reproduced
+    game.setDefaultPlayers();
+    EXPECT_FALSE(game.hasDeterministicPlayers());
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "combinations.h"
+
+TEST(CombinationsTest, Count) {
+    EXPECT_EQ(1, BINOMIALS[0][0]);
+    EXPECT_EQ(COMBO_NUM, BINOMIALS[CARD_NUM][2]);
+    EXPECT_EQ(133784560, BINOMIALS[CARD_NUM][7]);
+    EXPECT_EQ(0, BINOMIALS[3][4]);
+    const u_int64_t all = ((u_int64_t)1 << CARD_NUM) - 1;
+    EXPECT_EQ(22100, CardCombinations(all, 3).getCount());
+    // a flop all-in of two players: 45 unknown cards and 990 runouts
+    const u_int64_t dead = CardCombinations::getCardMask(Card{14, 0}) | CardCombinations::getCardMask(Card{14, 1}) | CardCombinations::getCardMask(Card{13, 0}) |
+                           CardCombinations::getCardMask(Card{13, 1}) | CardCombinations::getCardMask(Card{2, 2}) | CardCombinations::getCardMask(Card{7, 3}) |
+                           CardCombinations::getCardMask(Card{9, 0});
+    const CardCombinations runouts{all & ~dead, 2};
+    EXPECT_EQ(45, runouts.getNumCards());
+    EXPECT_EQ(990, runouts.getCount());
+    EXPECT_EQ(0, CardCombinations(0b11, 3).getCount());
+    EXPECT_EQ(1, CardCombinations(0b11, 0).getCount());
+}
+
+TEST(CombinationsTest, Enumerate) {
+    // every subset is enumerated once, in the order of the indices, with the live cards only
+    const u_int64_t live = 0xF0F0F0F0F0F0FULL;
+    const CardCombinations combinations{live, 4};
+    std::vector<u_int64_t> masks;
+    u_int64_t index = 0;
+    combinations.forEach([&](const Card subset[], const u_int64_t mask) {
+        EXPECT_EQ(4, __builtin_popcountll(mask));
+        EXPECT_EQ(0, mask & ~live);
+        u_int64_t subsetMask = 0;
+        for (u_int8_t i = 0; i < 4; i++) subsetMask |= CardCombinations::getCardMask(subset[i]);
+        EXPECT_EQ(mask, subsetMask);
+        // rank and unrank agree with the enumeration
+        EXPECT_EQ(index, combinations.rank(mask));
+        Card unranked[4];
+        EXPECT_EQ(mask, combinations.unrank(index, unranked));
+        for (u_int8_t i = 0; i < 4; i++) EXPECT_EQ(subset[i], unranked[i]);
+        masks.push_back(mask);
+        index++;
+    });
+    EXPECT_EQ(combinations.getCount(), masks.size());
+    std::sort(masks.begin(), masks.end());
+    EXPECT_EQ(masks.end(), std::adjacent_find(masks.begin(), masks.end()));
+}
+
+TEST(CombinationsTest, Chunks) {
+    // the chunks cover the index space and give the same subsets as one enumeration
+    const CardCombinations combinations{((u_int64_t)1 << CARD_NUM) - 1, 3};
+    u_int64_t sum = 0;
+    combinations.forEach([&sum](const Card*, const u_int64_t mask) { sum += mask % 1000003; });
+    u_int64_t chunkSum = 0;
+    u_int64_t next = 0;
+    for (u_int32_t chunk = 0; chunk < 7; chunk++) {
+        const std::pair<u_int64_t, u_int64_t> range = combinations.getChunk(chunk, 7);
+        EXPECT_EQ(next, range.first);
+        EXPECT_LE(range.second - range.first, combinations.getCount() / 7 + 1);
+        next = range.second;
+        combinations.forEach(range.first, range.second, [&chunkSum](const Card*, const u_int64_t mask) { chunkSum += mask % 1000003; });
+    }
+    EXPECT_EQ(combinations.getCount(), next);
+    EXPECT_EQ(sum, chunkSum);
+    // the last subset holds the highest cards
+    Card last[3];
+    combinations.unrank(combinations.getCount() - 1, last);
+    EXPECT_EQ((Card{12, 3}), last[0]);
+    EXPECT_EQ((Card{14, 3}), last[2]);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "deal_generator.h"
+
+TEST(DealGeneratorTest, Random) {
+    // the vectorized fill is the stream of the generator
+    u_int32_t random[64];
+    DealGenerator::fillRandom(42, 7, random, 64);
+    Philox rng{42, 7, 0, RandomStream::DEAL_BLOCK};
+    for (u_int32_t i = 0; i < 64; i++) EXPECT_EQ(rng.next(), random[i]);
+}
+
+TEST(DealGeneratorTest, Deals) {
+    const std::unique_ptr<DealBlock> block = std::make_unique<DealBlock>();
+    DealGenerator generator{1234, MAX_PLAYERS};
+    generator.generate(*block);
+    EXPECT_EQ(DEAL_BLOCK_SIZE, block->size);
+    EXPECT_EQ(MAX_PLAYERS, block->players);
+    EXPECT_EQ(1, generator.getBlocks());
+    u_int32_t counts[MAX_DRAWN_CARDS][CARD_NUM]{};
+    for (u_int32_t deal = 0; deal < block->size; deal++) {
+        // every card of a deal is a valid card and drawn once
+        bool seen[CARD_NUM]{};
+        for (u_int8_t slot = 0; slot < MAX_DRAWN_CARDS; slot++) {
+            const Card card = block->cards[slot][deal];
+            ASSERT_GE(card.rank, 2);
+            ASSERT_LE(card.rank, 14);
+            ASSERT_LE(card.suit, 3);
+            const u_int8_t index = card.suit * 13 + card.rank - 2;
+            EXPECT_FALSE(seen[index]);
+            seen[index] = true;
+            counts[slot][index]++;
+        }
+        Card communityCards[5];
+        block->getCommunityCards(deal, communityCards);
+        EXPECT_EQ(block->cards[4][deal], communityCards[4]);
+        EXPECT_EQ(block->cards[MAX_DRAWN_CARDS - 1][deal], block->getHand(deal, MAX_PLAYERS - 1).second);
+    }
+    // every card is about equally likely in every slot (about 39 times per slot)
+    for (u_int8_t slot = 0; slot < MAX_DRAWN_CARDS; slot++) {
+        for (u_int8_t card = 0; card < CARD_NUM; card++) EXPECT_GT(counts[slot][card], 0);
+    }
+}
+
+TEST(DealGeneratorTest, Blocks) {
+    const std::unique_ptr<DealBlock> block = std::make_unique<DealBlock>();
+    const std::unique_ptr<DealBlock> partial = std::make_unique<DealBlock>();
+    DealGenerator generator{99, 3};
+    DealGenerator other{99, 3};
+    generator.generate(*block);
+    other.generate(*partial, 100);
+    // a deal does not depend on the size of its block
+    EXPECT_EQ(100, partial->size);
+    for (u_int32_t deal = 0; deal < partial->size; deal++) {
+        for (u_int8_t slot = 0; slot < 11; slot++) EXPECT_EQ(block->cards[slot][deal], partial->cards[slot][deal]);
+    }
+    // the next block has other deals
+    generator.generate(*partial);
+    u_int32_t equal = 0;
+    for (u_int32_t deal = 0; deal < DEAL_BLOCK_SIZE; deal++) equal += block->getHand(deal, 0) == partial->getHand(deal, 0);
+    EXPECT_LT(equal, DEAL_BLOCK_SIZE / 100);
+
+    EXPECT_THROW(DealGenerator(1, 0), std::invalid_argument);
+    EXPECT_THROW(DealGenerator(1, MAX_PLAYERS + 1), std::invalid_argument);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "deal_sampler.h"
+#include "game_test.h"
+
+namespace {
+/// @brief Checks that the cards of a deal are valid and distinct
+/// @param deal The deal
+/// @param numPlayers The number of seats of the deal
+void expectDistinct(const Deal& deal, const u_int8_t numPlayers) {
+    bool seen[CARD_NUM]{};
+    const auto check = [&seen](const Card card) {
+        ASSERT_GE(card.rank, 2);
+        ASSERT_LE(card.rank, 14);
+        ASSERT_LE(card.suit, 3);
+        EXPECT_FALSE(seen[HandRange::getCardIndex(card)]);
+        seen[HandRange::getCardIndex(card)] = true;
+    };
+    for (u_int8_t i = 0; i < numPlayers; i++) {
+        check(deal.hands[i].first);
+        check(deal.hands[i].second);
+    }
+    for (u_int8_t i = 0; i < 5; i++) check(deal.board[i]);
+}
+}  // namespace
+
+TEST(DealSamplerTest, Ranges) {
+    u_int32_t any = 0, pairs = 0, connectors = 0;
+    const HandRange anyRange = HandRange::any(), pairsRange = HandRange::pocketPairs(), connectorsRange = HandRange::suitedConnectors();
+    for (u_int16_t i = 0; i < COMBO_NUM; i++) {
+        any += anyRange.getWeight(i) != 0;
+        pairs += pairsRange.getWeight(i) != 0;
+        connectors += connectorsRange.getWeight(i) != 0;
+    }
+    EXPECT_EQ(COMBO_NUM, any);
+    EXPECT_EQ(78, pairs);
+    EXPECT_EQ(52, connectors);
+    // the index of the last combination
+    EXPECT_EQ(COMBO_NUM - 1, HandRange::getComboIndex(CARD_NUM - 1, CARD_NUM - 2));
+    HandRange range;
+    EXPECT_THROW(range.add(Card{14, 0}, Card{14, 0}), std::invalid_argument);
+    EXPECT_THROW(range.add(Card{15, 0}, Card{14, 1}), std::invalid_argument);
+    EXPECT_THROW(DealSampler(2).setRange(0, range), std::invalid_argument);
+    EXPECT_THROW(DealSampler(2).setRange(2, HandRange::any()), std::invalid_argument);
+    EXPECT_THROW(DealSampler(0), std::invalid_argument);
+}
+
+TEST(DealSamplerTest, Constraints) {
+    DealSampler sampler{3};
+    sampler.setRange(0, HandRange::pocketPairs()).setRange(1, HandRange::suitedConnectors()).setBoardTexture(BoardTexture::MONOTONE);
+    Philox rng{1, 0, 0, RandomStream::DEAL_SAMPLER};
+    Deal deal;
+    for (u_int32_t i = 0; i < 2000; i++) {
+        ASSERT_TRUE(sampler.sample(rng, deal));
+        expectDistinct(deal, 3);
+        EXPECT_EQ(deal.hands[0].first.rank, deal.hands[0].second.rank);
+        EXPECT_EQ(deal.hands[1].first.suit, deal.hands[1].second.suit);
+        EXPECT_EQ(deal.board[0].suit, deal.board[1].suit);
+        EXPECT_EQ(deal.board[0].suit, deal.board[2].suit);
+    }
+    // the other textures of the flop
+    const auto suits = [](const Deal& deal) {
+        u_int8_t mask = 0;
+        for (u_int8_t i = 0; i < 3; i++) mask |= 1 << deal.board[i].suit;
+        return __builtin_popcount(mask);
+    };
+    for (u_int32_t i = 0; i < 500; i++) {
+        ASSERT_TRUE(sampler.setBoardTexture(BoardTexture::TWO_TONE).sample(rng, deal));
+        expectDistinct(deal, 3);
+        EXPECT_EQ(2, suits(deal));
+        ASSERT_TRUE(sampler.setBoardTexture(BoardTexture::RAINBOW).sample(rng, deal));
+        expectDistinct(deal, 3);
+        EXPECT_EQ(3, suits(deal));
+        ASSERT_TRUE(sampler.setBoardTexture(BoardTexture::PAIRED).sample(rng, deal));
+        expectDistinct(deal, 3);
+        const u_int8_t pairs = (deal.board[0].rank == deal.board[1].rank) + (deal.board[0].rank == deal.board[2].rank) + (deal.board[1].rank == deal.board[2].rank);
+        EXPECT_EQ(1, pairs);
+    }
+}
+
+TEST(DealSamplerTest, Weights) {
+    // aces three times as often as kings
+    HandRange range;
+    range.add(Card{14, 0}, Card{14, 1}, 3).add(Card{13, 0}, Card{13, 1});
+    DealSampler sampler{2};
+    sampler.setRange(0, range);
+    Philox rng{2, 0, 0, RandomStream::DEAL_SAMPLER};
+    Deal deal;
+    u_int32_t aces = 0;
+    for (u_int32_t i = 0; i < 8000; i++) {
+        ASSERT_TRUE(sampler.sample(rng, deal));
+        aces += deal.hands[0].first.rank == 14;
+    }
+    EXPECT_NEAR(6000, aces, 200);
+
+    // the card removal leaves one combination of the second seat, no rejection of the whole deal
+    HandRange aces1, blocked;
+    aces1.add(Card{14, 0}, Card{14, 1});
+    blocked.add(Card{14, 0}, Card{13, 0}, UINT16_MAX).add(Card{14, 1}, Card{13, 1}, UINT16_MAX).add(Card{12, 2}, Card{12, 3});
+    sampler.setRange(0, aces1).setRange(1, blocked);
+    for (u_int32_t i = 0; i < 100; i++) {
+        ASSERT_TRUE(sampler.sample(rng, deal));
+        EXPECT_EQ(12, deal.hands[1].first.rank);
+        EXPECT_EQ(12, deal.hands[1].second.rank);
+    }
+    // no combination left
+    sampler.setRange(1, aces1);
+    EXPECT_FALSE(sampler.sample(rng, deal));
+}
+
+TEST(DealSamplerTest, Block) {
+    DealSampler sampler{4};
+    sampler.setRange(3, HandRange::pocketPairs());
+    const std::unique_ptr<DealBlock> block = std::make_unique<DealBlock>();
+    Philox rng{3, 0, 0, RandomStream::DEAL_SAMPLER};
+    ASSERT_TRUE(sampler.sample(rng, *block, 100));
+    EXPECT_EQ(100, block->size);
+    EXPECT_EQ(4, block->players);
+    for (u_int32_t i = 0; i < block->size; i++) EXPECT_EQ(block->getHand(i, 3).first.rank, block->getHand(i, 3).second.rank);
+}
+
+TEST(DealSamplerTest, Game) {
+    // the ranges are indexed by the player ids, the positions are shuffled
+    DealSampler sampler{3};
+    sampler.setRange(0, HandRange::pocketPairs()).setRange(2, HandRange::suitedConnectors()).setBoardTexture(BoardTexture::MONOTONE);
+    GameTest game{Config{1, 3, 1000, 10, 0, true, true, 1, false, 0, Actions::FOLD, 0}};
+    std::unique_ptr<Player> players[3];
+    for (u_int8_t i = 0; i < 3; i++) players[i] = std::make_unique<CheckPlayer>(i);
+    game.setPlayers(players);
+    game.setDealSampler(&sampler);
+    for (u_int32_t i = 0; i < 50; i++) {
+        // one round: every player checks to the showdown
+        game.run(false);
+        for (u_int8_t pos = 0; pos < 3; pos++) {
+            const std::pair<Card, Card> hand = game.getPlayers()[pos]->getHand();
+            if (game.getPlayers()[pos]->getPlayerId() == 0) {
+                EXPECT_EQ(hand.first.rank, hand.second.rank);
+            } else if (game.getPlayers()[pos]->getPlayerId() == 2) {
+                EXPECT_EQ(hand.first.suit, hand.second.suit);
+            }
+        }
+        const Card* const community = game.getData().roundData.communityCards;
+        EXPECT_EQ(community[0].suit, community[1].suit);
+        EXPECT_EQ(community[0].suit, community[2].suit);
+    }
+    DealSampler wrongSize{2};
+    EXPECT_THROW(game.setDealSampler(&wrongSize), std::invalid_argument);
+}
+
+TEST(DealSamplerTest, BuildDeck) {
+    // a random scenario instead of fixed cards: the positions get the sampled hands
+    DealSampler sampler{2};
+    sampler.setRange(1, HandRange::pocketPairs()).setBoardTexture(BoardTexture::PAIRED);
+    GameTest game{Config{1, 2, 1000, 10, 0, false, false, 1, false, 0, Actions::FOLD, 0}};
+    std::unique_ptr<Player> players[2];
+    for (u_int8_t i = 0; i < 2; i++) players[i] = std::make_unique<CheckPlayer>(i);
+    game.setPlayers(players);
+    Philox rng{4, 0, 0, RandomStream::DEAL_SAMPLER};
+    const Deal deal = game.buildDeck(sampler, rng);
+    game.run(false);
+    for (u_int8_t pos = 0; pos < 2; pos++) {
+        // the order of the two cards of a hand is not specified
+        const std::pair<Card, Card> hand = game.getPlayers()[pos]->getHand();
+        EXPECT_TRUE(hand == deal.hands[pos] || hand == std::make_pair(deal.hands[pos].second, deal.hands[pos].first));
+    }
+    for (u_int8_t i = 0; i < 5; i++) EXPECT_EQ(deal.board[i], game.getData().roundData.communityCards[i]);
+}
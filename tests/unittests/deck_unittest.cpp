@@ -90,6 +90,37 @@ TEST(Deck, shuffle) {
     }
 }
 
+TEST(Deck, seededShuffle) {
+    Deck deck{};
+    Deck deck2{};
+    deck.shuffle(42);
+    deck2.shuffle(42);
+    // the same seed replays the same order
+    EXPECT_EQ(deck, deck2);
+    EXPECT_NE(deck, Deck{});
+    Deck deck3{};
+    deck3.shuffle(43);
+    EXPECT_NE(deck, deck3);
+    // check if all cards are still in deck
+    std::list<Card> cards;
+    for (u_int8_t suit = 0; suit < 4; suit++) {
+        for (u_int8_t rank = 2; rank < 15; rank++) {
+            cards.push_back(Card{rank, suit});
+        }
+    }
+    for (u_int8_t ind = 0; ind < 52; ind++) cards.remove(deck.draw());
+    EXPECT_EQ(cards.size(), 0);
+    // every card reaches the first position with different seeds
+    bool first[52]{};
+    for (u_int64_t seed = 0; seed < 10000; seed++) {
+        Deck deck4{};
+        deck4.shuffle(seed);
+        const Card card = deck4.draw();
+        first[card.suit * 13 + card.rank - 2] = true;
+    }
+    EXPECT_EQ(52, std::count(first, first + 52, true));
+}
+
 TEST(Deck, Perfshuffle) {
     Deck deck;
     for (u_int64_t ind = 0; ind < 1000000; ind++) {
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "duplicate_runner.h"
+#include "game_test.h"
+
+TEST(DuplicateTest, Seatings) {
+    const Config config{1, 4, 1000, 10, 1, false, false, 10};
+    EXPECT_EQ(4, (DuplicateRunner{config, DuplicateConfig{1, 0}}.getNumSeatings()));
+    EXPECT_EQ(24, (DuplicateRunner{config, DuplicateConfig{1, 0, DuplicateSeating::PERMUTATIONS}}.getNumSeatings()));
+    EXPECT_THROW((DuplicateRunner{config, DuplicateConfig{0, 0}}), std::invalid_argument);
+    EXPECT_THROW((DuplicateRunner{config, DuplicateConfig{1, 0, DuplicateSeating::ROTATIONS, 0}}), std::invalid_argument);
+    EXPECT_THROW((DuplicateRunner{Config{1, MAX_DUPLICATE_PERMUTATION_PLAYERS + 1, 1000, 10, 1}, DuplicateConfig{1, 0, DuplicateSeating::PERMUTATIONS}}), std::invalid_argument);
+}
+
+TEST(DuplicateTest, PairResult) {
+    DuplicatePairResult all{};
+    DuplicatePairResult first{};
+    DuplicatePairResult second{};
+    const double scores[6] = {1, -2, 3.5, 4, 0, -1};
+    for (u_int8_t i = 0; i < 6; i++) {
+        all.add(scores[i]);
+        if (i < 2)
+            first.add(scores[i]);
+        else
+            second.add(scores[i]);
+    }
+    EXPECT_EQ(6, all.deals);
+    EXPECT_DOUBLE_EQ(5.5 / 6, all.mean);
+    // the merged result of two threads equals the sequential result
+    first.merge(second);
+    EXPECT_EQ(all.deals, first.deals);
+    EXPECT_DOUBLE_EQ(all.mean, first.mean);
+    EXPECT_NEAR(all.getVariance(), first.getVariance(), 1e-12);
+    EXPECT_NEAR(std::sqrt(all.getVariance() / 6), all.getStandardError(), 1e-12);
+}
+
+TEST(DuplicateTest, EqualPlayersCancel) {
+    // identical players get the same cards in every seating, so the duplicate score has no variance
+    DuplicateRunner runner{Config{1, 3, 1000, 10, 1, false, false, 30}, DuplicateConfig{20, 7}, createCheckPlayer};
+    runner.run();
+    for (u_int8_t i = 0; i < 3; i++) {
+        for (u_int8_t j = i + 1; j < 3; j++) {
+            EXPECT_EQ(20, runner.getPairResult(i, j).deals);
+            EXPECT_NEAR(0, runner.getPairResult(i, j).mean, 1e-9);
+            EXPECT_NEAR(0, runner.getPairResult(i, j).getVariance(), 1e-9);
+        }
+    }
+    EXPECT_EQ(runner.getChipWins(0), runner.getChipWins(1));
+}
+
+TEST(DuplicateTest, ThreadsReplayDeals) {
+    // the deal sequences only depend on the seed, not on the thread that plays them
+    const Config config{1, 3, 1000, 10, 1, false, false, 30};
+    DuplicateRunner single{config, DuplicateConfig{12, 3, DuplicateSeating::PERMUTATIONS, 1}, createCheckPlayer};
+    DuplicateRunner multi{config, DuplicateConfig{12, 3, DuplicateSeating::PERMUTATIONS, 4}, createCheckPlayer};
+    single.run();
+    multi.run();
+    u_int64_t gameWins = 0;
+    for (u_int8_t i = 0; i < 3; i++) {
+        EXPECT_EQ(single.getGameWins(i), multi.getGameWins(i));
+        EXPECT_DOUBLE_EQ(single.getChipWins(i), multi.getChipWins(i));
+        gameWins += single.getGameWins(i);
+    }
+    // every game of every seating has at least one winner
+    EXPECT_GE(gameWins, 12 * 6);
+}
+
+TEST(DuplicateTest, DefaultPlayers) {
+    DuplicateRunner runner{Config{1, 5, 1000, 10, 1, false, false, 20}, DuplicateConfig{4, 11, DuplicateSeating::ROTATIONS, 2}};
+    runner.run();
+    u_int64_t gameWins = 0;
+    for (u_int8_t i = 0; i < 5; i++) gameWins += runner.getGameWins(i);
+    EXPECT_GE(gameWins, 4 * 5);
+    EXPECT_EQ(4, runner.getPairResult(0, 4).deals);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include "duplicate_runner.h"
+#include "game_test.h"
+
+TEST(EarlyStopTest, ConfidenceInterval) {
+    EarlyStop earlyStop{EarlyStopConfig{StopRule::CONFIDENCE_INTERVAL, 0.05, 0.05, 0.1, 10}, 2, 1000};
+    const double wins[2][2] = {{1, 0}, {0, 1}};
+    const double chips[2][2] = {{100, 0}, {0, 100}};
+    for (u_int8_t i = 0; i < 100; i++) earlyStop.addSample(wins[i % 2], chips[i % 2]);
+    EXPECT_EQ(100, earlyStop.getSamples());
+    EXPECT_DOUBLE_EQ(0.5, earlyStop.getWinRate(0));
+    EXPECT_DOUBLE_EQ(50, earlyStop.getChipRate(1));
+    // the two-sided normal quantile of 0.05 times the standard error of the mean
+    const double standardError = std::sqrt(0.25 * 100 / 99 / 100);
+    EXPECT_NEAR(1.959964 * standardError, earlyStop.getWinRateHalfWidth(0), 1e-5);
+    EXPECT_NEAR(100 * 1.959964 * standardError, earlyStop.getChipRateHalfWidth(1), 1e-3);
+    // 0.098 is narrower than 0.1 and 9.8 chips are less than 0.1 * 1000 chips
+    EXPECT_TRUE(earlyStop.isDecided());
+    EarlyStop narrow{EarlyStopConfig{StopRule::CONFIDENCE_INTERVAL, 0.05, 0.05, 0.05, 10}, 2, 1000};
+    for (u_int8_t i = 0; i < 100; i++) narrow.addSample(wins[i % 2], chips[i % 2]);
+    EXPECT_FALSE(narrow.isDecided());
+}
+
+TEST(EarlyStopTest, SPRT) {
+    const double wins[3] = {1, 0, 0};
+    const double chips[3] = {0, 0, 0};
+    EarlyStop earlyStop{EarlyStopConfig{StopRule::SPRT, 0.05, 0.05, 0.1, 5}, 3, 1000};
+    // player 0 always wins, the gap to the others is accepted after log(19) / log(1.2) = 16.2 games
+    // the players 1 and 2 never win a game alone and are never decided
+    for (u_int8_t i = 0; i < 100; i++) earlyStop.addSample(wins, chips);
+    EXPECT_NEAR(100 * std::log(1.2), earlyStop.getLLR(0, 1), 1e-9);
+    EXPECT_NEAR(100 * std::log(0.8), earlyStop.getLLR(1, 0), 1e-9);
+    EXPECT_FALSE(earlyStop.isDecided());
+    // alternating wins of player 1 and 2 rule out a gap between them
+    EarlyStop equal{EarlyStopConfig{StopRule::SPRT, 0.05, 0.05, 0.1, 5}, 3, 1000};
+    const double alternating[2][3] = {{0, 1, 0}, {0, 0, 1}};
+    u_int32_t games = 0;
+    while (!equal.isDecided() && games < 10000) equal.addSample(alternating[games++ % 2], chips);
+    // log(1.2) + log(0.8) = -0.0408 per two games, log(0.05 / 0.95) = -2.944 is reached in both directions after 2 * 73 games
+    EXPECT_EQ(146, games);
+    // player 0 never won a game, the gap of player 1 to player 0 is accepted
+    EXPECT_GE(equal.getLLR(1, 0), std::log(0.95 / 0.05));
+}
+
+TEST(EarlyStopTest, Disabled) {
+    EarlyStop earlyStop{EarlyStopConfig{}, 2, 1000};
+    const double wins[2] = {1, 0};
+    for (u_int8_t i = 0; i < 200; i++) earlyStop.addSample(wins, wins);
+    EXPECT_FALSE(earlyStop.isDecided());
+    Game game{Config{3, 2, 1000, 10, 1, true, true, 20}};
+    game.run();
+    EXPECT_EQ(3, game.getGamesPlayed());
+}
+
+TEST(EarlyStopTest, InvalidConfig) {
+    EXPECT_THROW((Config{1, 2, 1000, 10, 1, true, true, -1, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::SPRT, 0, 0.05, 0.05}}), std::invalid_argument);
+    EXPECT_THROW((Config{1, 2, 1000, 10, 1, true, true, -1, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::SPRT, 0.05, 1, 0.05}}), std::invalid_argument);
+    EXPECT_THROW((Config{1, 2, 1000, 10, 1, true, true, -1, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::SPRT, 0.05, 0.05, 0.5}}), std::invalid_argument);
+    EXPECT_THROW((Config{1, 2, 1000, 10, 1, true, true, -1, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::CONFIDENCE_INTERVAL, 0.05, 0.05, 0}}), std::invalid_argument);
+    EXPECT_NO_THROW((Config{1, 2, 1000, 10, 1, true, true, -1, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::CONFIDENCE_INTERVAL, 0.05, 0.05, 2}}));
+}
+
+TEST(EarlyStopTest, GameStopsEarly) {
+    // two players with a 0.5 game-win rate need about 100 games for a half-width of 0.1 (the chip-win rates allow 5 times the chips at the table)
+    Game game{Config{10000, 2, 1000, 10, 1, true, true, 20, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::CONFIDENCE_INTERVAL, 0.05, 0.05, 0.1, 20}}};
+    game.run();
+    EXPECT_GE(game.getGamesPlayed(), 20);
+    EXPECT_LT(game.getGamesPlayed(), 10000);
+    const Data& data = game.getData();
+    EXPECT_GE(data.gameData.gameWins[0] + data.gameData.gameWins[1], game.getGamesPlayed());
+}
+
+TEST(EarlyStopTest, DuplicateShards) {
+    // identical players share the games and chips of every deal sequence equally, the intervals have no width after minGames deal sequences
+    const Config config{1, 3, 1000, 10, 1, false, false, 30, false, 0, Actions::FOLD, 0, EarlyStopConfig{StopRule::CONFIDENCE_INTERVAL, 0.05, 0.05, 0.01, 5}};
+    DuplicateRunner single{config, DuplicateConfig{50, 1}, createCheckPlayer};
+    single.run();
+    EXPECT_EQ(5, single.getDealsPlayed());
+    // every thread stops its own deal sequences
+    DuplicateRunner multi{config, DuplicateConfig{50, 1, DuplicateSeating::ROTATIONS, 2}, createCheckPlayer};
+    multi.run();
+    EXPECT_EQ(10, multi.getDealsPlayed());
+    EXPECT_EQ(10, multi.getPairResult(0, 1).deals);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "equity_player/equity_player.h"
+#include "game_test.h"
+#include "hand_log.h"
+
+TEST(EquityPlayer, Settings) {
+    EXPECT_NO_THROW(EquityPlayer(1));
+    EXPECT_NO_THROW(EquityPlayer(1, true, 1, 0, EQUITY_PLAYER_MAX_THREADS));
+    EXPECT_THROW(EquityPlayer(1, true, 0), std::invalid_argument);
+    EXPECT_THROW(EquityPlayer(1, true, 100, 0, 0), std::invalid_argument);
+    EXPECT_THROW(EquityPlayer(1, true, 100, 0, EQUITY_PLAYER_MAX_THREADS + 1), std::invalid_argument);
+}
+
+TEST(EquityPlayer, KnownEquities) {
+    const Card community[5] = {Card{14, 0}, Card{14, 1}, Card{14, 2}, Card{2, 0}, Card{3, 1}};
+    // four aces with king kicker on the river cannot be beaten
+    EXPECT_DOUBLE_EQ(1, EquityPlayer::estimateEquity({Card{14, 3}, Card{13, 0}}, community, 5, 4, 1000));
+    // without opponents the whole pot is won
+    EXPECT_DOUBLE_EQ(1, EquityPlayer::estimateEquity({Card{2, 2}, Card{7, 3}}, community, 0, 0, 1000));
+    // pocket aces preflop against one random hand win about 85%
+    const double aces = EquityPlayer::estimateEquity({Card{14, 0}, Card{14, 1}}, community, 0, 1, 20000, 0, 1, 42);
+    EXPECT_NEAR(0.85, aces, 0.02);
+    // the same estimate with multiple threads
+    const double acesThreads = EquityPlayer::estimateEquity({Card{14, 0}, Card{14, 1}}, community, 0, 1, 20000, 0, 4, 42);
+    EXPECT_NEAR(0.85, acesThreads, 0.02);
+    // 72 offsuit preflop is weaker against more opponents
+    const double trash1 = EquityPlayer::estimateEquity({Card{7, 0}, Card{2, 1}}, community, 0, 1, 20000, 0, 1, 42);
+    const double trash4 = EquityPlayer::estimateEquity({Card{7, 0}, Card{2, 1}}, community, 0, 4, 20000, 0, 1, 42);
+    EXPECT_NEAR(0.35, trash1, 0.03);
+    EXPECT_LT(trash4, trash1);
+}
+
+TEST(EquityPlayer, TimeBudget) {
+    const Card community[5]{};
+    // with a tiny time budget only the first batch of samples is taken
+    const double equity = EquityPlayer::estimateEquity({Card{14, 0}, Card{14, 1}}, community, 0, 4, UINT32_MAX, 1, 1, 42);
+    EXPECT_GE(equity, 0);
+    EXPECT_LE(equity, 1);
+}
+
+TEST(EquityPlayer, PlaysLegalMoves) {
+    // a game where only equity players play, the hands with an illegal move are counted by the hand log
+    HandLog::reset();
+    HandLog::addTrigger(HandLogTrigger::ILLEGAL_MOVE);
+    GameTest game{Config{20, 5, 1000, 10, 1, true, true, 30}};
+    std::unique_ptr<Player> players[5];
+    for (u_int8_t i = 0; i < 5; i++) players[i] = std::make_unique<EquityPlayer>(i, true, 50, 0, i % 2 + 1);
+    game.setPlayers(players);
+    game.run(false);
+    EXPECT_GT(game.getProgressCounters().rounds.get(), 0);
+    EXPECT_EQ(0, HandLog::getLoggedHands());
+    HandLog::reset();
+}
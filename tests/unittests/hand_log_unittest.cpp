@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <regex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "game.h"
+#include "hand_log.h"
+
+namespace {
+/// @brief Collects the records that pass the hand log appender
+class CollectAppender : public plog::IAppender {
+   public:
+    void write(const plog::Record& record) override {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->records.emplace_back(record.getSeverity(), record.getMessage());
+    }
+
+    /// @brief Gets and removes the collected records
+    std::vector<std::pair<plog::Severity, std::string>> take() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return std::move(this->records);
+    }
+
+   private:
+    std::mutex mutex;
+    std::vector<std::pair<plog::Severity, std::string>> records;
+};
+
+/// @brief Gets the collector behind the hand log appender of the logger (the logger keeps its appenders until the end)
+/// @return The collector without records
+CollectAppender& getCollector() {
+    static CollectAppender collector;
+    static HandLogAppender handLogAppender;
+    static const bool added = [&]() {
+        handLogAppender.addAppender(&collector);
+        plog::get()->addAppender(&handLogAppender);
+        return true;
+    }();
+    static_cast<void>(added);
+    collector.take();
+    return collector;
+}
+}  // namespace
+
+TEST(HandLogTest, Configure) {
+    HandLog::reset();
+    EXPECT_FALSE(HandLog::isActive());
+    EXPECT_TRUE(HandLog::isDetailed());
+    HandLog::configure("1000,allin,illegal");
+    EXPECT_TRUE(HandLog::isActive());
+    HandLog::configure("split");
+    EXPECT_TRUE(HandLog::isActive());
+    for (const char* spec : {"", "0", "foo", "10,20", "allin,", "-5", "12345678901"}) EXPECT_THROW(HandLog::configure(spec), std::invalid_argument) << spec;
+    HandLog::reset();
+    EXPECT_FALSE(HandLog::isActive());
+}
+
+TEST(HandLogTest, Sampling) {
+    CollectAppender& collector = getCollector();
+    HandLog::reset();
+    HandLog::setSampleRate(4);
+    // a new thread starts with the first hand
+    std::thread([]() {
+        for (u_int32_t i = 0; i < 8; i++) {
+            const HandLogScope handLogScope;
+            POKER_HAND_LOG << "hand " << i;
+        }
+        // outside of the hands
+        POKER_HAND_LOG << "between the hands";
+        PLOG_DEBUG << "between the hands";
+    }).join();
+    const std::vector<std::pair<plog::Severity, std::string>> records = collector.take();
+    ASSERT_EQ(2, records.size());
+    EXPECT_EQ("hand 0", records[0].second);
+    EXPECT_EQ("hand 4", records[1].second);
+    EXPECT_EQ(2, HandLog::getLoggedHands());
+    HandLog::reset();
+}
+
+TEST(HandLogTest, Triggers) {
+    CollectAppender& collector = getCollector();
+    HandLog::reset();
+    HandLog::addTrigger(HandLogTrigger::SPLIT_POT);
+    std::thread([&collector]() {
+        {
+            // no trigger: only the info is written
+            const HandLogScope handLogScope;
+            POKER_HAND_LOG << "detail 1";
+            PLOG_INFO << "info 1";
+            HandLog::fire(HandLogTrigger::ALL_IN_SHOWDOWN);
+            // captured until the end of the hand
+            EXPECT_EQ(0, collector.take().size());
+        }
+        {
+            const HandLogScope handLogScope;
+            POKER_HAND_LOG << "detail 2";
+            PLOG_WARNING << "warning 2";
+            HandLog::fire(HandLogTrigger::SPLIT_POT);
+        }
+    }).join();
+    const std::vector<std::pair<plog::Severity, std::string>> records = collector.take();
+    ASSERT_EQ(3, records.size());
+    EXPECT_EQ(std::make_pair(plog::info, std::string("info 1")), records[0]);
+    // the kept hand is written in order
+    EXPECT_EQ(std::make_pair(plog::debug, std::string("detail 2")), records[1]);
+    EXPECT_EQ(std::make_pair(plog::warning, std::string("warning 2")), records[2]);
+    EXPECT_EQ(1, HandLog::getLoggedHands());
+    HandLog::reset();
+}
+
+TEST(HandLogTest, Game) {
+    CollectAppender& collector = getCollector();
+    HandLog::reset();
+    HandLog::configure("10,split");
+    Game game{Config{20, 4, 1000, 10, 1, true, true, 50, false, 0, Actions::FOLD, 0}};
+    std::thread([&game]() { game.run(); }).join();
+    u_int64_t hands = 0;
+    for (const std::pair<plog::Severity, std::string>& record : collector.take()) {
+        if (record.first != plog::debug) continue;
+        // every kept hand starts with its round
+        if (record.second.rfind("Starting round", 0) == 0) hands++;
+        // the debug records between the games are dropped
+        EXPECT_NE(0, record.second.rfind("Starting game", 0)) << record.second;
+    }
+    EXPECT_EQ(HandLog::getLoggedHands(), hands);
+    // one of ten hands and the split pots
+    EXPECT_GE(hands, game.getProgressCounters().rounds.get() / 10);
+    EXPECT_LT(hands, game.getProgressCounters().rounds.get());
+    HandLog::reset();
+}
+
+TEST(HandLogTest, NarrowChips) {
+    CollectAppender& collector = getCollector();
+    HandLog::reset();
+    HandLog::configure("1");
+    BasicGame<2, u_int32_t> game{BasicConfig<2, u_int32_t>{5, 2, 1000, 10, 0, true, true, 20}};
+    std::thread([&game]() { game.run(); }).join();
+    // the blinds and losses of a 32 bit table are logged as small signed differences, not wrapped around
+    const std::regex chipsDiff{"\\[(\\d+) [+-] (\\d+)\\]"};
+    u_int64_t diffs = 0;
+    for (const std::pair<plog::Severity, std::string>& record : collector.take()) {
+        for (std::sregex_iterator it{record.second.begin(), record.second.end(), chipsDiff}; it != std::sregex_iterator{}; ++it) {
+            EXPECT_LE(std::stoull((*it)[1].str()), 2000) << record.second;
+            EXPECT_LE(std::stoull((*it)[2].str()), 2000) << record.second;
+            diffs++;
+        }
+    }
+    EXPECT_GT(diffs, 0);
+    HandLog::reset();
+}
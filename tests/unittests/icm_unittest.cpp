@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numeric>
+
+#include "icm.h"
+
+namespace {
+/// @brief Computes the ICM equities by enumerating the finish orders of the paid places
+/// @param stacks The stacks
+/// @param payouts The prizes of the places
+/// @param placed The mask of the players that took the first places
+/// @param prob The probability of the places of the placed players
+/// @param equities The equities the prizes of the next places are added to
+void enumerateOrders(const std::vector<u_int64_t>& stacks, const std::vector<double>& payouts, const u_int32_t placed, const double prob, std::vector<double>& equities) {
+    const u_int32_t place = __builtin_popcount(placed);
+    if (place == payouts.size() || place == stacks.size()) return;
+    double left = 0;
+    for (u_int32_t i = 0; i < stacks.size(); i++) {
+        if (!(placed >> i & 1)) left += stacks[i];
+    }
+    for (u_int32_t i = 0; i < stacks.size(); i++) {
+        if (placed >> i & 1) continue;
+        const double next = prob * stacks[i] / left;
+        equities[i] += next * payouts[place];
+        enumerateOrders(stacks, payouts, placed | 1 << i, next, equities);
+    }
+}
+}  // namespace
+
+TEST(IcmTest, Exact) {
+    const std::vector<double> payouts{50, 30, 20};
+    IcmCalculator icm{payouts};
+    // the textbook example
+    const std::vector<double>& equities = icm.getEquities({5000, 3000, 2000});
+    EXPECT_NEAR(38.393, equities[0], 1e-3);
+    EXPECT_NEAR(32.750, equities[1], 1e-3);
+    EXPECT_NEAR(28.857, equities[2], 1e-3);
+
+    // every field up to MAX_PLAYERS matches the enumeration of the finish orders
+    const std::vector<double> morePayouts{40, 25, 15, 10, 6, 4};
+    IcmCalculator moreIcm{morePayouts};
+    for (u_int8_t players = 1; players <= MAX_PLAYERS; players++) {
+        std::vector<u_int64_t> stacks;
+        for (u_int8_t i = 0; i < players; i++) stacks.push_back(100 + 37 * i * i);
+        std::vector<double> expected(players, 0.0);
+        enumerateOrders(stacks, morePayouts, 0, 1, expected);
+        const std::vector<double>& actual = moreIcm.getEquities(stacks);
+        for (u_int8_t i = 0; i < players; i++) EXPECT_NEAR(expected[i], actual[i], 1e-9);
+        // the players can take the first places only
+        EXPECT_NEAR(std::accumulate(morePayouts.begin(), morePayouts.begin() + std::min<u_int8_t>(players, morePayouts.size()), 0.0),
+                    std::accumulate(actual.begin(), actual.end(), 0.0), 1e-9);
+    }
+}
+
+TEST(IcmTest, BustedPlayers) {
+    IcmCalculator icm{{70, 30}};
+    // the busted players are not part of the field, even in a field that is bigger than MAX_PLAYERS
+    std::vector<u_int64_t> stacks(3 * MAX_PLAYERS, 0);
+    stacks[3] = 1000;
+    stacks[17] = 1000;
+    const std::vector<double>& equities = icm.getEquities(stacks);
+    for (u_int32_t i = 0; i < stacks.size(); i++) EXPECT_EQ(i == 3 || i == 17 ? 50 : 0, equities[i]);
+    EXPECT_EQ(70, icm.getEquities({0, 1, 0})[1]);
+    EXPECT_EQ(0, icm.getEquities({0, 0})[0]);
+}
+
+TEST(IcmTest, MonteCarlo) {
+    // the sampled finish orders converge to the exact equities
+    const std::vector<u_int64_t> stacks{1200, 300, 5000, 800, 800, 2500, 100, 4000};
+    const std::vector<double> payouts{50, 30, 20};
+    double exact[8];
+    double estimated[8];
+    IcmCalculator::computeExact(stacks.data(), stacks.size(), payouts, exact);
+    IcmCalculator::computeMonteCarlo(stacks.data(), stacks.size(), payouts, 200000, 3, estimated);
+    for (u_int8_t i = 0; i < stacks.size(); i++) EXPECT_NEAR(exact[i], estimated[i], 0.3);
+
+    // a big field is estimated, the same stacks get the same estimate
+    std::vector<u_int64_t> field(50, 1000);
+    field[0] = 10000;
+    IcmCalculator icm{{50, 30, 20}, 20000, 5, 0};
+    const std::vector<double> equities = icm.getEquities(field);
+    EXPECT_NEAR(100, std::accumulate(equities.begin(), equities.end(), 0.0), 1e-9);
+    EXPECT_GT(equities[0], equities[1] * 5);
+    EXPECT_LT(equities[0], equities[1] * 10);
+    EXPECT_NEAR(equities[1], equities[49], 0.5);
+    EXPECT_EQ(equities, icm.getEquities(field));
+}
+
+TEST(IcmTest, Cache) {
+    IcmCalculator icm{{65, 35}, 1000, 0, 2};
+    const std::vector<double> first = icm.getEquities({100, 200, 300});
+    EXPECT_EQ(first, icm.getEquities({100, 200, 300}));
+    EXPECT_EQ(1, icm.getCacheHits());
+    EXPECT_EQ(1, icm.getCacheMisses());
+    icm.getEquities({100, 300, 200});
+    // the full cache is cleared
+    icm.getEquities({300, 200, 100});
+    EXPECT_EQ(first, icm.getEquities({100, 200, 300}));
+    EXPECT_EQ(1, icm.getCacheHits());
+    EXPECT_EQ(4, icm.getCacheMisses());
+
+    // the stacks of a table by position
+    Data data{};
+    data.numPlayers = 3;
+    data.gameData.playerChips[0] = 100;
+    data.gameData.playerChips[1] = 200;
+    data.gameData.playerChips[2] = 300;
+    EXPECT_EQ(first, icm.getEquities(data));
+    EXPECT_EQ(2, icm.getCacheHits());
+
+    EXPECT_THROW((IcmCalculator{{50, -1}}), std::invalid_argument);
+    EXPECT_THROW((IcmCalculator{{50, NAN}}), std::invalid_argument);
+    EXPECT_THROW((IcmCalculator{{50}, 0}), std::invalid_argument);
+}
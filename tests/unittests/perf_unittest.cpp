@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "perf_counters.h"
+
+TEST(PerfTest, Counters) {
+    PerfCounters counters;
+    volatile u_int64_t sum = 0;
+    {
+        const PerfScope perfScope{&counters};
+        for (u_int32_t i = 0; i < 100000; i++) sum += i;
+    }
+    const PerfValues values = counters.read();
+    if (!counters.isAvailable()) {
+        // without perf_event_open every counter stays 0
+        EXPECT_EQ(0, values.instructions);
+        EXPECT_EQ(0, values.cycles);
+        EXPECT_EQ(0, values.branchMisses);
+        return;
+    }
+    // the loop has at least one instruction and one branch per iteration, the values may be 0 if the CPU does not count the event
+    if (values.instructions != 0) {
+        EXPECT_GE(values.instructions, 100000);
+    }
+    if (values.branches != 0) {
+        EXPECT_GE(values.branches, 100000);
+    }
+    EXPECT_LE(values.branchMisses, values.branches);
+    // the counters are stopped outside of the scope
+    for (u_int32_t i = 0; i < 100000; i++) sum += i;
+    EXPECT_EQ(values.instructions, counters.read().instructions);
+    counters.reset();
+    EXPECT_EQ(0, counters.read().instructions);
+}
+
+TEST(PerfTest, NoCounters) {
+    // a scope without counters counts nothing
+    const PerfScope perfScope{nullptr};
+    PerfCounters counters;
+    counters.logReport("an empty phase", 0, "hand");
+    EXPECT_EQ(0, counters.read().cycles);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "check_player/check_player.h"
+#include "game_test.h"
+#include "philox.h"
+
+TEST(PhiloxTest, KnownAnswers) {
+    // the known answer tests of Random123 for philox4x32_10
+    EXPECT_EQ((Philox::Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}), Philox::generate(Philox::Block{0, 0, 0, 0}, Philox::Key{0, 0}));
+    EXPECT_EQ((Philox::Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}),
+              Philox::generate(Philox::Block{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, Philox::Key{0xffffffff, 0xffffffff}));
+    EXPECT_EQ((Philox::Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}),
+              Philox::generate(Philox::Block{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, Philox::Key{0xa4093822, 0x299f31d0}));
+}
+
+TEST(PhiloxTest, Streams) {
+    // the same coordinates give the same numbers, other coordinates give other numbers
+    Philox a{42, 7341902, 3, RandomStream::DECK};
+    Philox b{42, 7341902, 3, RandomStream::DECK};
+    Philox otherRound{42, 7341902, 4, RandomStream::DECK};
+    Philox otherStream{42, 7341902, 3, RandomStream::PLAYER_ORDER};
+    Philox otherSeed{43, 7341902, 3, RandomStream::DECK};
+    u_int32_t equalRound = 0, equalStream = 0, equalSeed = 0;
+    for (u_int32_t i = 0; i < 100; i++) {
+        const u_int32_t value = a.next();
+        EXPECT_EQ(value, b.next());
+        equalRound += value == otherRound.next();
+        equalStream += value == otherStream.next();
+        equalSeed += value == otherSeed.next();
+    }
+    EXPECT_LE(equalRound, 1);
+    EXPECT_LE(equalStream, 1);
+    EXPECT_LE(equalSeed, 1);
+
+    // the first number is the high half of a 64 bit number
+    Philox wide{42, 7341902, 3, RandomStream::DECK};
+    Philox halves{42, 7341902, 3, RandomStream::DECK};
+    for (u_int32_t i = 0; i < 10; i++) {
+        const u_int64_t high = halves.next();
+        EXPECT_EQ(high << 32 | halves.next(), wide.next64());
+    }
+
+    // every value below the bound is drawn about equally often
+    u_int32_t counts[7]{};
+    Philox rng{1, 0, 0, RandomStream::ALL_IN_EV};
+    for (u_int32_t i = 0; i < 70000; i++) {
+        const u_int32_t value = rng.uniform(7);
+        ASSERT_LT(value, 7);
+        counts[value]++;
+    }
+    for (const u_int32_t count : counts) {
+        EXPECT_NEAR(10000, count, 500);
+    }
+}
+
+TEST(PhiloxTest, Deck) {
+    Deck deck;
+    deck.shuffle(42, 7341902, 3);
+    Deck replay;
+    // the deck of a round does not depend on the rounds before
+    replay.shuffle(42, 7341902, 2);
+    replay.shuffle(42, 7341902, 3);
+    bool seen[CARD_NUM]{};
+    for (u_int8_t i = 0; i < CARD_NUM; i++) {
+        const Card card = deck.draw();
+        EXPECT_EQ(card, replay.draw());
+        const u_int8_t index = card.suit * 13 + card.rank - 2;
+        EXPECT_FALSE(seen[index]);
+        seen[index] = true;
+    }
+    Deck other;
+    other.shuffle(42, 7341902, 4);
+    Deck again;
+    again.shuffle(42, 7341902, 3);
+    u_int8_t equal = 0;
+    for (u_int8_t i = 0; i < CARD_NUM; i++) equal += other.draw() == again.draw();
+    EXPECT_LT(equal, CARD_NUM);
+}
+
+TEST(PhiloxTest, Shards) {
+    // check players do not use any random numbers, so a seeded game only depends on its coordinates
+    const auto play = [](const u_int64_t firstGame, const u_int16_t numGames, u_int32_t gameWins[], u_int64_t chipWins[]) {
+        GameTest game{Config{numGames, 4, 1000, 10, 1, true, true, 100, false, 0, Actions::FOLD, 0}};
+        std::unique_ptr<Player> players[4];
+        for (u_int8_t i = 0; i < 4; i++) players[i] = std::make_unique<CheckPlayer>(i + 1);
+        game.setPlayers(players);
+        game.setSeed(1234, firstGame);
+        game.run(false);
+        for (u_int8_t i = 0; i < 4; i++) {
+            gameWins[i] += game.getData().gameData.gameWins[i];
+            chipWins[i] += game.getData().gameData.chipWinsAmount[i];
+        }
+    };
+    u_int32_t gameWins[4]{}, shardGameWins[4]{};
+    u_int64_t chipWins[4]{}, shardChipWins[4]{};
+    play(0, 30, gameWins, chipWins);
+    // the same games in shards of different sizes and order
+    play(20, 10, shardGameWins, shardChipWins);
+    play(0, 7, shardGameWins, shardChipWins);
+    play(7, 13, shardGameWins, shardChipWins);
+    for (u_int8_t i = 0; i < 4; i++) {
+        EXPECT_EQ(gameWins[i], shardGameWins[i]);
+        EXPECT_EQ(chipWins[i], shardChipWins[i]);
+    }
+    u_int64_t totalChips = 0;
+    for (u_int8_t i = 0; i < 4; i++) totalChips += chipWins[i];
+    EXPECT_NE(0, totalChips);
+}
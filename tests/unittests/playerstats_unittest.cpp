@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "game_test.h"
+#include "test_player/test_player.h"
+
+TEST(PlayerStats, Rates) {
+    PlayerStats stats{};
+    EXPECT_EQ(0, stats.getVPIP());
+    EXPECT_EQ(0, stats.getPFR());
+    EXPECT_EQ(0, stats.getAggressionFactor());
+    EXPECT_EQ(0, stats.getFoldToBet());
+    EXPECT_EQ(0, stats.getShowdownFrequency());
+    EXPECT_EQ(0, stats.getShowdownWinRate());
+    for (u_int8_t i = 0; i < 4; i++) {
+        stats.startHand();
+        // only counted once per hand
+        stats.addVPIP();
+        stats.addVPIP();
+        if (i % 2 == 0) stats.addPFR();
+    }
+    stats.betsRaises = 3;
+    stats.calls = 2;
+    stats.facedBets = 4;
+    stats.foldsToBet = 1;
+    stats.sawFlop = 4;
+    stats.showdowns = 2;
+    stats.showdownsWon = 1;
+    EXPECT_EQ(4, stats.hands);
+    EXPECT_DOUBLE_EQ(1, stats.getVPIP());
+    EXPECT_DOUBLE_EQ(0.5, stats.getPFR());
+    EXPECT_DOUBLE_EQ(1.5, stats.getAggressionFactor());
+    EXPECT_DOUBLE_EQ(0.25, stats.getFoldToBet());
+    EXPECT_DOUBLE_EQ(0.5, stats.getShowdownFrequency());
+    EXPECT_DOUBLE_EQ(0.5, stats.getShowdownWinRate());
+}
+
+TEST(PlayerStats, CountedActions) {
+    // one round: player 0 raises preflop and bets the flop, player 1 calls both, player 2 (big blind) folds preflop
+    GameTest game{Config{1, 3, 1000, 10, 0, false, false, 1}};
+    const std::pair<Card, Card> hands[3] = {{Card{14, 0}, Card{14, 1}}, {Card{13, 0}, Card{13, 1}}, {Card{12, 0}, Card{12, 1}}};
+    const Card community[5] = {Card{2, 2}, Card{5, 3}, Card{7, 2}, Card{9, 3}, Card{11, 2}};
+    game.buildDeck(hands, 3, community);
+    const std::vector<Action> actions[3] = {{Action{Actions::RAISE, 60}, Action{Actions::BET, 100}, Action{Actions::CHECK}, Action{Actions::CHECK}},
+                                            {Action{Actions::CALL}, Action{Actions::CHECK}, Action{Actions::CALL}, Action{Actions::CHECK}, Action{Actions::CHECK}},
+                                            {Action{Actions::FOLD}}};
+    for (u_int8_t i = 0; i < 3; i++) {
+        std::unique_ptr<TestPlayer> testPlayer = std::make_unique<TestPlayer>(i);
+        testPlayer->setActions(&actions[i][0], actions[i].size());
+        game.getPlayers()[i] = std::move(testPlayer);
+    }
+    game.run(false);
+    const PlayerStats* stats = game.getData().playerStats;
+    for (u_int8_t i = 0; i < 3; i++) EXPECT_EQ(1, stats[i].hands);
+    // raiser
+    EXPECT_EQ(1, stats[0].vpipHands);
+    EXPECT_EQ(1, stats[0].pfrHands);
+    EXPECT_EQ(2, stats[0].betsRaises);
+    EXPECT_EQ(0, stats[0].calls);
+    EXPECT_EQ(1, stats[0].facedBets);
+    EXPECT_EQ(1, stats[0].sawFlop);
+    EXPECT_EQ(1, stats[0].showdowns);
+    EXPECT_EQ(1, stats[0].showdownsWon);
+    // caller
+    EXPECT_EQ(1, stats[1].vpipHands);
+    EXPECT_EQ(0, stats[1].pfrHands);
+    EXPECT_EQ(0, stats[1].betsRaises);
+    EXPECT_EQ(2, stats[1].calls);
+    EXPECT_EQ(2, stats[1].facedBets);
+    EXPECT_EQ(0, stats[1].foldsToBet);
+    EXPECT_EQ(1, stats[1].sawFlop);
+    EXPECT_EQ(1, stats[1].showdowns);
+    EXPECT_EQ(0, stats[1].showdownsWon);
+    // big blind folds to the raise
+    EXPECT_EQ(0, stats[2].vpipHands);
+    EXPECT_EQ(1, stats[2].facedBets);
+    EXPECT_EQ(1, stats[2].foldsToBet);
+    EXPECT_EQ(0, stats[2].sawFlop);
+    EXPECT_EQ(0, stats[2].showdowns);
+}
+
+TEST(PlayerStats, IllegalActionsNotCounted) {
+    // player 0 bets into the big blind, which is illegal, and is out of the game, player 1 folds to the big blind
+    GameTest game{Config{1, 3, 1000, 10, 0, false, false, 1}};
+    const std::vector<Action> actions[3] = {{Action{Actions::BET, 60}}, {Action{Actions::FOLD}}, {}};
+    for (u_int8_t i = 0; i < 3; i++) {
+        std::unique_ptr<TestPlayer> testPlayer = std::make_unique<TestPlayer>(i);
+        testPlayer->setActions(actions[i].data(), actions[i].size());
+        game.getPlayers()[i] = std::move(testPlayer);
+    }
+    game.run(false);
+    const PlayerStats* stats = game.getData().playerStats;
+    EXPECT_EQ(0, stats[0].betsRaises);
+    EXPECT_EQ(0, stats[0].vpipHands);
+    EXPECT_EQ(0, stats[0].pfrHands);
+    EXPECT_EQ(0, stats[0].facedBets);
+    EXPECT_EQ(1, stats[1].facedBets);
+    EXPECT_EQ(1, stats[1].foldsToBet);
+}
+
+TEST(PlayerStats, FollowPlayers) {
+    GameTest game{Config{1, 5, 1000, 10, 1}};
+    game.setRealisticPlayers();
+    for (u_int8_t i = 0; i < 5; i++) game.getPlayers()[i]->setPlayerId(i);
+    const Player* players[5];
+    for (u_int8_t i = 0; i < 5; i++) players[i] = game.getPlayers()[i].get();
+    for (u_int8_t iter = 0; iter < 20; iter++) {
+        // the statistics are indexed by the player ids and are not touched by the shuffle
+        for (u_int8_t i = 0; i < 5; i++) game.getData().playerStats[i].hands = i;
+        game.initPlayerOrder();
+        bool seen[5]{};
+        for (u_int8_t i = 0; i < 5; i++) {
+            const u_int8_t id = game.getData().getPlayerId(i);
+            EXPECT_EQ(players[id], game.getPlayers()[i].get());
+            EXPECT_EQ(id, game.getData().playerStats[id].hands);
+            EXPECT_FALSE(seen[id]);
+            seen[id] = true;
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include "pot.h"
 
+#include "data_structs.h"
+
 #include <gtest/gtest.h>
 
 TEST(PotTest, isCapped) {
@@ -77,3 +79,71 @@ TEST(PotTest, addNonContender) {
         if (i >= 2) pot.addNonContender(i);
     }
 }
+
+TEST(PotTest, split) {
+    Pot pot;
+    pot.addChips(100);
+    pot.addChips(100);
+    pot.addNonContender(3);
+    Pot upper = pot.split(40, 120);
+    EXPECT_EQ(pot.getPotValue(), 80);
+    EXPECT_EQ(pot.getCap(), 40);
+    EXPECT_EQ(upper.getPotValue(), 120);
+    EXPECT_FALSE(upper.isCapped());
+    EXPECT_FALSE(upper.isContender(3));
+    Pot top = upper.split(20, 80);
+    EXPECT_EQ(upper.getPotValue(), 40);
+    EXPECT_EQ(upper.getCap(), 20);
+    EXPECT_EQ(top.getPotValue(), 80);
+    EXPECT_FALSE(top.isCapped());
+    // split of a capped pot keeps the remaining cap
+    Pot middle = pot.split(10, 60);
+    EXPECT_EQ(pot.getCap(), 10);
+    EXPECT_EQ(middle.getCap(), 30);
+    EXPECT_EQ(pot.getPotValue() + middle.getPotValue(), 80);
+}
+
+TEST(PotTest, sidePots) {
+    Data data{};
+    data.numPlayers = 5;
+    data.resetPots();
+    auto bet = [&data](const u_int8_t playerPos, const u_int64_t chips, const bool allIn) {
+        data.betRoundData.playerPos = playerPos;
+        data.addPlayerBet(chips);
+        if (allIn) data.capPots();
+    };
+    bet(0, 50, true);
+    bet(1, 200, false);
+    bet(2, 120, true);
+    bet(3, 200, false);
+    ASSERT_EQ(data.roundData.numPots, 3);
+    EXPECT_EQ(data.roundData.pots[0].getCap(), 50);
+    EXPECT_EQ(data.roundData.pots[0].getPotValue(), 200);
+    EXPECT_EQ(data.roundData.pots[1].getCap(), 70);
+    EXPECT_EQ(data.roundData.pots[1].getPotValue(), 210);
+    EXPECT_FALSE(data.roundData.pots[2].isCapped());
+    EXPECT_EQ(data.roundData.pots[2].getPotValue(), 160);
+    for (u_int8_t i = 0; i < 4; i++) EXPECT_TRUE(data.roundData.pots[0].isContender(i));
+    EXPECT_FALSE(data.roundData.pots[1].isContender(0));
+    EXPECT_TRUE(data.roundData.pots[1].isContender(2));
+    EXPECT_FALSE(data.roundData.pots[2].isContender(0));
+    EXPECT_FALSE(data.roundData.pots[2].isContender(2));
+    // the highest all-in opens an empty pot for later bets
+    bet(1, 100, false);
+    bet(3, 100, true);
+    ASSERT_EQ(data.roundData.numPots, 4);
+    EXPECT_EQ(data.roundData.pots[2].getCap(), 180);
+    EXPECT_EQ(data.roundData.pots[2].getPotValue(), 360);
+    EXPECT_EQ(data.roundData.pots[3].getPotValue(), 0);
+    EXPECT_FALSE(data.roundData.pots[3].isContender(3));
+    // an all-in with the same amount as an existing cap does not open a new pot
+    bet(4, 300, true);
+    ASSERT_EQ(data.roundData.numPots, 4);
+    EXPECT_EQ(data.roundData.pots[0].getPotValue(), 250);
+    EXPECT_EQ(data.roundData.pots[1].getPotValue(), 280);
+    EXPECT_EQ(data.roundData.pots[2].getPotValue(), 540);
+    EXPECT_FALSE(data.roundData.pots[3].isContender(4));
+    u_int64_t sum = 0;
+    for (u_int8_t i = 0; i < data.roundData.numPots; i++) sum += data.roundData.pots[i].getPotValue();
+    EXPECT_EQ(sum, data.roundData.pot);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "duplicate_runner.h"
+#include "game_test.h"
+
+TEST(ProgressTest, Counters) {
+    ProgressCounters counters;
+    counters.games.add();
+    counters.evaluations.add(5);
+    counters.evaluations.add();
+    EXPECT_EQ(1, counters.games.get());
+    EXPECT_EQ(6, counters.evaluations.get());
+    EXPECT_EQ(0, counters.rounds.get());
+    // the counters of different threads never share a cache line
+    EXPECT_EQ(0, alignof(ProgressCounters) % 64);
+}
+
+TEST(ProgressTest, GameCounters) {
+    Game game{Config{5, 4, 1000, 10, 1, true, true, 40}};
+    game.run();
+    const ProgressCounters& counters = game.getProgressCounters();
+    EXPECT_EQ(5, counters.games.get());
+    EXPECT_GE(counters.rounds.get(), 5);
+    EXPECT_GT(counters.actions.get(), counters.rounds.get());
+    EXPECT_LE(counters.showdowns.get(), counters.rounds.get());
+    EXPECT_LE(counters.allInSettlements.get(), counters.showdowns.get());
+    // every showdown evaluates at least two hands
+    EXPECT_GE(counters.evaluations.get(), 2 * counters.showdowns.get());
+    // the counters are not reset, they count the work of every run
+    ProgressCounters external;
+    game.setProgressCounters(external);
+    game.run();
+    EXPECT_EQ(5, counters.games.get());
+    EXPECT_EQ(5, external.games.get());
+    EXPECT_EQ(&external, &game.getProgressCounters());
+}
+
+TEST(ProgressTest, Reporter) {
+    const std::string path = testing::TempDir() + "progress_test.prom";
+    ProgressCounters counters;
+    ProgressReporter reporter{std::chrono::milliseconds(10), 100, path};
+    reporter.watch(counters);
+    ProgressCounters& owned = reporter.createCounters();
+    reporter.start();
+    for (u_int8_t i = 0; i < 7; i++) counters.games.add();
+    owned.games.add(3);
+    owned.rounds.add(42);
+    reporter.stop();
+    // the final report sums the counters of both threads
+    std::ifstream file(path);
+    const std::string metrics((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, metrics.find("# TYPE poker_games_total counter\npoker_games_total 10\n"));
+    EXPECT_NE(std::string::npos, metrics.find("poker_rounds_total 42\n"));
+    EXPECT_NE(std::string::npos, metrics.find("poker_games_target 100\n"));
+    EXPECT_NE(std::string::npos, metrics.find("# TYPE poker_games_per_second gauge\n"));
+    reporter.stop();
+}
+
+TEST(ProgressTest, DuplicateThreads) {
+    const std::string path = testing::TempDir() + "progress_duplicate.prom";
+    DuplicateRunner runner{Config{1, 3, 1000, 10, 1, false, false, 20}, DuplicateConfig{6, 5, DuplicateSeating::ROTATIONS, 3}, createCheckPlayer};
+    ProgressReporter reporter{std::chrono::seconds(60), 6 * 3, path};
+    runner.setProgressReporter(&reporter);
+    reporter.start();
+    runner.run();
+    reporter.stop();
+    // every thread counted its games in its own counters, the report sums them (6 deal sequences with 3 rotations of 1 game)
+    std::ifstream file(path);
+    const std::string metrics((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(std::string::npos, metrics.find("poker_games_total 18\n"));
+}
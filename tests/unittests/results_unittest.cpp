@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "game.h"
+
+namespace {
+/// @brief Reads a whole file
+/// @param path The path of the file
+/// @return The content of the file
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// @brief Reads a file line by line
+/// @param path The path of the file
+/// @return The lines of the file
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);) lines.push_back(line);
+    return lines;
+}
+
+/// @brief Writes more games than fit into all batches, so the simulation thread has to reuse the written batches
+/// @param sink The sink, it is closed afterwards
+/// @param games The number of games
+void writeRecords(ResultsSink& sink, const u_int32_t games) {
+    for (u_int32_t i = 0; i < games; i++) sink.addGame(GameRecord{i, i % 7 + 1, 1u << (i % 2), {(int64_t)i, -(int64_t)i}});
+    SummaryRecord summary{games, {games / 2, games / 2}, {3, 4}, {5, 6}, {5.5, 6.25}};
+    sink.addSummary(summary);
+    sink.close();
+}
+}  // namespace
+
+TEST(ResultsTest, CSV) {
+    const std::string path = testing::TempDir() + "results_test.csv";
+    const u_int32_t games = RESULTS_SINK_BATCH_SIZE * RESULTS_SINK_BATCHES * 2 + 3;
+    ResultsSink sink{path, ResultsFormat::CSV, 2};
+    writeRecords(sink, games);
+    const std::vector<std::string> lines = readLines(path);
+    ASSERT_EQ(1 + games + 4, lines.size());
+    EXPECT_EQ("type,game,rounds,winners,player0,player1", lines[0]);
+    EXPECT_EQ("game,0,1,0,0,0", lines[1]);
+    EXPECT_EQ("game,9,3,1,9,-9", lines[10]);
+    // the games are written in order
+    EXPECT_EQ("game," + std::to_string(games - 1) + ",", lines[games].substr(0, 6 + std::to_string(games - 1).size()));
+    EXPECT_EQ("gameWins," + std::to_string(games) + ",,," + std::to_string(games / 2) + "," + std::to_string(games / 2), lines[games + 1]);
+    EXPECT_EQ("chipWinsEV," + std::to_string(games) + ",,,5.5,6.25", lines[games + 4]);
+}
+
+TEST(ResultsTest, JSONL) {
+    const std::string path = testing::TempDir() + "results_test.jsonl";
+    ResultsSink sink{path, ResultsFormat::JSONL, 2};
+    writeRecords(sink, 10);
+    const std::vector<std::string> lines = readLines(path);
+    ASSERT_EQ(11, lines.size());
+    EXPECT_EQ("{\"type\":\"game\",\"game\":3,\"rounds\":4,\"winners\":[1],\"chipDeltas\":[3,-3]}", lines[3]);
+    EXPECT_EQ("{\"type\":\"summary\",\"games\":10,\"gameWins\":[5,5],\"chipWins\":[3,4],\"chipWinsAmount\":[5,6],\"chipWinsEV\":[5.5,6.25]}", lines[10]);
+}
+
+TEST(ResultsTest, Binary) {
+    const std::string path = testing::TempDir() + "results_test.bin";
+    ResultsSink sink{path, ResultsFormat::BINARY, 2};
+    writeRecords(sink, 10);
+    const std::string data = readFile(path);
+    const size_t headerSize = constexpr_strlen(RESULTS_SINK_BINARY_MAGIC) + 2;
+    const size_t gameSize = 1 + 8 + 4 + 4 + 2 * 8;
+    ASSERT_EQ(headerSize + 10 * gameSize + 1 + 8 + 2 * (4 + 4 + 8 + 8), data.size());
+    EXPECT_EQ(RESULTS_SINK_BINARY_MAGIC, data.substr(0, 4));
+    EXPECT_EQ(RESULTS_SINK_BINARY_VERSION, data[4]);
+    EXPECT_EQ(2, data[5]);
+    // the fourth game record
+    const char* record = data.data() + headerSize + 3 * gameSize;
+    EXPECT_EQ('G', record[0]);
+    u_int64_t game;
+    int64_t chipDelta;
+    std::memcpy(&game, record + 1, sizeof(game));
+    std::memcpy(&chipDelta, record + 1 + 8 + 4 + 4 + 8, sizeof(chipDelta));
+    EXPECT_EQ(3, game);
+    EXPECT_EQ(-3, chipDelta);
+    EXPECT_EQ('S', data[headerSize + 10 * gameSize]);
+}
+
+TEST(ResultsTest, Format) {
+    EXPECT_EQ(ResultsFormat::CSV, ResultsSink::getFormat("out/results.csv"));
+    EXPECT_EQ(ResultsFormat::JSONL, ResultsSink::getFormat("results.jsonl"));
+    EXPECT_EQ(ResultsFormat::BINARY, ResultsSink::getFormat("results.bin"));
+    EXPECT_THROW(ResultsSink::getFormat("results.txt"), std::invalid_argument);
+    EXPECT_THROW(ResultsSink::getFormat(".csv"), std::invalid_argument);
+    EXPECT_THROW((ResultsSink{testing::TempDir() + "missing_dir/results.csv", ResultsFormat::CSV, 2}), std::invalid_argument);
+    EXPECT_THROW((ResultsSink{testing::TempDir() + "results_test.csv", ResultsFormat::CSV, 1}), std::invalid_argument);
+}
+
+TEST(ResultsTest, GameRecords) {
+    const std::string path = testing::TempDir() + "results_game.bin";
+    Game game{Config{20, 3, 1000, 10, 1, true, true, 30}};
+    ResultsSink wrongSink{testing::TempDir() + "results_wrong.bin", ResultsFormat::BINARY, 4};
+    EXPECT_THROW(game.setResultsSink(&wrongSink), std::invalid_argument);
+    {
+        ResultsSink sink{path, ResultsFormat::BINARY, 3};
+        game.setResultsSink(&sink);
+        game.run();
+    }
+    const std::string data = readFile(path);
+    const size_t headerSize = constexpr_strlen(RESULTS_SINK_BINARY_MAGIC) + 2;
+    const size_t gameSize = 1 + 8 + 4 + 4 + 3 * 8;
+    ASSERT_EQ(headerSize + 20 * gameSize + 1 + 8 + 3 * (4 + 4 + 8 + 8), data.size());
+    u_int32_t gameWins[3]{};
+    for (u_int64_t i = 0; i < 20; i++) {
+        const char* record = data.data() + headerSize + i * gameSize;
+        ASSERT_EQ('G', record[0]);
+        u_int64_t gameNum;
+        u_int32_t rounds;
+        u_int32_t winners;
+        int64_t chipDeltas[3];
+        std::memcpy(&gameNum, record + 1, sizeof(gameNum));
+        std::memcpy(&rounds, record + 9, sizeof(rounds));
+        std::memcpy(&winners, record + 13, sizeof(winners));
+        std::memcpy(chipDeltas, record + 17, sizeof(chipDeltas));
+        EXPECT_EQ(i, gameNum);
+        EXPECT_GE(rounds, 1);
+        EXPECT_LE(rounds, 30);
+        EXPECT_NE(0, winners);
+        // the chips are only redistributed (or lost by rounding and illegal moves)
+        EXPECT_LE(chipDeltas[0] + chipDeltas[1] + chipDeltas[2], 0);
+        for (u_int8_t id = 0; id < 3; id++) {
+            if (winners & (1u << id)) gameWins[id]++;
+        }
+    }
+    // the summary matches the game records and the data of the game
+    const char* summary = data.data() + headerSize + 20 * gameSize;
+    ASSERT_EQ('S', summary[0]);
+    u_int64_t games;
+    u_int32_t summaryGameWins[3];
+    std::memcpy(&games, summary + 1, sizeof(games));
+    std::memcpy(summaryGameWins, summary + 9, sizeof(summaryGameWins));
+    EXPECT_EQ(20, games);
+    for (u_int8_t id = 0; id < 3; id++) {
+        EXPECT_EQ(gameWins[id], summaryGameWins[id]);
+        EXPECT_EQ(game.getData().gameData.gameWins[id], summaryGameWins[id]);
+    }
+}
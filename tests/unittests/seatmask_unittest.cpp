@@ -0,0 +1,38 @@
+#include "seat_mask.h"
+
+#include <gtest/gtest.h>
+
+TEST(SeatMaskTest, setAndCount) {
+    SeatMask mask;
+    EXPECT_EQ(mask.count(), 0);
+    for (u_int8_t i = 0; i < MAX_PLAYERS; i++) EXPECT_FALSE(mask[i]);
+    mask.set(0);
+    mask.set(3);
+    mask.set(MAX_PLAYERS - 1);
+    mask.set(3);
+    EXPECT_EQ(mask.count(), 3);
+    for (u_int8_t i = 0; i < MAX_PLAYERS; i++) EXPECT_EQ(mask[i], i == 0 || i == 3 || i == MAX_PLAYERS - 1);
+    mask.clear();
+    EXPECT_EQ(mask.getBits(), 0);
+    EXPECT_EQ(SeatMask::getSeats(3), 0b111);
+    EXPECT_EQ(SeatMask::getSeats(16), 0xFFFF);
+}
+
+TEST(SeatMaskTest, getNextSeat) {
+    // compare with a simple walk around the table for every mask of a full table
+    for (u_int8_t numSeats = 2; numSeats <= MAX_PLAYERS; numSeats++) {
+        for (u_int32_t bits = 1; bits <= SeatMask::getSeats(numSeats); bits++) {
+            for (u_int8_t seat = 0; seat < numSeats; seat++) {
+                u_int8_t expected = seat;
+                do {
+                    expected = (expected + 1) % numSeats;
+                } while (!((bits >> expected) & 1));
+                EXPECT_EQ(SeatMask::getNextSeat(bits, seat, numSeats), expected);
+            }
+        }
+    }
+    // seats outside of the table are ignored, without any seat the start seat is returned
+    EXPECT_EQ(SeatMask::getNextSeat(0b11000, 1, 3), 1);
+    EXPECT_EQ(SeatMask::getNextSeat(0b11010, 1, 3), 1);
+    EXPECT_EQ(SeatMask::getNextSeat(0, 2, 3), 2);
+}
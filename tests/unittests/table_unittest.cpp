@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include "game.h"
+
+TEST(TableTest, Footprint) {
+    // the heads up table with 32 bit chips is smaller than the default table, the largest table is bigger
+    EXPECT_LT(sizeof(BasicData<2, u_int32_t>), sizeof(Data));
+    EXPECT_LT(sizeof(BasicPot<2, u_int32_t>), sizeof(Pot));
+    EXPECT_GT(sizeof(BasicData<MAX_SEATS, u_int64_t>), sizeof(Data));
+    EXPECT_EQ(sizeof(u_int16_t), sizeof(BasicSeatMask<2>));
+    EXPECT_EQ(sizeof(u_int32_t), sizeof(BasicSeatMask<MAX_SEATS>));
+}
+
+TEST(TableTest, ConfigLimits) {
+    EXPECT_EQ((u_int64_t)UINT32_MAX - 1, (BasicConfig<2, u_int32_t>::getMaxChips()));
+    EXPECT_EQ(MAX_CHIPS, Config::getMaxChips());
+    // more players than seats
+    EXPECT_THROW((BasicConfig<2, u_int32_t>{1, 3, 1000, 10, 0}), std::invalid_argument);
+    // more chips than the chip type can hold
+    EXPECT_THROW((BasicConfig<2, u_int32_t>{1, 2, UINT32_MAX / 2 + 1, 10, 0}), std::invalid_argument);
+    EXPECT_NO_THROW((BasicConfig<MAX_SEATS, u_int64_t>{1, MAX_SEATS, 1000, 10, 0}));
+}
+
+TEST(TableTest, HeadsUp) {
+    BasicGame<2, u_int32_t> game{BasicConfig<2, u_int32_t>{20, 2, 1000, 10, 0, true, true, 100}};
+    game.run();
+    const BasicData<2, u_int32_t>& data = game.getData();
+    EXPECT_EQ(2, data.numPlayers);
+    // every game has at least one winner
+    EXPECT_GE(data.gameData.gameWins[0] + data.gameData.gameWins[1], 20);
+    // chips are only lost by rounding and illegal moves
+    EXPECT_LE(data.gameData.playerChips[0] + data.gameData.playerChips[1], 2000);
+}
+
+TEST(TableTest, FullTable) {
+    BasicGame<MAX_SEATS, u_int64_t> game{BasicConfig<MAX_SEATS, u_int64_t>{2, MAX_SEATS, 1000, 10, 0, true, true, 20}};
+    game.run();
+    const BasicData<MAX_SEATS, u_int64_t>& data = game.getData();
+    EXPECT_EQ(MAX_SEATS, data.numPlayers);
+    u_int32_t gameWins = 0;
+    u_int64_t chips = 0;
+    for (u_int8_t i = 0; i < MAX_SEATS; i++) {
+        gameWins += data.gameData.gameWins[i];
+        chips += data.gameData.playerChips[i];
+        EXPECT_LE(data.playerStats[i].hands, 40);
+    }
+    EXPECT_GE(gameWins, 2);
+    EXPECT_LE(chips, 1000 * MAX_SEATS);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "game_test.h"
+#include "tournament_runner.h"
+
+namespace {
+/// @brief Creates a config of small tournaments
+/// @param threads The number of threads
+/// @return The config
+TournamentConfig getConfig(const u_int8_t threads) {
+    TournamentConfig config{12, 23, 1000, {{10, 0, 20}, {20, 5, 20}, {50, 10, 20}}};
+    config.tableSize = 6;
+    config.syncHands = 5;
+    config.seed = 7;
+    config.threads = threads;
+    return config;
+}
+
+/// @brief A player that raises to 300 with a big stack and shoves a short stack
+class ShovingPlayer : public CheckPlayer {
+   public:
+    using CheckPlayer::CheckPlayer;
+
+    /// @copydoc CheckPlayer::turn()
+    Action turn(const Data& data, const bool = false, const bool = false) const noexcept override {
+        if (data.getChips() < 300) return Action{Actions::ALL_IN};
+        if (data.betRoundData.currentBet < 300) return Action{Actions::RAISE, 300};
+        return Action{Actions::CALL};
+    }
+};
+}  // namespace
+
+TEST(TournamentTest, Levels) {
+    const TournamentRunner runner{getConfig(1)};
+    EXPECT_EQ(10, runner.getLevel(0).smallBlind);
+    EXPECT_EQ(10, runner.getLevel(19).smallBlind);
+    EXPECT_EQ(20, runner.getLevel(20).smallBlind);
+    EXPECT_EQ(5, runner.getLevel(20).ante);
+    EXPECT_EQ(50, runner.getLevel(59).smallBlind);
+    // after the schedule the last level doubles every 20 hands
+    EXPECT_EQ(100, runner.getLevel(60).smallBlind);
+    EXPECT_EQ(20, runner.getLevel(60).ante);
+    EXPECT_EQ(200, runner.getLevel(80).smallBlind);
+
+    TournamentConfig invalid = getConfig(1);
+    invalid.levels.clear();
+    EXPECT_THROW(TournamentRunner{invalid}, std::invalid_argument);
+    invalid = getConfig(1);
+    invalid.tableSize = MAX_PLAYERS + 1;
+    EXPECT_THROW(TournamentRunner{invalid}, std::invalid_argument);
+    invalid = getConfig(1);
+    invalid.numEntrants = 1;
+    EXPECT_THROW(TournamentRunner{invalid}, std::invalid_argument);
+    invalid = getConfig(1);
+    invalid.startingChips = MAX_CHIPS;
+    EXPECT_THROW(TournamentRunner{invalid}, std::invalid_argument);
+}
+
+TEST(TournamentTest, Finishes) {
+    TournamentRunner runner{getConfig(3)};
+    runner.run();
+    EXPECT_EQ(12, runner.getTournamentsPlayed());
+    EXPECT_GT(runner.getHandsPlayed(), 0);
+    // every position is taken once per tournament
+    for (u_int32_t position = 1; position <= 23; position++) {
+        u_int64_t finishes = 0;
+        for (u_int8_t bot = 0; bot < 5; bot++) finishes += runner.getFinishes(bot, position);
+        EXPECT_EQ(12, finishes);
+    }
+    // entrant e plays bot e % 5: the bots 0 to 2 have five entrants, the others four
+    for (u_int8_t bot = 0; bot < 5; bot++) {
+        u_int64_t finishes = 0;
+        for (u_int32_t position = 1; position <= 23; position++) finishes += runner.getFinishes(bot, position);
+        EXPECT_EQ(12 * (bot < 3 ? 5 : 4), finishes);
+        EXPECT_GE(runner.getMeanFinish(bot), 1);
+        EXPECT_LE(runner.getMeanFinish(bot), 23);
+    }
+}
+
+TEST(TournamentTest, Threads) {
+    // check players do not use random numbers, so the seeded decks decide the tournaments on any number of threads
+    const TournamentRunner::PlayerFactory factory = [](const u_int8_t bot) { return std::make_unique<CheckPlayer>(bot + 1); };
+    TournamentRunner single{getConfig(1), factory};
+    TournamentRunner parallel{getConfig(4), factory};
+    single.run();
+    parallel.run();
+    EXPECT_EQ(single.getHandsPlayed(), parallel.getHandsPlayed());
+    for (u_int8_t bot = 0; bot < 5; bot++) {
+        for (u_int32_t position = 1; position <= 23; position++) EXPECT_EQ(single.getFinishes(bot, position), parallel.getFinishes(bot, position));
+    }
+}
+
+TEST(TournamentTest, Ante) {
+    // three check players call the big blind and the big blind posts the ante
+    GameTest game{Config{1, 4, 1000, 10, 0, false, false}};
+    game.initTournamentTable();
+    for (u_int8_t seat = 0; seat < 4; seat++) {
+        std::unique_ptr<Player> player = std::make_unique<CheckPlayer>(seat + 1);
+        // seat 2 is empty
+        game.seatPlayer(seat, player, seat == 2 ? 0 : 1000);
+    }
+    game.playTournamentHand(10, 15);
+    EXPECT_EQ(3 * 20 + 15, game.getData().roundData.pot);
+    u_int64_t chips = 0;
+    for (u_int8_t seat = 0; seat < 4; seat++) chips += game.getData().gameData.playerChips[seat];
+    EXPECT_LE(3000 - chips, 2);
+    EXPECT_EQ(0, game.getData().gameData.playerChips[2]);
+    // the ante never puts the big blind all-in
+    for (u_int32_t hand = 0; hand < 200 && game.getData().gameData.numNonOutPlayers > 1; hand++) game.playTournamentHand(10, 2000);
+    EXPECT_EQ(0, game.getData().gameData.playerChips[2]);
+}
+
+TEST(TournamentTest, AnteAllIn) {
+    // the big blind posts 10 and the ante of 5 and shoves its last 100 chips into the raise of the small blind to 300
+    GameTest game{Config{1, 2, 1000, 10, 0, false, false}};
+    game.initTournamentTable();
+    for (u_int8_t seat = 0; seat < 2; seat++) {
+        std::unique_ptr<Player> player = std::make_unique<ShovingPlayer>(seat + 1);
+        game.seatPlayer(seat, player, seat == 0 ? 1000 : 115);
+    }
+    // both players play the board, the pots are split
+    const std::pair<Card, Card> hands[2] = {{Card{2, 0}, Card{3, 1}}, {Card{2, 2}, Card{3, 3}}};
+    const Card board[5] = {Card{14, 0}, Card{13, 1}, Card{12, 2}, Card{11, 3}, Card{10, 0}};
+    game.buildDeck(hands, 2, board);
+    game.playTournamentHand(5, 5);
+    ASSERT_EQ(1, game.getData().roundData.bigBlindPos);
+    // the ante is dead money in the main pot: 110 from each player and the ante, the small blind gets its uncalled 190 back
+    EXPECT_EQ(300 + 110 + 5, game.getData().roundData.pot);
+    const u_int64_t bigBlindChips = game.getData().gameData.playerChips[1];
+    EXPECT_EQ(112, bigBlindChips);
+    // the odd chip of the split main pot is lost
+    EXPECT_EQ(1000 + 115 - 1, game.getData().gameData.playerChips[0] + bigBlindChips);
+}
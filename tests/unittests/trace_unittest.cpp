@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <thread>
+
+#include "game.h"
+#include "trace.h"
+
+// this test is compiled with POKER_TRACING, so the phases of the game are recorded
+
+TEST(TraceTest, Sampling) {
+    Tracer::clear();
+    Tracer::setSampleRate(4);
+    // a new thread starts with the first hand, which is recorded
+    std::thread([]() {
+        for (u_int8_t i = 0; i < 10; i++) {
+            POKER_TRACE_HAND();
+            POKER_TRACE_SCOPE("hand");
+        }
+    }).join();
+    // the hands 0, 4 and 8 are recorded
+    EXPECT_EQ(3, Tracer::getNumEvents());
+    Tracer::setSampleRate(1);
+    EXPECT_THROW(Tracer::setSampleRate(0), std::invalid_argument);
+    EXPECT_EQ(1, Tracer::getSampleRate());
+}
+
+TEST(TraceTest, RingBuffer) {
+    Tracer::clear();
+    std::thread([]() {
+        Tracer::beginHand();
+        for (u_int32_t i = 0; i < TRACE_BUFFER_EVENTS + 10; i++) Tracer::record("phase", Tracer::now(), Tracer::now());
+    }).join();
+    // the oldest phases are overwritten
+    EXPECT_EQ(TRACE_BUFFER_EVENTS, Tracer::getNumEvents());
+    Tracer::clear();
+    EXPECT_EQ(0, Tracer::getNumEvents());
+}
+
+TEST(TraceTest, GamePhases) {
+    Tracer::clear();
+    Tracer::setSampleRate(1);
+    Game game{Config{3, 4, 1000, 10, 1, true, true, 30}};
+    game.run();
+    EXPECT_GT(Tracer::getNumEvents(), game.getProgressCounters().rounds.get());
+
+    const std::string path = testing::TempDir() + "trace_test.json";
+    ASSERT_TRUE(Tracer::writeChromeTrace(path));
+    std::ifstream file(path);
+    const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_EQ(trace.size() - 4, trace.rfind("\n]}\n"));
+    for (const char* phase : {"hand", "shuffle", "deal", "setBlinds", "preflop", "equalizeMove", "Player::turn"})
+        EXPECT_NE(std::string::npos, trace.find("{\"name\":\"" + std::string(phase) + "\",\"cat\":\"poker\",\"ph\":\"X\",\"ts\":")) << phase;
+    // every round ends with a showdown or a won pot, the showdowns are evaluated
+    if (game.getProgressCounters().showdowns.get() != 0) {
+        EXPECT_NE(std::string::npos, trace.find("{\"name\":\"evaluate\""));
+    }
+    Tracer::logSummary();
+    Tracer::clear();
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "game_test.h"
+
+TEST(TurnTimeStats, Buckets) {
+    EXPECT_EQ(0, TurnTimeStats::getBucket(0));
+    EXPECT_EQ(1, TurnTimeStats::getBucket(1));
+    EXPECT_EQ(2, TurnTimeStats::getBucket(2));
+    EXPECT_EQ(2, TurnTimeStats::getBucket(3));
+    EXPECT_EQ(11, TurnTimeStats::getBucket(1024));
+    EXPECT_EQ(TURN_TIME_HISTOGRAM_BUCKETS - 1, TurnTimeStats::getBucket(UINT64_MAX));
+    for (u_int64_t ns = 1; ns < 100000; ns += 7) {
+        EXPECT_LT(ns, TurnTimeStats::getBucketUpperBound(TurnTimeStats::getBucket(ns)));
+        EXPECT_GE(ns, TurnTimeStats::getBucketUpperBound(TurnTimeStats::getBucket(ns)) / 2);
+    }
+}
+
+TEST(TurnTimeStats, Stats) {
+    TurnTimeStats stats;
+    EXPECT_EQ(0, stats.getDecisions());
+    EXPECT_EQ(0, stats.getPercentile(0.99));
+    EXPECT_EQ(0, stats.getMeanTime());
+    // 99 fast decisions and one slow decision
+    for (u_int8_t i = 0; i < 99; i++) stats.addTurnTime(100);
+    stats.addTurnTime(100000);
+    stats.addOverrun();
+    EXPECT_EQ(100, stats.getDecisions());
+    EXPECT_EQ(99 * 100 + 100000, stats.getTotalTime());
+    EXPECT_DOUBLE_EQ(1099, stats.getMeanTime());
+    EXPECT_EQ(100000, stats.getMaxTime());
+    EXPECT_EQ(1, stats.getOverruns());
+    EXPECT_EQ(99, stats.getHistogram(TurnTimeStats::getBucket(100)));
+    EXPECT_EQ(1, stats.getHistogram(TurnTimeStats::getBucket(100000)));
+    // p99 is in the bucket of the fast decisions, p100 is the slow decision
+    EXPECT_EQ(128, stats.getPercentile(0.99));
+    EXPECT_EQ(100000, stats.getPercentile(1));
+    stats.reset();
+    EXPECT_EQ(0, stats.getDecisions());
+    EXPECT_EQ(0, stats.getHistogram(TurnTimeStats::getBucket(100)));
+}
+
+TEST(TurnTimeStats, InvalidTimeoutAction) {
+    EXPECT_NO_THROW(Config(1, 2, 100, 10, 1, false, false, -1, true, 1, Actions::FOLD));
+    EXPECT_NO_THROW(Config(1, 2, 100, 10, 1, false, false, -1, true, 1, Actions::CALL));
+    EXPECT_THROW(Config(1, 2, 100, 10, 1, false, false, -1, true, 1, Actions::RAISE), std::invalid_argument);
+    EXPECT_THROW(Config(1, 2, 100, 10, 1, false, false, -1, true, 1, Actions::ALL_IN), std::invalid_argument);
+}
+
+TEST(TurnTimeStats, Measure) {
+    GameTest game{Config{10, 5, 1000, 10, 1, true, true, 20, true}};
+    game.setRealisticPlayers();
+    game.run(false);
+    u_int64_t decisions = 0;
+    for (u_int8_t i = 0; i < 5; i++) {
+        decisions += game.getTurnTimeStats(i).getDecisions();
+        EXPECT_EQ(0, game.getTurnTimeStats(i).getOverruns());
+    }
+    EXPECT_GT(decisions, 0);
+}
+
+TEST(TurnTimeStats, Budget) {
+    for (const Actions timeoutAction : {Actions::FOLD, Actions::CALL}) {
+        // every decision takes longer than 1ns, therefore every action is replaced by the timeout action which is always legal
+        // the blinds are too small to knock out a passive player in 20 rounds
+        GameTest game{Config{10, 5, 1000, 10, 1, true, true, 20, false, 1, timeoutAction}};
+        game.setRealisticPlayers();
+        game.run(false);
+        for (u_int8_t i = 0; i < 5; i++) {
+            EXPECT_EQ(game.getTurnTimeStats(i).getDecisions(), game.getTurnTimeStats(i).getOverruns());
+            EXPECT_FALSE(game.getData().gameData.playerOut[i]);
+        }
+    }
+}
+
+TEST(TurnTimeStats, BudgetShortStack) {
+    // the small blind has 5 chips left and faces the all-in big blind of 15, the timed out call is an all-in instead of a fold
+    GameTest game{Config{1, 2, 15, 10, 0, false, false, 1, false, 1, Actions::CALL}};
+    std::unique_ptr<Player> players[2] = {std::make_unique<CheckPlayer>(1), std::make_unique<CheckPlayer>(2)};
+    game.setPlayers(players);
+    game.run(false);
+    for (u_int8_t i = 0; i < 2; i++) EXPECT_EQ(0, game.getData().playerStats[i].foldsToBet);
+    EXPECT_EQ(1, game.getData().playerStats[0].calls + game.getData().playerStats[1].calls);
+}
@@ -43,6 +43,16 @@ void HandUtils::evaluateHands(const Card communityCards[], const std::pair<Card,
     this->addWinners(playerCards, winners, numWinners, players);
 }
 
+void HandUtils::evaluateBlock(const DealBlock& block) noexcept {
+    Card communityCards[5];
+    std::pair<Card, Card> playerCards[MAX_PLAYERS];
+    for (u_int32_t deal = 0; deal < block.size; deal++) {
+        block.getCommunityCards(deal, communityCards);
+        for (u_int8_t p = 0; p < block.players; p++) playerCards[p] = block.getHand(deal, p);
+        this->evaluateHands(communityCards, playerCards, block.players);
+    }
+}
+
 void HandUtils::writeResults(const std::string& filename, const u_int8_t players, const bool newFile) const noexcept {
     // write hand + total + hand/total in csv file
     std::ofstream file(filename, newFile ? std::ios::trunc : std::ios::app);
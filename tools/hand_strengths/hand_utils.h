@@ -1,5 +1,6 @@
 #pragma once
 
+#include "deal_generator.h"
 #include "hand_strengths.h"
 
 class HandUtils {
@@ -59,6 +60,13 @@ class HandUtils {
     /// @see The function addWinners() is used to update the internal arrays
     void evaluateHands(const Card communityCards[], const std::pair<Card, Card> playerCards[], const u_int8_t players) noexcept;
 
+    /// @brief Evaluate every deal of a block of deals and update the internal arrays
+    /// @param block The block of deals with the cards of block.players players
+    /// @exception Guarantee No-throw
+    /// @note Every deal is evaluated like evaluateHands()
+    /// @see DealGenerator to generate the blocks
+    void evaluateBlock(const DealBlock& block) noexcept;
+
     /// @brief Write the results to a file in csv format
     /// @param filename The name (path) of the file to write to
     /// @param players The number of players
@@ -1,5 +1,8 @@
+#include "deal_generator.h"
 #include "hand_utils.h"
 #include "mainargs.h"
+#include "perf_counters.h"
+#include "progress.h"
 #include "working_dir.h"
 
 int main(const int argc, const char** argv) {
@@ -17,6 +20,11 @@ int main(const int argc, const char** argv) {
                           "The name of the output file in the data directory (with extension) \n\t\t(default: 'STR_TOOL_HANDSTRENGTHS_DEFAULT_FILE_NAME + options + .csv')\n\t\tNote that the correct "
                           "file options are required (-w)");
     mainArgs.setNumericArg('w', "woptions", 1, 999, "An 3 digit number to set the weight of the winner, split and total count");
+    mainArgs.setNumericArg('p', "progress", 1, 86400, "Print the progress every given number of seconds (also written to progress_tool.prom next to the log file)");
+    mainArgs.setStringArg('c', "counters",
+                          "Count instructions, cycles, branch misses and cache misses of a phase with the hardware performance counters (Linux) \n\t\t(deal, evaluate or showdown for both, "
+                          "reported per player count)");
+    mainArgs.setNumericArg('n', "seed", 0, INT64_MAX, "The seed of the deals, a run with the same seed and iterations gives the same results (default: the current time)");
     if (!mainArgs.run()) return 1;
 
     // init logger
@@ -77,30 +85,65 @@ int main(const int argc, const char** argv) {
         filename = STR_TOOL_HANDSTRENGTHS_DEFAULT_FILE_NAME + std::to_string(+winnerAdd) + std::to_string(+splitAdd) + std::to_string(+totalAdd) + ".csv";
     }
 
-    Deck deck;
-    Card communityCards[5];
-    std::pair<Card, Card> playerCards[MAX_PLAYERS];
+    // the phase that is counted by the perf counters
+    const std::string perfPhase = mainArgs.isArgSet(6) ? mainArgs.getArgValue(6) : "";
+    if (perfPhase != "" && perfPhase != "deal" && perfPhase != "evaluate" && perfPhase != "showdown") {
+        std::cerr << "Unknown perf counter phase: " << perfPhase << " (allowed: deal, evaluate, showdown)" << std::endl;
+        return 1;
+    }
+    std::unique_ptr<PerfCounters> perfCounters;
+    if (perfPhase != "") perfCounters = std::make_unique<PerfCounters>();
+    PerfCounters* dealCounters = perfPhase == "deal" || perfPhase == "showdown" ? perfCounters.get() : nullptr;
+    PerfCounters* evaluateCounters = perfPhase == "evaluate" || perfPhase == "showdown" ? perfCounters.get() : nullptr;
+
+    // every simulated showdown counts as one game with one round, the counters outlive the reporter
+    ProgressCounters progress;
+    std::unique_ptr<ProgressReporter> progressReporter;
+    if (mainArgs.isArgSet(5)) {
+        progressReporter = std::make_unique<ProgressReporter>(std::chrono::seconds(mainArgs.getArgNumericValue(5)), (u_int64_t)iters * (MAX_PLAYERS - 1),
+                                                              (workingDir.getLogPath().parent_path() / "progress_tool.prom").string());
+        progressReporter->watch(progress);
+        progressReporter->start();
+    }
+
+    // the deals are generated in blocks, every player count gets its own deals of the seed
+    const u_int64_t seed = mainArgs.isArgSet(7) ? mainArgs.getArgNumericValue(7) : time(NULL);
+    PLOG_INFO << "Seed " << seed;
+    const std::unique_ptr<DealBlock> block = std::make_unique<DealBlock>();
     // iterate over any meaningful number of players
     for (u_int8_t players = 2; players <= MAX_PLAYERS; players++) {
         // set up HandUtils
         HandUtils handUtils(winnerAdd, splitAdd, totalAdd);
+        DealGenerator dealGenerator(seed + players, players);
+        if (perfCounters) perfCounters->reset();
         // simulate for an amount of iterations
-        for (int64_t i = 0; i < iters; i++) {
-            // shuffle deck and draw cards
-            deck.shuffle();
-            for (u_int8_t j = 0; j < 5; j++) communityCards[j] = deck.draw();
-            for (u_int8_t j = 0; j < players; j++) {
-                playerCards[j].first = deck.draw();
-                playerCards[j].second = deck.draw();
+        for (int64_t i = 0; i < iters; i += DEAL_BLOCK_SIZE) {
+            const u_int32_t size = std::min<int64_t>(DEAL_BLOCK_SIZE, iters - i);
+            {
+                // generate the cards of a block of showdowns
+                const PerfScope perfScope{dealCounters};
+                dealGenerator.generate(*block, size);
+            }
+            {
+                // simulate the showdowns and remember any winners and splits as well as the total for each occurring hand
+                const PerfScope perfScope{evaluateCounters};
+                handUtils.evaluateBlock(*block);
             }
-            // simulate a showdown and remember any winners and splits as well as the total for each occurring hand
-            handUtils.evaluateHands(communityCards, playerCards, players);
-            // reset deck
-            deck.reset();
+            progress.games.add(size);
+            progress.rounds.add(size);
+            progress.showdowns.add(size);
+            progress.evaluations.add(size * players);
         }
         // write the results for each player count to a file
         handUtils.writeResults((workingDir.getDataPath() / filename).string(), players, players == 2);
         std::cout << "Wrote results for " << +players << " players\n";
+        if (perfCounters) {
+            const std::string phase = perfPhase + " with " + std::to_string(players) + " players";
+            if (perfPhase == "evaluate")
+                perfCounters->logReport(phase.c_str(), (u_int64_t)iters * players, "hand");
+            else
+                perfCounters->logReport(phase.c_str(), iters, "showdown");
+        }
     }
 
     PLOG_INFO << "Finished Handstrengths Tool";